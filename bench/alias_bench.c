@@ -0,0 +1,109 @@
+#define BENCH_IMPLEMENTATION
+#define LIST_IMPLEMENTATION
+#define HASH_TABLE_IMPLEMENTATION
+
+#include "stdio.h"
+#include "stddef.h"
+#include <string.h>     // angle brackets, otherwise this finds engine_core/string.h first.
+
+#include "bench.h"
+#include "engine_core/engine_types.h"
+#include "engine_core/list.h"
+#include "engine_core/hash_table.h"
+#include "engine_core/string_id.h"
+#include "engine/object.h"
+
+// Gives BENCH_OBJECTS objects an alias each, with every BENCH_SHARED-th one sharing a single alias, then times finding objects
+// by alias with Object_find_by_alias against comparing the alias of every object in turn. Also checks every alias finds an
+// object with that alias, and that destroying the objects empties the index. Times are per lookup.
+//
+
+#define BENCH_OBJECTS 100000
+#define BENCH_SHARED 10
+#define BENCH_LOOKUPS 1000000
+#define BENCH_SCAN_LOOKUPS 1000
+
+static u64 RandomState = 0x9E3779B97F4A7C15ull;
+
+
+u64 internal_Bench_random_u64 () {
+    RandomState ^= RandomState >> 12;
+    RandomState ^= RandomState << 25;
+    RandomState ^= RandomState >> 27;
+    return RandomState * 0x2545F4914F6CDD1Dull;
+}
+
+
+void internal_Bench_alias (const u64 i, char* out) {
+    if (i % BENCH_SHARED == 0) {
+        snprintf(out, 32, "Shared");
+    }
+
+    else {
+        snprintf(out, 32, "Object %llu", (unsigned long long)i);
+    }
+}
+
+
+int main () {
+    Object** objects = (Object**)malloc(sizeof(Object*) * BENCH_OBJECTS);
+    char alias[32];
+    bool failed = false;
+
+    StringId_initialize();
+    printf("Object aliases (%llu objects, %llu bytes each, Tick at %llu, Transform at %llu)\n", (unsigned long long)BENCH_OBJECTS, (unsigned long long)sizeof(Object), (unsigned long long)offsetof(Object, Tick), (unsigned long long)offsetof(Object, Transform));
+
+    u64 start = Bench_now();
+    for (u64 i = 0; i < BENCH_OBJECTS; ++i) {
+        objects[i] = (Object*)internal_Object_alloc(1, sizeof(Object));
+        internal_Object_Initialize(objects[i], NULL, 1);
+        internal_Bench_alias(i, alias);
+        Object_set_alias(objects[i], alias);
+    }
+    Bench_report("create and Object_set_alias", Bench_now() - start, (u64)BENCH_OBJECTS);
+
+    u64 found = 0;
+    start = Bench_now();
+    for (u64 i = 0; i < BENCH_LOOKUPS; ++i) {
+        internal_Bench_alias(internal_Bench_random_u64() % BENCH_OBJECTS, alias);
+        found += Object_find_by_alias(alias) != NULL;
+    }
+    Bench_report("Object_find_by_alias", Bench_now() - start, (u64)BENCH_LOOKUPS);
+
+    // What finding an object by alias took before there was an index.
+    start = Bench_now();
+    for (u64 i = 0; i < BENCH_SCAN_LOOKUPS; ++i) {
+        internal_Bench_alias(internal_Bench_random_u64() % BENCH_OBJECTS, alias);
+        for (u64 j = 0; j < BENCH_OBJECTS; ++j) {
+            if (strcmp(Object_get_alias(objects[j]), alias) == 0) {
+                found++;
+                break;
+            }
+        }
+    }
+    Bench_report("compare every object's alias", Bench_now() - start, (u64)BENCH_SCAN_LOOKUPS);
+
+    for (u64 i = 0; i < BENCH_OBJECTS; ++i) {
+        internal_Bench_alias(i, alias);
+        Object* object = (Object*)Object_find_by_alias(alias);
+        failed |= !object || strcmp(Object_get_alias(object), alias) != 0;
+        failed |= (i % BENCH_SHARED != 0) && object != objects[i];
+    }
+    failed |= found != BENCH_LOOKUPS + BENCH_SCAN_LOOKUPS;
+
+    // Take the shared alias from the middle of its list, then every other one.
+    Object_set_alias(objects[BENCH_SHARED * 5], NULL);
+    failed |= Object_find_by_alias("Shared") == NULL || Object_get_alias(objects[BENCH_SHARED * 5])[0] != '\0';
+
+    for (u64 i = 0; i < BENCH_OBJECTS; ++i) {
+        internal_Object_Deinitialize(objects[i]);
+        internal_Object_free(objects[i]);
+    }
+    failed |= Object_find_by_alias("Shared") != NULL || Object_find_by_alias("Object 1") != NULL;
+    printf("%s\n", failed ? "alias index check failed" : "every alias found its object");
+
+    ObjectPools_deinitialize();
+    StringId_deinitialize();
+    free(objects);
+    return failed ? 1 : 0;
+}
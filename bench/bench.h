@@ -0,0 +1,44 @@
+#pragma once
+
+// Shared helpers for the programs in bench/. Benchmarks link engine_core sources directly and run without a window, so 
+// define BENCH_IMPLEMENTATION in exactly one file per benchmark to get stand-ins for the engine's exit functions.
+
+#include "stdio.h"
+#include "time.h"
+
+#include "engine_core/engine_types.h"
+
+// Monotonic-enough wall clock in nanoseconds.
+static inline u64 Bench_now () {
+    struct timespec time;
+    timespec_get(&time, TIME_UTC);
+    return (u64)time.tv_sec * 1000000000ull + (u64)time.tv_nsec;
+}
+
+// Keep the compiler from discarding a result that is otherwise unused.
+static volatile u64 Bench_sink;
+#define Bench_consume(value) (Bench_sink += (u64)(value))
+
+// Print one result line. Every benchmark uses the same columns so results can be diffed.
+#define Bench_report(name, elapsed, operations) \
+    printf("%-48s %10.2f ns/op  (%llu ops)\n", name, (double)(elapsed) / (double)(operations), (unsigned long long)(operations))
+
+
+#ifdef BENCH_IMPLEMENTATION
+
+void Engine_exit_forced (ecode errorcode) {
+    fprintf(stderr, "Engine_exit_forced: %d\n", errorcode);
+    exit(errorcode ? errorcode : 1);
+}
+
+void internal_Engine_validate (bool check, ecode errorcode) {
+    if (check) {
+        Engine_exit_forced(errorcode);
+    }
+}
+
+void Engine_exit (ecode errorcode) {
+    exit(errorcode);
+}
+
+#endif
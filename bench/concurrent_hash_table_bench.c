@@ -0,0 +1,171 @@
+#define BENCH_IMPLEMENTATION
+#define VECTOR_IMPLEMENTATION
+#define HASH_TABLE_IMPLEMENTATION
+
+#include "stdio.h"
+#include <stdatomic.h>
+
+#include "bench.h"
+#include "engine_core/string.h"
+#include "engine_core/vector.h"
+#include "engine_core/hash_table.h"
+#include "engine_core/thread.h"
+#include "engine_core/concurrent_hash_table.h"
+
+// Resolves asset aliases from 1 to N reader threads while one writer thread keeps inserting new aliases, the way worker threads
+// would look up textures while the main thread loads more. Compares ConcurrentHashTable against a HashTable behind a Mutex.
+// Times are wall clock for the whole run divided by the lookups of every reader, so flat numbers mean lookups scale.
+
+#define BENCH_KEY_COUNT 4096
+#define BENCH_WRITER_KEY_COUNT 4096
+#define BENCH_LOOKUPS_PER_READER (1 << 21)
+
+static char KeyNames[BENCH_KEY_COUNT + BENCH_WRITER_KEY_COUNT][48];
+static String Keys[BENCH_KEY_COUNT + BENCH_WRITER_KEY_COUNT];
+
+static ConcurrentHashTable ConcurrentTable;
+static HashTable LockedTable;
+static Mutex LockedTableLock;
+
+static atomic_bool StartFlag;
+static atomic_bool StopFlag;
+
+typedef struct BenchReader {
+    Thread thread;
+    u64 seed;
+    u64 sum;
+} BenchReader;
+
+
+void internal_Bench_wait_for_start () {
+    while (!atomic_load_explicit(&StartFlag, memory_order_acquire)) {
+        Thread_yield();
+    }
+}
+
+
+void internal_Bench_concurrent_reader (void* readerPtr) {
+    BenchReader* reader = (BenchReader*)readerPtr;
+    u64 index = reader->seed;
+    u64 sum = 0;
+
+    internal_Bench_wait_for_start();
+    for (u64 i = 0; i < BENCH_LOOKUPS_PER_READER; ++i) {
+        index = (index * 6364136223846793005ull + 1442695040888963407ull);
+        u64 value = 0;
+        ConcurrentHashTable_find(&ConcurrentTable, Keys[(index >> 33) % BENCH_KEY_COUNT], value);
+        sum += value;
+    }
+    reader->sum = sum;
+}
+
+
+void internal_Bench_locked_reader (void* readerPtr) {
+    BenchReader* reader = (BenchReader*)readerPtr;
+    u64 index = reader->seed;
+    u64 sum = 0;
+
+    internal_Bench_wait_for_start();
+    for (u64 i = 0; i < BENCH_LOOKUPS_PER_READER; ++i) {
+        index = (index * 6364136223846793005ull + 1442695040888963407ull);
+        u64 value = 0;
+        Mutex_lock(&LockedTableLock);
+        HashTable_find(&LockedTable, Keys[(index >> 33) % BENCH_KEY_COUNT], value);
+        Mutex_unlock(&LockedTableLock);
+        sum += value;
+    }
+    reader->sum = sum;
+}
+
+
+void internal_Bench_concurrent_writer (void* unused) {
+    internal_Bench_wait_for_start();
+    for (u64 i = BENCH_KEY_COUNT; !atomic_load_explicit(&StopFlag, memory_order_relaxed); ++i) {
+        if (i == BENCH_KEY_COUNT + BENCH_WRITER_KEY_COUNT) {
+            i = BENCH_KEY_COUNT;
+        }
+        ConcurrentHashTable_insert(&ConcurrentTable, Keys[i], &i);
+        Thread_yield();
+    }
+}
+
+
+void internal_Bench_locked_writer (void* unused) {
+    internal_Bench_wait_for_start();
+    for (u64 i = BENCH_KEY_COUNT; !atomic_load_explicit(&StopFlag, memory_order_relaxed); ++i) {
+        if (i == BENCH_KEY_COUNT + BENCH_WRITER_KEY_COUNT) {
+            i = BENCH_KEY_COUNT;
+        }
+        Mutex_lock(&LockedTableLock);
+        HashTable_insert(&LockedTable, Keys[i], &i);
+        Mutex_unlock(&LockedTableLock);
+        Thread_yield();
+    }
+}
+
+
+void internal_Bench_run (const char* name, const u32 readerCount, Function_Void_OneParam readerFunction, Function_Void_OneParam writerFunction) {
+    BenchReader* readers = (BenchReader*)calloc(readerCount, sizeof(BenchReader));
+    Thread writer;
+    char label[64];
+
+    atomic_store(&StartFlag, false);
+    atomic_store(&StopFlag, false);
+
+    for (u32 i = 0; i < readerCount; ++i) {
+        readers[i].seed = 0x9E3779B97F4A7C15ull * (i + 1);
+        Thread_create(&readers[i].thread, readerFunction, &readers[i]);
+    }
+    Thread_create(&writer, writerFunction, NULL);
+
+    u64 start = Bench_now();
+    atomic_store_explicit(&StartFlag, true, memory_order_release);
+
+    for (u32 i = 0; i < readerCount; ++i) {
+        Thread_join(&readers[i].thread);
+        Bench_consume(readers[i].sum);
+    }
+    u64 elapsed = Bench_now() - start;
+
+    atomic_store_explicit(&StopFlag, true, memory_order_relaxed);
+    Thread_join(&writer);
+
+    snprintf(label, sizeof(label), "%s, %lu readers", name, (unsigned long)readerCount);
+    Bench_report(label, elapsed, (u64)readerCount * BENCH_LOOKUPS_PER_READER);
+    free(readers);
+}
+
+
+int main () {
+    for (u64 i = 0; i < BENCH_KEY_COUNT + BENCH_WRITER_KEY_COUNT; ++i) {
+        snprintf(KeyNames[i], sizeof(KeyNames[i]), "./assets/textures/texture_%llu.png", (unsigned long long)i);
+        Keys[i] = (String)String_from_ptr(KeyNames[i]);
+    }
+
+    u32 maxReaders = Thread_hardware_concurrency();
+    printf("Alias lookups with a concurrent writer (%llu keys, up to %lu readers)\n", (unsigned long long)BENCH_KEY_COUNT, (unsigned long)maxReaders);
+
+    for (u32 readerCount = 1;; readerCount = (readerCount * 2 < maxReaders) ? readerCount * 2 : maxReaders) {
+        ConcurrentHashTable_initialize(u64, &ConcurrentTable, BENCH_KEY_COUNT);
+        HashTable_initialize(u64, &LockedTable, BENCH_KEY_COUNT);
+        Mutex_initialize(&LockedTableLock);
+
+        for (u64 i = 0; i < BENCH_KEY_COUNT; ++i) {
+            ConcurrentHashTable_insert(&ConcurrentTable, Keys[i], &i);
+            HashTable_insert(&LockedTable, Keys[i], &i);
+        }
+
+        internal_Bench_run("ConcurrentHashTable_find", readerCount, internal_Bench_concurrent_reader, internal_Bench_concurrent_writer);
+        internal_Bench_run("HashTable_find behind a Mutex", readerCount, internal_Bench_locked_reader, internal_Bench_locked_writer);
+
+        ConcurrentHashTable_deinitialize(&ConcurrentTable);
+        HashTable_deinitialize(&LockedTable);
+        Mutex_deinitialize(&LockedTableLock);
+
+        if (readerCount == maxReaders) {
+            break;
+        }
+    }
+
+    return 0;
+}
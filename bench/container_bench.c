@@ -0,0 +1,156 @@
+#define BENCH_IMPLEMENTATION
+#define LIST_IMPLEMENTATION
+#define HASH_TABLE_IMPLEMENTATION
+
+#include "stdio.h"
+
+#include "bench.h"
+#include "engine_core/string.h"
+#include "engine_core/list.h"
+#include "engine_core/hash_table.h"
+#include "engine/shader/renderable.h"
+#include "engine/shader/shader_uniform.h"
+
+// Compares the generic List and HashTable against the DECLARE_LIST and DECLARE_HASHTABLE versions, using the structs the 
+// engine keeps in them: MeshRender lists on static meshes, and the Uniform tables on shaders and uniform buffers.
+
+#define BENCH_MESH_COUNT 4096
+#define BENCH_UNIFORM_COUNT 1024
+#define BENCH_ROUNDS 256
+
+DECLARE_LIST(MeshRenderList, MeshRender)
+DECLARE_HASHTABLE(UniformMap, Uniform)
+
+static char UniformNames[BENCH_UNIFORM_COUNT][32];
+static String UniformAliases[BENCH_UNIFORM_COUNT];
+static Uniform Uniforms[BENCH_UNIFORM_COUNT];
+
+
+void internal_Bench_mesh_lists () {
+    u64 operations = (u64)BENCH_MESH_COUNT * BENCH_ROUNDS;
+    u64 start;
+
+    printf("\nMeshRender list (%llu meshes, %llu bytes each)\n", (unsigned long long)BENCH_MESH_COUNT, (unsigned long long)sizeof(MeshRender));
+
+    start = Bench_now();
+    for (u64 round = 0; round < BENCH_ROUNDS; ++round) {
+        List meshes;
+        List_initialize(MeshRender, &meshes, 16);
+        for (u64 i = 0; i < BENCH_MESH_COUNT; ++i) {
+            MeshRender mesh = { .indices = i, .materialIndex = (u32)round };
+            List_push_back(&meshes, mesh);
+        }
+        for (List_iterator(MeshRender, &meshes)) {
+            Bench_consume(it->indices);
+        }
+        while (!List_isEmpty(&meshes)) {
+            MeshRender mesh;
+            List_pop_back(&meshes, mesh);
+            Bench_consume(mesh.materialIndex);
+        }
+        List_deinitialize(&meshes);
+    }
+    Bench_report("  List push_back, iterate, pop_back", Bench_now() - start, operations);
+
+    start = Bench_now();
+    for (u64 round = 0; round < BENCH_ROUNDS; ++round) {
+        MeshRenderList meshes;
+        MeshRenderList_initialize(&meshes, 16);
+        for (u64 i = 0; i < BENCH_MESH_COUNT; ++i) {
+            MeshRender mesh = { .indices = i, .materialIndex = (u32)round };
+            MeshRenderList_push_back(&meshes, mesh);
+        }
+        for (List_iterator(MeshRender, &meshes.list)) {
+            Bench_consume(it->indices);
+        }
+        MeshRender mesh;
+        while (MeshRenderList_pop_back(&meshes, &mesh)) {
+            Bench_consume(mesh.materialIndex);
+        }
+        MeshRenderList_deinitialize(&meshes);
+    }
+    Bench_report("  MeshRenderList push_back, iterate, pop_back", Bench_now() - start, operations);
+}
+
+
+void internal_Bench_uniform_tables () {
+    u64 operations = (u64)BENCH_UNIFORM_COUNT * BENCH_ROUNDS;
+    u64 start;
+
+    for (u64 i = 0; i < BENCH_UNIFORM_COUNT; ++i) {
+        snprintf(UniformNames[i], sizeof(UniformNames[i]), "u_Lights[%llu].position", (unsigned long long)i);
+        UniformAliases[i] = (String)String_from_ptr(UniformNames[i]);
+        Uniforms[i] = (Uniform){ .Alias = UniformAliases[i], .Location = (GLint)i, .Elements = 1, .Size = sizeof(vec4) };
+    }
+
+    printf("\nUniform table (%llu uniforms, %llu bytes each)\n", (unsigned long long)BENCH_UNIFORM_COUNT, (unsigned long long)sizeof(Uniform));
+
+    HashTable uniforms;
+    HashTable_initialize(Uniform, &uniforms, BENCH_UNIFORM_COUNT);
+    UniformMap typedUniforms;
+    UniformMap_initialize(&typedUniforms, BENCH_UNIFORM_COUNT);
+
+    for (u64 i = 0; i < BENCH_UNIFORM_COUNT; ++i) {
+        HashTable_insert(&uniforms, UniformAliases[i], &Uniforms[i]);
+        UniformMap_insert(&typedUniforms, UniformAliases[i], Uniforms[i]);
+    }
+
+    // Overwriting existing keys, the same as re-registering uniforms when a shader is rebuilt.
+    start = Bench_now();
+    for (u64 round = 0; round < BENCH_ROUNDS; ++round) {
+        for (u64 i = 0; i < BENCH_UNIFORM_COUNT; ++i) {
+            HashTable_insert(&uniforms, UniformAliases[i], &Uniforms[i]);
+        }
+    }
+    Bench_report("  HashTable_insert (overwrite)", Bench_now() - start, operations);
+
+    start = Bench_now();
+    for (u64 round = 0; round < BENCH_ROUNDS; ++round) {
+        for (u64 i = 0; i < BENCH_UNIFORM_COUNT; ++i) {
+            UniformMap_insert(&typedUniforms, UniformAliases[i], Uniforms[i]);
+        }
+    }
+    Bench_report("  UniformMap_insert (overwrite)", Bench_now() - start, operations);
+
+    start = Bench_now();
+    for (u64 round = 0; round < BENCH_ROUNDS; ++round) {
+        for (u64 i = 0; i < BENCH_UNIFORM_COUNT; ++i) {
+            Uniform uniform = { 0 };
+            HashTable_find(&uniforms, UniformAliases[i], uniform);
+            Bench_consume(uniform.Location);
+        }
+    }
+    Bench_report("  HashTable_find", Bench_now() - start, operations);
+
+    start = Bench_now();
+    for (u64 round = 0; round < BENCH_ROUNDS; ++round) {
+        for (u64 i = 0; i < BENCH_UNIFORM_COUNT; ++i) {
+            Uniform uniform = { 0 };
+            UniformMap_find(&typedUniforms, UniformAliases[i], &uniform);
+            Bench_consume(uniform.Location);
+        }
+    }
+    Bench_report("  UniformMap_find", Bench_now() - start, operations);
+
+    HashTable_deinitialize(&uniforms);
+    UniformMap_deinitialize(&typedUniforms);
+
+    // Filling a new table and throwing it away, the same as reflecting a shader's uniforms. Every insert copies a new key.
+    start = Bench_now();
+    for (u64 round = 0; round < BENCH_ROUNDS; ++round) {
+        HashTable fresh;
+        HashTable_initialize(Uniform, &fresh, BENCH_UNIFORM_COUNT);
+        for (u64 i = 0; i < BENCH_UNIFORM_COUNT; ++i) {
+            HashTable_insert(&fresh, UniformAliases[i], &Uniforms[i]);
+        }
+        HashTable_deinitialize(&fresh);
+    }
+    Bench_report("  HashTable_insert (new keys) + deinitialize", Bench_now() - start, operations);
+}
+
+
+int main () {
+    internal_Bench_mesh_lists();
+    internal_Bench_uniform_tables();
+    return 0;
+}
@@ -0,0 +1,139 @@
+#define BENCH_IMPLEMENTATION
+#define LIST_IMPLEMENTATION
+#define HASH_TABLE_IMPLEMENTATION
+
+#include "stdio.h"
+
+#include "bench.h"
+#include "engine_core/engine_types.h"
+#include "engine_core/list.h"
+#include "engine_core/hash_table.h"
+#include "engine/object.h"
+
+// Builds and tears down hierarchies of BENCH_NODES objects: a random tree, where each object's parent is a random earlier one, a
+// single chain, and one parent with every other object as a child. Times creating, reparenting and destroying, per object.
+// Destroying the chain would have needed a call per level before, and moving every child off the wide parent was quadratic.
+// Also checks the links agree after reparenting, and that destroying each root frees every object under it.
+//
+
+#define BENCH_NODES 1000000
+
+static u64 RandomState = 0x9E3779B97F4A7C15ull;
+
+
+u64 internal_Bench_random_u64 () {
+    RandomState ^= RandomState >> 12;
+    RandomState ^= RandomState << 25;
+    RandomState ^= RandomState >> 27;
+    return RandomState * 0x2545F4914F6CDD1Dull;
+}
+
+
+Object* internal_Bench_create (Object* parent) {
+    Object* object = (Object*)internal_Object_alloc(1, sizeof(Object));
+    internal_Object_Initialize(object, parent, 1);
+    return object;
+}
+
+
+bool internal_Bench_check_links (Object** objects, const u64 count) {
+    // Every child points back at its parent and its neighbours, and each object is some parent's child exactly once.
+    u64 children = 0;
+
+    for (u64 i = 0; i < count; ++i) {
+        Object* previous = NULL;
+        for (Object_child_iterator(objects[i])) {
+            if (child->Parent != objects[i] || child->PreviousSibling != previous) {
+                return false;
+            }
+            previous = child;
+            children++;
+        }
+    }
+    return children == count - 1;
+}
+
+
+bool internal_Bench_destroy (const char* name, Object** objects, Handle* handles, const u64 count) {
+    for (u64 i = 0; i < count; ++i) {
+        handles[i] = Object_get_handle(objects[i]);
+    }
+
+    u64 start = Bench_now();
+    objects[0]->Destroy(objects[0]);
+    Bench_report(name, Bench_now() - start, count);
+
+    for (u64 i = 0; i < count; ++i) {
+        if (Object_from_handle(1, handles[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+int main () {
+    Object** objects = (Object**)malloc(sizeof(Object*) * BENCH_NODES);
+    Handle* handles = (Handle*)malloc(sizeof(Handle) * BENCH_NODES);
+    bool failed = false;
+
+    printf("Object hierarchies (%llu objects)\n", (unsigned long long)BENCH_NODES);
+
+    // Random tree. Parents always come before their children, so reparenting to an earlier object can't make a cycle.
+    u64 start = Bench_now();
+    objects[0] = internal_Bench_create(NULL);
+    for (u64 i = 1; i < BENCH_NODES; ++i) {
+        objects[i] = internal_Bench_create(objects[internal_Bench_random_u64() % i]);
+    }
+    Bench_report("random tree, create", Bench_now() - start, (u64)BENCH_NODES);
+
+    start = Bench_now();
+    for (u64 i = 1; i < BENCH_NODES; ++i) {
+        u64 node = 1 + internal_Bench_random_u64() % (BENCH_NODES - 1);
+        Object_set_parent(objects[node], objects[internal_Bench_random_u64() % node]);
+    }
+    Bench_report("random tree, Object_set_parent", Bench_now() - start, (u64)BENCH_NODES - 1);
+
+    failed |= !internal_Bench_check_links(objects, BENCH_NODES);
+    failed |= !internal_Bench_destroy("random tree, destroy the root", objects, handles, BENCH_NODES);
+
+    // Chain, as deep as it gets.
+    start = Bench_now();
+    objects[0] = internal_Bench_create(NULL);
+    for (u64 i = 1; i < BENCH_NODES; ++i) {
+        objects[i] = internal_Bench_create(objects[i - 1]);
+    }
+    Bench_report("chain, create", Bench_now() - start, (u64)BENCH_NODES);
+
+    failed |= !internal_Bench_check_links(objects, BENCH_NODES);
+    failed |= !internal_Bench_destroy("chain, destroy the root", objects, handles, BENCH_NODES);
+
+    // One wide parent. Move every child to a second root and back.
+    start = Bench_now();
+    objects[0] = internal_Bench_create(NULL);
+    for (u64 i = 1; i < BENCH_NODES; ++i) {
+        objects[i] = internal_Bench_create(objects[0]);
+    }
+    Bench_report("wide, create", Bench_now() - start, (u64)BENCH_NODES);
+
+    Object* other = internal_Bench_create(NULL);
+    start = Bench_now();
+    for (u64 i = 1; i < BENCH_NODES; ++i) {
+        Object_set_parent(objects[i], other);
+    }
+    for (u64 i = 1; i < BENCH_NODES; ++i) {
+        Object_set_parent(objects[i], objects[0]);
+    }
+    Bench_report("wide, Object_set_parent", Bench_now() - start, 2 * ((u64)BENCH_NODES - 1));
+
+    failed |= other->FirstChild != NULL || !internal_Bench_check_links(objects, BENCH_NODES);
+    other->Destroy(other);
+    failed |= !internal_Bench_destroy("wide, destroy the root", objects, handles, BENCH_NODES);
+
+    printf("%s\n", failed ? "hierarchy check failed" : "every link agreed and every object was freed");
+
+    ObjectPools_deinitialize();
+    free(handles);
+    free(objects);
+    return failed ? 1 : 0;
+}
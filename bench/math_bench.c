@@ -0,0 +1,515 @@
+#define BENCH_IMPLEMENTATION
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "math.h"
+#include "float.h"
+
+#include "bench.h"
+#include "engine_core/engine_types.h"
+#include "engine/math.h"
+
+// Times every function in engine/math.h over BENCH_COUNT random inputs, BENCH_REPEATS times, and checks the results of the ones
+// with an exact answer against a double precision reference. Functions behind Math_select_kernels are timed at every level the
+// processor supports, and checked at the widest one. math_kernels_check compares the levels with each other, this compares them
+// with the real answer.
+//
+// Errors are relative to the largest element of the reference result, in units of FLT_EPSILON, so 1 is about one rounding step.
+// The cross product can cancel down to nothing, so its errors are relative to the lengths of its inputs instead.
+// Exits with 1 if any check is over its tolerance.
+//
+
+#define BENCH_COUNT 4096            // Inputs of each type. 3 arrays of mat4s this long still fit in L2.
+#define BENCH_REPEATS 256
+#define BENCH_BATCH 4093            // Not a multiple of 4 or 8, so the batch functions also run their tails.
+
+typedef struct BenchAccuracy {
+    const char* name;
+    double tolerance;               // In FLT_EPSILON.
+    double maxError;
+    double sumError;
+    u64 count;
+} BenchAccuracy;
+
+static u64 RandomState = 0x9E3779B97F4A7C15ull;
+
+// Inputs. Quaternions are unit length, matrices are random around a scaled identity so they are well conditioned.
+static mat4* MatrixA;
+static mat4* MatrixB;
+static mat4* MatrixOut;
+static vec4* VectorA;               // vec2, vec3 and vec4 functions all read the first elements of these.
+static vec4* VectorB;
+static vec4* VectorOut;
+static quaternion* QuaternionA;
+static quaternion* QuaternionB;
+static GLfloat* Scalars;
+static GLfloat* Soa[12];            // x, y, z of points in, points out, and x, y, z, w of quaternions.
+
+static bool Failed = false;
+
+
+float internal_Bench_random () {
+    // xorshift64*, uniform in [-1, 1).
+    RandomState ^= RandomState >> 12;
+    RandomState ^= RandomState << 25;
+    RandomState ^= RandomState >> 27;
+    return (float)((RandomState * 0x2545F4914F6CDD1Dull) >> 40) / (float)(1 << 23) - 1.0f;
+}
+
+
+void internal_Bench_random_quaternion (quaternion out) {
+    for (u32 i = 0; i < 4; ++i) {
+        out[i] = internal_Bench_random();
+    }
+    quaternion_normalize(out);
+}
+
+
+void internal_Bench_random_matrix (mat4 out) {
+    for (u32 i = 0; i < 16; ++i) {
+        out[i] = internal_Bench_random() + ((i % 5 == 0) ? 4.0f : 0.0f);
+    }
+}
+
+
+void internal_Bench_random_rigid (mat4 out) {
+    // What mat4_inverse mostly sees in the engine: a rotation, a scale and a translation.
+    vec3 translation = { 50.0f * internal_Bench_random(), 50.0f * internal_Bench_random(), 50.0f * internal_Bench_random() };
+    vec3 scale = { 1.5f + internal_Bench_random(), 1.5f + internal_Bench_random(), 1.5f + internal_Bench_random() };
+    quaternion rotation;
+    internal_Bench_random_quaternion(rotation);
+    mat4_from_trs(translation, rotation, scale, out);
+}
+
+
+void internal_Bench_initialize () {
+    MatrixA = (mat4*)malloc(sizeof(mat4) * BENCH_COUNT);
+    MatrixB = (mat4*)malloc(sizeof(mat4) * BENCH_COUNT);
+    MatrixOut = (mat4*)malloc(sizeof(mat4) * BENCH_COUNT);
+    VectorA = (vec4*)malloc(sizeof(vec4) * BENCH_COUNT);
+    VectorB = (vec4*)malloc(sizeof(vec4) * BENCH_COUNT);
+    VectorOut = (vec4*)malloc(sizeof(vec4) * BENCH_COUNT);
+    QuaternionA = (quaternion*)malloc(sizeof(quaternion) * BENCH_COUNT);
+    QuaternionB = (quaternion*)malloc(sizeof(quaternion) * BENCH_COUNT);
+    Scalars = (GLfloat*)malloc(sizeof(GLfloat) * BENCH_COUNT);
+
+    for (u32 i = 0; i < 12; ++i) {
+        Soa[i] = (GLfloat*)malloc(sizeof(GLfloat) * BENCH_COUNT);
+    }
+
+    for (u64 i = 0; i < BENCH_COUNT; ++i) {
+        internal_Bench_random_matrix(MatrixA[i]);
+        internal_Bench_random_matrix(MatrixB[i]);
+        internal_Bench_random_quaternion(QuaternionA[i]);
+        internal_Bench_random_quaternion(QuaternionB[i]);
+        for (u32 j = 0; j < 4; ++j) {
+            VectorA[i][j] = 10.0f * internal_Bench_random();
+            VectorB[i][j] = 10.0f * internal_Bench_random();
+        }
+        Scalars[i] = internal_Bench_random();
+
+        for (u32 j = 0; j < 3; ++j) {
+            Soa[j][i] = VectorA[i][j];
+        }
+        for (u32 j = 0; j < 4; ++j) {
+            Soa[6 + j][i] = QuaternionA[i][j];
+        }
+    }
+}
+
+
+void internal_Bench_deinitialize () {
+    free(MatrixA);
+    free(MatrixB);
+    free(MatrixOut);
+    free(VectorA);
+    free(VectorB);
+    free(VectorOut);
+    free(QuaternionA);
+    free(QuaternionB);
+    free(Scalars);
+
+    for (u32 i = 0; i < 12; ++i) {
+        free(Soa[i]);
+    }
+}
+
+
+void internal_Bench_report (const char* name, const u64 elapsed, const u64 operations) {
+    // Bench_report's columns, and millions of operations a second.
+    printf("%-48s %10.2f ns/op  %10.2f Mop/s\n", name, (double)elapsed / (double)operations, (double)operations * 1000.0 / (double)elapsed);
+}
+
+
+// Time statement, run once for each i in [0, BENCH_COUNT), BENCH_REPEATS times. The functions are in another translation unit,
+// so the calls can't be optimized away. The last output read keeps the stores alive.
+#define BENCH_TIME(name, ...) do { \
+    u64 start = Bench_now(); \
+    for (u64 repeat = 0; repeat < BENCH_REPEATS; ++repeat) { \
+        for (u64 i = 0; i < BENCH_COUNT; ++i) { \
+            __VA_ARGS__; \
+        } \
+    } \
+    internal_Bench_report(name, Bench_now() - start, (u64)BENCH_COUNT * BENCH_REPEATS); \
+    Bench_consume(MatrixOut[BENCH_COUNT - 1][0] + VectorOut[BENCH_COUNT - 1][0]); \
+} while (0)
+
+// The same for the batch functions, which take BENCH_BATCH elements a call. Reported per element.
+#define BENCH_TIME_BATCH(name, ...) do { \
+    u64 start = Bench_now(); \
+    for (u64 repeat = 0; repeat < BENCH_REPEATS; ++repeat) { \
+        __VA_ARGS__; \
+    } \
+    internal_Bench_report(name, Bench_now() - start, (u64)BENCH_BATCH * BENCH_REPEATS); \
+    Bench_consume(MatrixOut[0][0] + Soa[3][0]); \
+} while (0)
+
+
+void internal_Bench_time_kernels (const char* level) {
+    // The functions Math_select_kernels picks an implementation for.
+    char label[64];
+    vec3_soa points = { Soa[0], Soa[1], Soa[2] };
+    vec3_soa transformed = { Soa[3], Soa[4], Soa[5] };
+    quaternion_soa quaternions = { Soa[6], Soa[7], Soa[8], Soa[9] };
+
+    snprintf(label, sizeof(label), "mat4_multiply [%s]", level);
+    BENCH_TIME(label, mat4_multiply(MatrixA[i], MatrixB[i], MatrixOut[i]));
+    snprintf(label, sizeof(label), "mat4_inverse [%s]", level);
+    BENCH_TIME(label, mat4_inverse(MatrixA[i], MatrixOut[i]));
+    snprintf(label, sizeof(label), "mat4_from_quaternion [%s]", level);
+    BENCH_TIME(label, mat4_from_quaternion(QuaternionA[i], MatrixOut[i]));
+    snprintf(label, sizeof(label), "mat4_from_trs [%s]", level);
+    BENCH_TIME(label, mat4_from_trs(VectorA[i], QuaternionA[i], VectorB[i], MatrixOut[i]));
+
+    snprintf(label, sizeof(label), "mat4_multiply_batch [%s]", level);
+    BENCH_TIME_BATCH(label, mat4_multiply_batch(BENCH_BATCH, MatrixA, MatrixB, MatrixOut));
+    snprintf(label, sizeof(label), "vec3_transform_points_soa [%s]", level);
+    BENCH_TIME_BATCH(label, vec3_transform_points_soa(MatrixA[repeat], BENCH_BATCH, points, transformed));
+    snprintf(label, sizeof(label), "quaternion_to_mat4_batch [%s]", level);
+    BENCH_TIME_BATCH(label, quaternion_to_mat4_batch(BENCH_BATCH, quaternions, MatrixOut));
+}
+
+
+void internal_Bench_time () {
+    vec3 up = { 0.0f, 1.0f, 0.0f };
+
+    BENCH_TIME("vec2_add", vec2_add(VectorA[i], VectorB[i], VectorOut[i]));
+    BENCH_TIME("vec3_add", vec3_add(VectorA[i], VectorB[i], VectorOut[i]));
+    BENCH_TIME("vec4_add", vec4_add(VectorA[i], VectorB[i], VectorOut[i]));
+    BENCH_TIME("vec2_sub", vec2_sub(VectorA[i], VectorB[i], VectorOut[i]));
+    BENCH_TIME("vec3_sub", vec3_sub(VectorA[i], VectorB[i], VectorOut[i]));
+    BENCH_TIME("vec4_sub", vec4_sub(VectorA[i], VectorB[i], VectorOut[i]));
+    BENCH_TIME("vec2_multiply", vec2_multiply(VectorA[i], VectorB[i], VectorOut[i]));
+    BENCH_TIME("vec3_multiply", vec3_multiply(VectorA[i], VectorB[i], VectorOut[i]));
+    BENCH_TIME("vec4_multiply", vec4_multiply(VectorA[i], VectorB[i], VectorOut[i]));
+    BENCH_TIME("vec3_cross", vec3_cross(VectorA[i], VectorB[i], VectorOut[i]));
+    BENCH_TIME("vec2_magnitude", VectorOut[i][0] = (GLfloat)vec2_magnitude(VectorA[i]));
+    BENCH_TIME("vec3_magnitude", VectorOut[i][0] = (GLfloat)vec3_magnitude(VectorA[i]));
+    BENCH_TIME("vec4_magnitude", VectorOut[i][0] = (GLfloat)vec4_magnitude(VectorA[i]));
+
+    // In place, so these normalize vectors that are already unit length after the first repeat. That doesn't change the work.
+    BENCH_TIME("vec2_normalize", vec2_normalize(VectorOut[i]));
+    BENCH_TIME("vec3_normalize", vec3_normalize(VectorOut[i]));
+    BENCH_TIME("vec4_normalize", vec4_normalize(VectorOut[i]));
+
+    BENCH_TIME("vec3_rotate_axis", vec3_rotate_axis(VectorA[i], VectorB[i], Scalars[i], VectorOut[i]));
+    BENCH_TIME("vec3_rotate", vec3_rotate(VectorA[i], QuaternionA[i], VectorOut[i]));
+    BENCH_TIME("quaternion_from_axis", quaternion_from_axis(VectorA[i], Scalars[i], VectorOut[i]));
+    BENCH_TIME("quaternion_invert", quaternion_invert(QuaternionB[i]));
+    BENCH_TIME("quaternion_multiply", quaternion_multiply(QuaternionA[i], QuaternionB[i], VectorOut[i]));
+
+    BENCH_TIME("mat4_multi_multiply (3 matrices)", mat4_multi_multiply(4, MatrixA[i], MatrixB[i], MatrixA[i], MatrixOut[i]));
+    BENCH_TIME("mat4_translate", mat4_translate(VectorA[i], MatrixOut[i]));
+    BENCH_TIME("mat4_scale", mat4_scale(VectorA[i], MatrixOut[i]));
+    BENCH_TIME("mat4_get_forward", mat4_get_forward(MatrixA[i], VectorOut[i]));
+    BENCH_TIME("mat4_get_right", mat4_get_right(MatrixA[i], VectorOut[i]));
+    BENCH_TIME("mat4_get_up", mat4_get_up(MatrixA[i], VectorOut[i]));
+    BENCH_TIME("mat4_get_translation", mat4_get_translation(MatrixA[i], VectorOut[i]));
+    BENCH_TIME("mat4_determinant", VectorOut[i][0] = mat4_determinant(MatrixA[i]));
+    BENCH_TIME("mat4_transpose", mat4_transpose(MatrixA[i], MatrixOut[i]));
+    BENCH_TIME("mat4_lookat", mat4_lookat(VectorA[i], VectorB[i], up, MatrixOut[i]));
+    BENCH_TIME("mat4_projection_perspective", mat4_projection_perspective(60.0 + Scalars[i], 1.5, 0.01, 1000.0, MatrixOut[i]));
+    BENCH_TIME("mat4_projection_frustum", mat4_projection_frustum(-1.0, 1.0 + Scalars[i], 1.0, -1.0, 0.01, 1000.0, MatrixOut[i]));
+    BENCH_TIME("mat4_projection_orthographic", mat4_projection_orthographic(-1.0, 1.0 + Scalars[i], 1.0, -1.0, 0.01, 1000.0, MatrixOut[i]));
+
+    static const char* levels[] = { "scalar", "sse2", "avx2" };
+    for (u8 level = MATH_KERNELS_SCALAR; level <= MATH_KERNELS_AVX2; ++level) {
+        if (Math_select_kernels(level) == level) {
+            internal_Bench_time_kernels(levels[level]);
+        }
+    }
+}
+
+
+// DOUBLE PRECISION REFERENCES:
+//
+// Written independently of math.c where there is a different way to get the same answer, so a mistake in a formula there
+// doesn't also end up here.
+//
+
+typedef double dmat4[16];
+
+
+void internal_Reference_multiply (const GLfloat* left, const GLfloat* right, double* out) {
+    // Same convention as mat4_multiply: out = right * left in column major terms.
+    for (u32 column = 0; column < 4; ++column) {
+        for (u32 row = 0; row < 4; ++row) {
+            double sum = 0.0;
+            for (u32 k = 0; k < 4; ++k) {
+                sum += (double)right[4 * k + row] * (double)left[4 * column + k];
+            }
+            out[4 * column + row] = sum;
+        }
+    }
+}
+
+
+double internal_Reference_inverse (const GLfloat* m, double* out) {
+    // Gauss-Jordan elimination with partial pivoting on [m | I]. Returns the determinant.
+    double work[4][8];
+    double determinant = 1.0;
+
+    for (u32 row = 0; row < 4; ++row) {
+        for (u32 column = 0; column < 4; ++column) {
+            work[row][column] = (double)m[4 * column + row];
+            work[row][4 + column] = (row == column) ? 1.0 : 0.0;
+        }
+    }
+
+    for (u32 column = 0; column < 4; ++column) {
+        u32 pivot = column;
+        for (u32 row = column + 1; row < 4; ++row) {
+            pivot = (fabs(work[row][column]) > fabs(work[pivot][column])) ? row : pivot;
+        }
+
+        if (pivot != column) {
+            for (u32 k = 0; k < 8; ++k) {
+                double swap = work[column][k];
+                work[column][k] = work[pivot][k];
+                work[pivot][k] = swap;
+            }
+            determinant = -determinant;
+        }
+
+        double divisor = work[column][column];
+        determinant *= divisor;
+        for (u32 k = 0; k < 8; ++k) {
+            work[column][k] /= divisor;
+        }
+
+        for (u32 row = 0; row < 4; ++row) {
+            if (row == column) {
+                continue;
+            }
+            double factor = work[row][column];
+            for (u32 k = 0; k < 8; ++k) {
+                work[row][k] -= factor * work[column][k];
+            }
+        }
+    }
+
+    for (u32 row = 0; row < 4; ++row) {
+        for (u32 column = 0; column < 4; ++column) {
+            out[4 * column + row] = work[row][4 + column];
+        }
+    }
+    return determinant;
+}
+
+
+void internal_Reference_quaternion_multiply (const double* left, const double* right, double* out) {
+    // Hamilton product, (x, y, z, w) with w the real part.
+    double result[4] = {
+        left[3] * right[0] + left[0] * right[3] + left[1] * right[2] - left[2] * right[1],
+        left[3] * right[1] - left[0] * right[2] + left[1] * right[3] + left[2] * right[0],
+        left[3] * right[2] + left[0] * right[1] - left[1] * right[0] + left[2] * right[3],
+        left[3] * right[3] - left[0] * right[0] - left[1] * right[1] - left[2] * right[2],
+    };
+
+    for (u32 i = 0; i < 4; ++i) {
+        out[i] = result[i];
+    }
+}
+
+
+void internal_Reference_rotate (const GLfloat* v, const GLfloat* q, double* out) {
+    // q * v * conjugate(q), with v as a quaternion with no real part.
+    double rotation[4] = { q[0], q[1], q[2], q[3] };
+    double conjugate[4] = { -q[0], -q[1], -q[2], q[3] };
+    double point[4] = { v[0], v[1], v[2], 0.0 };
+    double result[4];
+
+    internal_Reference_quaternion_multiply(rotation, point, result);
+    internal_Reference_quaternion_multiply(result, conjugate, result);
+    out[0] = result[0];
+    out[1] = result[1];
+    out[2] = result[2];
+}
+
+
+void internal_Reference_trs (const GLfloat* translation, const GLfloat* q, const GLfloat* scale, double* out) {
+    // Columns are the rotated and scaled axes, then the translation.
+    for (u32 axis = 0; axis < 3; ++axis) {
+        GLfloat basis[3] = { 0.0f, 0.0f, 0.0f };
+        basis[axis] = 1.0f;
+        internal_Reference_rotate(basis, q, out + 4 * axis);
+        out[4 * axis] *= scale[axis];
+        out[4 * axis + 1] *= scale[axis];
+        out[4 * axis + 2] *= scale[axis];
+        out[4 * axis + 3] = 0.0;
+    }
+    out[12] = translation[0];
+    out[13] = translation[1];
+    out[14] = translation[2];
+    out[15] = 1.0;
+}
+
+
+void internal_Accuracy_add (BenchAccuracy* accuracy, const GLfloat* result, const double* reference, const u32 count, double largest) {
+    // Errors are relative to largest, or to the largest element of reference when it is 0.
+    double error = 0.0;
+
+    if (largest == 0.0) {
+        for (u32 i = 0; i < count; ++i) {
+            largest = (fabs(reference[i]) > largest) ? fabs(reference[i]) : largest;
+        }
+    }
+
+    for (u32 i = 0; i < count; ++i) {
+        double difference = fabs((double)result[i] - reference[i]) / ((largest > 0.0) ? largest : 1.0) / FLT_EPSILON;
+        error = (difference > error) ? difference : error;
+    }
+
+    accuracy->maxError = (error > accuracy->maxError) ? error : accuracy->maxError;
+    accuracy->sumError += error;
+    accuracy->count++;
+}
+
+
+void internal_Accuracy_report (BenchAccuracy* accuracy) {
+    bool passed = accuracy->maxError <= accuracy->tolerance;
+    Failed |= !passed;
+    printf("%-48s max %8.2f  mean %8.3f  tolerance %6.1f  %s\n", accuracy->name, accuracy->maxError, accuracy->sumError / (double)accuracy->count, accuracy->tolerance, passed ? "ok" : "FAILED");
+}
+
+
+void internal_Bench_accuracy () {
+    BenchAccuracy multiply = { "mat4_multiply", 4.0 };
+    BenchAccuracy inverse = { "mat4_inverse (random)", 16.0 };
+    BenchAccuracy inverseRigid = { "mat4_inverse (rotation, scale, translation)", 16.0 };
+    BenchAccuracy determinant = { "mat4_determinant", 16.0 };
+    BenchAccuracy normalize3 = { "vec3_normalize", 2.0 };
+    BenchAccuracy normalize4 = { "vec4_normalize", 2.0 };
+    BenchAccuracy cross = { "vec3_cross", 2.0 };
+    BenchAccuracy quaternionMultiply = { "quaternion_multiply", 4.0 };
+    BenchAccuracy rotate = { "vec3_rotate", 8.0 };
+    BenchAccuracy fromQuaternion = { "mat4_from_quaternion", 8.0 };
+    BenchAccuracy trs = { "mat4_from_trs", 8.0 };
+    BenchAccuracy transformPoints = { "vec3_transform_points_soa", 4.0 };
+
+    dmat4 reference;
+    mat4 result;
+    mat4 rigid;
+
+    for (u64 i = 0; i < BENCH_COUNT; ++i) {
+        internal_Reference_multiply(MatrixA[i], MatrixB[i], reference);
+        mat4_multiply(MatrixA[i], MatrixB[i], result);
+        internal_Accuracy_add(&multiply, result, reference, 16, 0.0);
+
+        double referenceDeterminant = internal_Reference_inverse(MatrixA[i], reference);
+        mat4_inverse(MatrixA[i], result);
+        internal_Accuracy_add(&inverse, result, reference, 16, 0.0);
+
+        result[0] = mat4_determinant(MatrixA[i]);
+        internal_Accuracy_add(&determinant, result, &referenceDeterminant, 1, 0.0);
+
+        internal_Bench_random_rigid(rigid);
+        internal_Reference_inverse(rigid, reference);
+        mat4_inverse(rigid, result);
+        internal_Accuracy_add(&inverseRigid, result, reference, 16, 0.0);
+
+        double length = sqrt((double)VectorA[i][0] * VectorA[i][0] + (double)VectorA[i][1] * VectorA[i][1] + (double)VectorA[i][2] * VectorA[i][2]);
+        vec3_copy(VectorA[i], result);
+        vec3_normalize(result);
+        for (u32 j = 0; j < 3; ++j) {
+            reference[j] = VectorA[i][j] / length;
+        }
+        internal_Accuracy_add(&normalize3, result, reference, 3, 0.0);
+
+        length = sqrt(length * length + (double)VectorA[i][3] * VectorA[i][3]);
+        vec4_copy(VectorA[i], result);
+        vec4_normalize(result);
+        for (u32 j = 0; j < 4; ++j) {
+            reference[j] = VectorA[i][j] / length;
+        }
+        internal_Accuracy_add(&normalize4, result, reference, 4, 0.0);
+
+        const GLfloat* u = VectorA[i];
+        const GLfloat* v = VectorB[i];
+        reference[0] = (double)u[1] * v[2] - (double)u[2] * v[1];
+        reference[1] = (double)u[2] * v[0] - (double)u[0] * v[2];
+        reference[2] = (double)u[0] * v[1] - (double)u[1] * v[0];
+        vec3_cross(u, v, result);
+        internal_Accuracy_add(&cross, result, reference, 3, sqrt(vec3_dot(u, u) * vec3_dot(v, v)));
+
+        double left[4] = { QuaternionA[i][0], QuaternionA[i][1], QuaternionA[i][2], QuaternionA[i][3] };
+        double right[4] = { QuaternionB[i][0], QuaternionB[i][1], QuaternionB[i][2], QuaternionB[i][3] };
+        internal_Reference_quaternion_multiply(left, right, reference);
+        quaternion_multiply(QuaternionA[i], QuaternionB[i], result);
+        internal_Accuracy_add(&quaternionMultiply, result, reference, 4, 0.0);
+
+        internal_Reference_rotate(VectorA[i], QuaternionA[i], reference);
+        vec3_rotate(VectorA[i], QuaternionA[i], result);
+        internal_Accuracy_add(&rotate, result, reference, 3, 0.0);
+
+        internal_Reference_trs(V3_ZERO, QuaternionA[i], V3_ONE, reference);
+        mat4_from_quaternion(QuaternionA[i], result);
+        internal_Accuracy_add(&fromQuaternion, result, reference, 16, 0.0);
+
+        internal_Reference_trs(VectorA[i], QuaternionA[i], VectorB[i], reference);
+        mat4_from_trs(VectorA[i], QuaternionA[i], VectorB[i], result);
+        internal_Accuracy_add(&trs, result, reference, 16, 0.0);
+    }
+
+    // Points by a matrix is the matrix times (x, y, z, 1), read back from the SoA output.
+    vec3_soa points = { Soa[0], Soa[1], Soa[2] };
+    vec3_soa transformed = { Soa[3], Soa[4], Soa[5] };
+    vec3_transform_points_soa(MatrixB[0], BENCH_COUNT, points, transformed);
+    for (u64 i = 0; i < BENCH_COUNT; ++i) {
+        const GLfloat* m = MatrixB[0];
+        for (u32 axis = 0; axis < 3; ++axis) {
+            reference[axis] = (double)m[axis] * Soa[0][i] + (double)m[4 + axis] * Soa[1][i] + (double)m[8 + axis] * Soa[2][i] + (double)m[12 + axis];
+        }
+        GLfloat point[3] = { Soa[3][i], Soa[4][i], Soa[5][i] };
+        internal_Accuracy_add(&transformPoints, point, reference, 3, 0.0);
+    }
+
+    printf("\nAccuracy against double precision (%llu inputs, error in FLT_EPSILON of the largest element)\n", (unsigned long long)BENCH_COUNT);
+    internal_Accuracy_report(&multiply);
+    internal_Accuracy_report(&inverse);
+    internal_Accuracy_report(&inverseRigid);
+    internal_Accuracy_report(&determinant);
+    internal_Accuracy_report(&normalize3);
+    internal_Accuracy_report(&normalize4);
+    internal_Accuracy_report(&cross);
+    internal_Accuracy_report(&quaternionMultiply);
+    internal_Accuracy_report(&rotate);
+    internal_Accuracy_report(&fromQuaternion);
+    internal_Accuracy_report(&trs);
+    internal_Accuracy_report(&transformPoints);
+}
+
+
+int main () {
+    internal_Bench_initialize();
+
+    printf("Math functions (%llu inputs, %llu repeats)\n", (unsigned long long)BENCH_COUNT, (unsigned long long)BENCH_REPEATS);
+    internal_Bench_time();
+
+    // Check whatever the engine would use.
+    Math_select_kernels(MATH_KERNELS_AVX2);
+    internal_Bench_accuracy();
+
+    internal_Bench_deinitialize();
+    return Failed ? 1 : 0;
+}
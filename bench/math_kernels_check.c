@@ -0,0 +1,190 @@
+#include "stdio.h"
+#include "math.h"
+
+#include "engine_core/engine_types.h"
+#include "engine/math.h"
+
+// Runs every level of the math kernels Math_select_kernels can pick on the same random inputs and compares each one against the
+// scalar version. The SIMD kernels do the same operations in the same order as the scalar ones, so results normally match
+// exactly, but a compiler allowed to fuse multiplies and adds in the scalar code can move them by a rounding step or two, so
+// the check accepts a small relative error. Exits with 1 if any kernel is outside it.
+//
+
+#define CHECK_ITERATIONS 100000
+#define CHECK_TOLERANCE 1e-5
+#define CHECK_BATCH 37              // Not a multiple of 4 or 8, so the batch functions also run their tails.
+
+typedef struct CheckResult {
+    const char* name;
+    double maxError;
+    u64 exact;
+    u64 count;
+} CheckResult;
+
+static u64 RandomState = 0x9E3779B97F4A7C15ull;
+
+
+float internal_Check_random () {
+    // xorshift64*, uniform in [-1, 1).
+    RandomState ^= RandomState >> 12;
+    RandomState ^= RandomState << 25;
+    RandomState ^= RandomState >> 27;
+    return (float)((RandomState * 0x2545F4914F6CDD1Dull) >> 40) / (float)(1 << 23) - 1.0f;
+}
+
+
+void internal_Check_random_matrix (mat4 out) {
+    // Random entries around a scaled identity, so the inverse is well conditioned.
+    for (u32 i = 0; i < 16; ++i) {
+        out[i] = internal_Check_random() + ((i % 5 == 0) ? 4.0f : 0.0f);
+    }
+}
+
+
+void internal_Check_random_quaternion (quaternion out, bool normalize) {
+    for (u32 i = 0; i < 4; ++i) {
+        out[i] = internal_Check_random();
+    }
+    if (normalize) {
+        float length = sqrtf(out[0] * out[0] + out[1] * out[1] + out[2] * out[2] + out[3] * out[3]);
+        for (u32 i = 0; i < 4; ++i) {
+            out[i] /= length;
+        }
+    }
+}
+
+
+void internal_Check_compare (CheckResult* result, const GLfloat* reference, const GLfloat* value, const u32 count) {
+    for (u32 i = 0; i < count; ++i) {
+        double error = fabs((double)reference[i] - (double)value[i]) / fmax(1.0, fabs((double)reference[i]));
+
+        result->maxError = fmax(result->maxError, error);
+        result->exact += (reference[i] == value[i]);
+        result->count++;
+    }
+}
+
+
+bool internal_Check_level (const u8 level) {
+    CheckResult results[] = {
+        { "mat4_multiply" }, { "mat4_multiply in place" }, { "mat4_inverse" }, { "mat4_from_quaternion" }, 
+        { "mat4_multiply_batch" }, { "vec3_transform_points_soa" }, { "quaternion_to_mat4_batch" },
+    };
+    bool passed = true;
+
+    RandomState = 0x9E3779B97F4A7C15ull;
+    for (u32 i = 0; i < CHECK_ITERATIONS; ++i) {
+        mat4 left, right, reference, value;
+        quaternion unit;
+
+        internal_Check_random_matrix(left);
+        internal_Check_random_matrix(right);
+        internal_Check_random_quaternion(unit, true);
+
+        Math_select_kernels(MATH_KERNELS_SCALAR);
+        mat4_multiply(left, right, reference);
+        Math_select_kernels(level);
+        mat4_multiply(left, right, value);
+        internal_Check_compare(&results[0], reference, value, 16);
+
+        mat4_copy(left, value);
+        mat4_multiply(value, right, value);
+        internal_Check_compare(&results[1], reference, value, 16);
+
+        Math_select_kernels(MATH_KERNELS_SCALAR);
+        mat4_inverse(left, reference);
+        Math_select_kernels(level);
+        mat4_inverse(left, value);
+        internal_Check_compare(&results[2], reference, value, 16);
+
+        Math_select_kernels(MATH_KERNELS_SCALAR);
+        mat4_from_quaternion(unit, reference);
+        Math_select_kernels(level);
+        mat4_from_quaternion(unit, value);
+        internal_Check_compare(&results[3], reference, value, 16);
+    }
+
+    // The batch functions against the scalar single versions, in place for the points.
+    for (u32 i = 0; i < CHECK_ITERATIONS / CHECK_BATCH; ++i) {
+        mat4 left[CHECK_BATCH], right[CHECK_BATCH], reference[CHECK_BATCH], value[CHECK_BATCH];
+        GLfloat x[CHECK_BATCH], y[CHECK_BATCH], z[CHECK_BATCH], w[CHECK_BATCH];
+        GLfloat referencePoints[CHECK_BATCH * 3];
+        GLfloat valuePoints[CHECK_BATCH * 3];
+
+        for (u32 j = 0; j < CHECK_BATCH; ++j) {
+            internal_Check_random_matrix(left[j]);
+            internal_Check_random_matrix(right[j]);
+            x[j] = internal_Check_random();
+            y[j] = internal_Check_random();
+            z[j] = internal_Check_random();
+            w[j] = internal_Check_random();
+        }
+
+        Math_select_kernels(MATH_KERNELS_SCALAR);
+        for (u32 j = 0; j < CHECK_BATCH; ++j) {
+            mat4_multiply(left[j], right[j], reference[j]);
+        }
+        Math_select_kernels(level);
+        mat4_multiply_batch(CHECK_BATCH, left, right, value);
+        internal_Check_compare(&results[4], reference[0], value[0], 16 * CHECK_BATCH);
+
+        for (u32 j = 0; j < CHECK_BATCH; ++j) {
+            const GLfloat* m = left[0];
+            referencePoints[3 * j] = x[j] * m[0] + y[j] * m[4] + z[j] * m[8] + m[12];
+            referencePoints[3 * j + 1] = x[j] * m[1] + y[j] * m[5] + z[j] * m[9] + m[13];
+            referencePoints[3 * j + 2] = x[j] * m[2] + y[j] * m[6] + z[j] * m[10] + m[14];
+        }
+        vec3_soa points = { x, y, z };
+        vec3_transform_points_soa(left[0], CHECK_BATCH, points, points);
+        for (u32 j = 0; j < CHECK_BATCH; ++j) {
+            valuePoints[3 * j] = x[j];
+            valuePoints[3 * j + 1] = y[j];
+            valuePoints[3 * j + 2] = z[j];
+        }
+        internal_Check_compare(&results[5], referencePoints, valuePoints, 3 * CHECK_BATCH);
+
+        for (u32 j = 0; j < CHECK_BATCH; ++j) {
+            quaternion q = { x[j], y[j], z[j], w[j] };
+            quaternion_normalize(q);
+            x[j] = q[0];
+            y[j] = q[1];
+            z[j] = q[2];
+            w[j] = q[3];
+        }
+        Math_select_kernels(MATH_KERNELS_SCALAR);
+        for (u32 j = 0; j < CHECK_BATCH; ++j) {
+            quaternion q = { x[j], y[j], z[j], w[j] };
+            mat4_from_quaternion(q, reference[j]);
+        }
+        Math_select_kernels(level);
+        quaternion_to_mat4_batch(CHECK_BATCH, (quaternion_soa){ x, y, z, w }, value);
+        internal_Check_compare(&results[6], reference[0], value[0], 16 * CHECK_BATCH);
+    }
+
+    for (u32 i = 0; i < sizeof(results) / sizeof(results[0]); ++i) {
+        bool ok = results[i].maxError <= CHECK_TOLERANCE;
+        printf("  %-28s max error %.3e, %6.2f%% exact  %s\n", results[i].name, results[i].maxError, 
+            100.0 * (double)results[i].exact / (double)results[i].count, ok ? "ok" : "FAILED");
+        passed &= ok;
+    }
+    return passed;
+}
+
+
+int main () {
+    const char* names[] = { "scalar", "SSE2", "AVX2" };
+    bool passed = true;
+
+    for (u8 level = MATH_KERNELS_SSE2; level <= MATH_KERNELS_AVX2; ++level) {
+        u8 selected = Math_select_kernels(level);
+        if (selected != level) {
+            printf("%s: not supported here, skipped\n", names[level]);
+            continue;
+        }
+
+        printf("%s against scalar (%d iterations)\n", names[level], CHECK_ITERATIONS);
+        passed &= internal_Check_level(level);
+    }
+
+    return passed ? 0 : 1;
+}
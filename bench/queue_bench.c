@@ -0,0 +1,230 @@
+#define BENCH_IMPLEMENTATION
+#define LIST_IMPLEMENTATION
+
+#include "stdio.h"
+#include <stdatomic.h>
+
+#include "bench.h"
+#include "engine_core/list.h"
+#include "engine_core/thread.h"
+#include "engine_core/queue.h"
+
+// Moves BENCH_ITEMS u64s from producer threads to consumer threads through a queue of BENCH_QUEUE_CAPACITY slots, one at a time
+// and in batches of BENCH_BATCH. Compares SpscQueue and MpmcQueue against a List behind a Mutex, which is what the engine would
+// use otherwise. Times are wall clock for the whole run divided by the items moved.
+//
+// Producers and consumers spin on a full or empty queue, so runs with more threads than cores mostly measure the scheduler.
+//
+
+#define BENCH_ITEMS (1 << 22)
+#define BENCH_QUEUE_CAPACITY 1024
+#define BENCH_BATCH 32
+
+typedef u64 (*BenchTransfer)(void* queue, u64* items, const u64 count);
+
+typedef struct BenchQueue {
+    const char* name;
+    void* queue;
+    BenchTransfer push;
+    BenchTransfer pop;
+} BenchQueue;
+
+typedef struct BenchWorker {
+    Thread thread;
+    BenchQueue* queue;
+    u64 first;              // Producers push first to first + count - 1.
+    u64 count;
+    u64 batch;
+    u64 sum;
+} BenchWorker;
+
+static SpscQueue Spsc;
+static MpmcQueue Mpmc;
+static List Locked;
+static Mutex LockedLock;
+
+static atomic_bool StartFlag;
+static _Atomic(u64) ItemsLeft;     // Items consumers still have to pop, shared between them.
+
+
+u64 internal_Bench_spsc_push (void* queue, u64* items, const u64 count) {
+    return SpscQueue_push_n((SpscQueue*)queue, items, count);
+}
+
+
+u64 internal_Bench_spsc_pop (void* queue, u64* items, const u64 count) {
+    return SpscQueue_pop_n((SpscQueue*)queue, items, count);
+}
+
+
+u64 internal_Bench_mpmc_push (void* queue, u64* items, const u64 count) {
+    return MpmcQueue_push_n((MpmcQueue*)queue, items, count);
+}
+
+
+u64 internal_Bench_mpmc_pop (void* queue, u64* items, const u64 count) {
+    return MpmcQueue_pop_n((MpmcQueue*)queue, items, count);
+}
+
+
+u64 internal_Bench_locked_push (void* queue, u64* items, const u64 count) {
+    u64 pushed = 0;
+
+    Mutex_lock(&LockedLock);
+    for (; pushed < count && List_count((List*)queue) < BENCH_QUEUE_CAPACITY; ++pushed) {
+        List_push_back((List*)queue, items[pushed]);
+    }
+    Mutex_unlock(&LockedLock);
+    return pushed;
+}
+
+
+u64 internal_Bench_locked_pop (void* queue, u64* items, const u64 count) {
+    u64 popped = 0;
+
+    Mutex_lock(&LockedLock);
+    for (; popped < count && !List_isEmpty((List*)queue); ++popped) {
+        List_pop_back((List*)queue, items[popped]);     // Oldest first.
+    }
+    Mutex_unlock(&LockedLock);
+    return popped;
+}
+
+
+void internal_Bench_wait_for_start () {
+    while (!atomic_load_explicit(&StartFlag, memory_order_acquire)) {
+        Thread_yield();
+    }
+}
+
+
+void internal_Bench_producer (void* workerPtr) {
+    BenchWorker* worker = (BenchWorker*)workerPtr;
+    u64 items[BENCH_BATCH];
+
+    internal_Bench_wait_for_start();
+    for (u64 next = worker->first, end = worker->first + worker->count; next < end;) {
+        u64 count = (end - next < worker->batch) ? end - next : worker->batch;
+        for (u64 i = 0; i < count; ++i) {
+            items[i] = next + i;
+        }
+
+        u64 pushed = worker->queue->push(worker->queue->queue, items, count);
+        next += pushed;
+
+        // Full, give a consumer the core. Whatever didn't fit is pushed again from next.
+        if (!pushed) {
+            Thread_yield();
+        }
+    }
+}
+
+
+void internal_Bench_consumer (void* workerPtr) {
+    BenchWorker* worker = (BenchWorker*)workerPtr;
+    u64 items[BENCH_BATCH];
+    u64 sum = 0;
+
+    internal_Bench_wait_for_start();
+    while (atomic_load_explicit(&ItemsLeft, memory_order_relaxed)) {
+        u64 popped = worker->queue->pop(worker->queue->queue, items, worker->batch);
+
+        if (!popped) {
+            Thread_yield();
+            continue;
+        }
+
+        for (u64 i = 0; i < popped; ++i) {
+            sum += items[i];
+        }
+        atomic_fetch_sub_explicit(&ItemsLeft, popped, memory_order_relaxed);
+    }
+    worker->sum = sum;
+}
+
+
+void internal_Bench_run (BenchQueue* queue, const u32 producers, const u32 consumers, const u64 batch) {
+    BenchWorker* workers = (BenchWorker*)calloc(producers + consumers, sizeof(BenchWorker));
+    char label[64];
+
+    atomic_store(&StartFlag, false);
+    atomic_store(&ItemsLeft, BENCH_ITEMS);
+
+    for (u32 i = 0; i < producers + consumers; ++i) {
+        workers[i].queue = queue;
+        workers[i].batch = batch;
+    }
+
+    for (u32 i = 0; i < producers; ++i) {
+        workers[i].first = (u64)BENCH_ITEMS / producers * i;
+        workers[i].count = (i + 1 == producers) ? BENCH_ITEMS - workers[i].first : (u64)BENCH_ITEMS / producers;
+        Thread_create(&workers[i].thread, internal_Bench_producer, &workers[i]);
+    }
+
+    for (u32 i = producers; i < producers + consumers; ++i) {
+        Thread_create(&workers[i].thread, internal_Bench_consumer, &workers[i]);
+    }
+
+    u64 start = Bench_now();
+    atomic_store_explicit(&StartFlag, true, memory_order_release);
+
+    u64 sum = 0;
+    for (u32 i = 0; i < producers + consumers; ++i) {
+        Thread_join(&workers[i].thread);
+        sum += workers[i].sum;
+    }
+    u64 elapsed = Bench_now() - start;
+
+    // Every item is popped exactly once.
+    if (sum != (u64)BENCH_ITEMS * (BENCH_ITEMS - 1) / 2) {
+        printf("%s lost items\n", queue->name);
+    }
+
+    snprintf(label, sizeof(label), "%s, %luP/%luC, batch %llu", queue->name, (unsigned long)producers, (unsigned long)consumers, (unsigned long long)batch);
+    Bench_report(label, elapsed, (u64)BENCH_ITEMS);
+    free(workers);
+}
+
+
+int main () {
+    BenchQueue spsc = { "SpscQueue", &Spsc, internal_Bench_spsc_push, internal_Bench_spsc_pop };
+    BenchQueue mpmc = { "MpmcQueue", &Mpmc, internal_Bench_mpmc_push, internal_Bench_mpmc_pop };
+    BenchQueue locked = { "List behind a Mutex", &Locked, internal_Bench_locked_push, internal_Bench_locked_pop };
+
+    SpscQueue_initialize(u64, &Spsc, BENCH_QUEUE_CAPACITY);
+    MpmcQueue_initialize(u64, &Mpmc, BENCH_QUEUE_CAPACITY);
+    List_initialize(u64, &Locked, BENCH_QUEUE_CAPACITY + 1);
+    Mutex_initialize(&LockedLock);
+
+    u32 maxThreads = Thread_hardware_concurrency();
+    printf("Queue throughput (%llu items, %llu slots, %lu cores)\n", (unsigned long long)BENCH_ITEMS, (unsigned long long)BENCH_QUEUE_CAPACITY, (unsigned long)maxThreads);
+
+    for (u64 batch = 1; batch <= BENCH_BATCH; batch *= BENCH_BATCH) {
+        internal_Bench_run(&spsc, 1, 1, batch);
+        internal_Bench_run(&mpmc, 1, 1, batch);
+        internal_Bench_run(&locked, 1, 1, batch);
+    }
+
+    // Same number of producers and consumers, then fan in and fan out.
+    for (u32 threads = 2; threads <= maxThreads / 2; threads *= 2) {
+        for (u64 batch = 1; batch <= BENCH_BATCH; batch *= BENCH_BATCH) {
+            internal_Bench_run(&mpmc, threads, threads, batch);
+            internal_Bench_run(&locked, threads, threads, batch);
+        }
+    }
+
+    if (maxThreads > 2) {
+        for (u64 batch = 1; batch <= BENCH_BATCH; batch *= BENCH_BATCH) {
+            internal_Bench_run(&mpmc, maxThreads - 1, 1, batch);
+            internal_Bench_run(&locked, maxThreads - 1, 1, batch);
+            internal_Bench_run(&mpmc, 1, maxThreads - 1, batch);
+            internal_Bench_run(&locked, 1, maxThreads - 1, batch);
+        }
+    }
+
+    SpscQueue_deinitialize(&Spsc);
+    MpmcQueue_deinitialize(&Mpmc);
+    List_deinitialize(&Locked);
+    Mutex_deinitialize(&LockedLock);
+    return 0;
+}
@@ -0,0 +1,170 @@
+#define BENCH_IMPLEMENTATION
+#define LIST_IMPLEMENTATION
+#define HASH_TABLE_IMPLEMENTATION
+
+#include "stdio.h"
+#include "math.h"
+
+#include "bench.h"
+#include "engine_core/engine_types.h"
+#include "engine_core/list.h"
+#include "engine_core/hash_table.h"
+#include "engine_core/arena.h"
+#include "engine_core/job.h"
+#include "engine_core/thread.h"
+#include "engine/math.h"
+#include "engine/object.h"
+#include "engine/scene.h"
+
+// Builds a random hierarchy of BENCH_OBJECTS objects under BENCH_ROOTS roots and compares getting every world matrix by walking
+// each object's parents with Object_get_world_space_transform against one Scene_update_transforms pass, on the calling thread
+// and on the job system. Times are per object. Also checks the two give the same matrices.
+//
+// Then times frames where nothing moves and frames where a few objects move, which only recompute the subtrees under them, and
+// prints how many nodes each frame recomputed.
+//
+
+#define BENCH_OBJECTS 100000
+#define BENCH_ROOTS 4
+#define BENCH_FRAMES 32
+
+static u64 RandomState = 0x9E3779B97F4A7C15ull;
+
+
+u64 internal_Bench_random_u64 () {
+    RandomState ^= RandomState >> 12;
+    RandomState ^= RandomState << 25;
+    RandomState ^= RandomState >> 27;
+    return RandomState * 0x2545F4914F6CDD1Dull;
+}
+
+
+float internal_Bench_random () {
+    // Uniform in [-1, 1).
+    return (float)(internal_Bench_random_u64() >> 40) / (float)(1 << 23) - 1.0f;
+}
+
+
+void internal_Bench_dirty_all (Object** objects) {
+    // Stands in for a scene where everything moves, so the timed pass recomputes every node.
+    for (u64 i = 0; i < BENCH_OBJECTS; ++i) {
+        Object_flag_set(&objects[i]->Data.Flags, OBJECT_FLAG_WORLD_DIRTY);
+    }
+    ObjectTransformVersion++;
+}
+
+
+void internal_Bench_scene (Scene* scene, Object** objects, const char* name) {
+    u64 elapsed = 0;
+    for (u64 frame = 0; frame < BENCH_FRAMES; ++frame) {
+        internal_Bench_dirty_all(objects);
+
+        u64 start = Bench_now();
+        Scene_update_transforms(scene);
+        elapsed += Bench_now() - start;
+    }
+    Bench_report(name, elapsed, (u64)BENCH_OBJECTS * BENCH_FRAMES);
+}
+
+
+void internal_Bench_moving (Scene* scene, Object** objects, const u64 percent) {
+    u64 moving = (u64)BENCH_OBJECTS * percent / 100;
+    u64 recomputed = 0;
+    char label[64];
+
+    u64 start = Bench_now();
+    for (u64 frame = 0; frame < BENCH_FRAMES; ++frame) {
+        for (u64 i = 0; i < moving; ++i) {
+            Object* object = objects[internal_Bench_random_u64() % BENCH_OBJECTS];
+            vec3 offset = { 0.001f, 0.0f, -0.001f };
+            Object_translate(object, offset);
+        }
+
+        Scene_update_transforms(scene);
+        recomputed += scene->recomputed;
+    }
+    u64 elapsed = Bench_now() - start;
+
+    snprintf(label, sizeof(label), "Scene_update_transforms, %llu%% moving", (unsigned long long)percent);
+    Bench_report(label, elapsed, (u64)BENCH_OBJECTS * BENCH_FRAMES);
+    printf("    %llu nodes recomputed per frame\n", (unsigned long long)(recomputed / BENCH_FRAMES));
+}
+
+
+int main () {
+    Object** objects = (Object**)malloc(sizeof(Object*) * BENCH_OBJECTS);
+    mat4* walked = (mat4*)malloc(sizeof(mat4) * BENCH_OBJECTS);
+    Scene scene;
+
+    Arenas_initialize();
+    Scene_initialize(&scene);
+
+    // Each object's parent is a random earlier object, which gives a few very large subtrees near the roots and a long tail of
+    // small ones, about 12 levels deep. Scales stay near 1 so the matrices don't blow up with depth.
+    for (u64 i = 0; i < BENCH_OBJECTS; ++i) {
+        Object* parent = (i < BENCH_ROOTS) ? NULL : objects[internal_Bench_random_u64() % i];
+        objects[i] = (Object*)internal_Object_alloc(1, sizeof(Object));
+        internal_Object_Initialize(objects[i], parent, 1);
+
+        vec3 position = { internal_Bench_random(), internal_Bench_random(), internal_Bench_random() };
+        vec3 axis = { internal_Bench_random(), internal_Bench_random(), internal_Bench_random() };
+        vec3 scale = { 1.0f + 0.05f * internal_Bench_random(), 1.0f, 1.0f };
+        quaternion rotation;
+        quaternion_from_axis(axis, internal_Bench_random(), rotation);
+        Object_set_position(objects[i], position);
+        Object_set_rotation(objects[i], rotation);
+        Object_set_scale(objects[i], scale);
+
+        if (!parent) {
+            Scene_add(&scene, objects[i]);
+        }
+    }
+
+    printf("World transforms (%llu objects, %llu roots, %lu cores)\n", (unsigned long long)BENCH_OBJECTS, (unsigned long long)BENCH_ROOTS, (unsigned long)Thread_hardware_concurrency());
+
+    u64 start = Bench_now();
+    for (u64 frame = 0; frame < BENCH_FRAMES; ++frame) {
+        for (u64 i = 0; i < BENCH_OBJECTS; ++i) {
+            Object_get_world_space_transform(objects[i], walked[i]);
+        }
+    }
+    Bench_report("Object_get_world_space_transform", Bench_now() - start, (u64)BENCH_OBJECTS * BENCH_FRAMES);
+
+    start = Bench_now();
+    Scene_update_transforms(&scene);
+    Bench_report("Scene, first update with the flatten", Bench_now() - start, (u64)BENCH_OBJECTS);
+
+    internal_Bench_scene(&scene, objects, "Scene_update_transforms, 1 thread");
+
+    Jobs_initialize(0);
+    internal_Bench_scene(&scene, objects, "Scene_update_transforms, job system");
+
+    // Relative to the size of the matrix, since translations far down the hierarchy get large.
+    double maxError = 0.0;
+    for (u64 i = 0; i < BENCH_OBJECTS; ++i) {
+        const GLfloat* world = Scene_get_world_transform(&scene, objects[i]);
+        double largest = 1.0;
+        double error = 0.0;
+        for (u32 j = 0; j < 16; ++j) {
+            largest = (fabs(walked[i][j]) > largest) ? fabs(walked[i][j]) : largest;
+            error = (fabs(world[j] - walked[i][j]) > error) ? fabs(world[j] - walked[i][j]) : error;
+        }
+        maxError = (error / largest > maxError) ? error / largest : maxError;
+    }
+    printf("%llu tops, %llu batches, max relative difference %g\n", (unsigned long long)scene.topCount, (unsigned long long)scene.batchCount, maxError);
+
+    // Nothing has moved since the last update, so this has to recompute nothing.
+    internal_Bench_moving(&scene, objects, 0);
+    bool staticFree = (scene.recomputed == 0);
+    internal_Bench_moving(&scene, objects, 1);
+
+    Jobs_deinitialize();
+    Scene_deinitialize(&scene);
+
+    // All at once, the objects go away with their pools.
+    ObjectPools_deinitialize();
+    Arenas_deinitialize();
+    free(walked);
+    free(objects);
+    return (maxError > 1e-4 || !staticFree) ? 1 : 0;
+}
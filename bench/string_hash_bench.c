@@ -0,0 +1,171 @@
+#define BENCH_IMPLEMENTATION
+#define HASH_TABLE_IMPLEMENTATION
+
+#include "stdio.h"
+#include "string.h"
+
+#include "bench.h"
+#include "engine_core/string.h"
+#include "engine_core/hash_table.h"
+
+// Compares fnvHash64 against wyHash64, and the old byte-at-a-time String_equal against the current one, on the kind of 
+// aliases the engine actually hashes: shader uniform names, asset paths and "Texture(n)" style aliases.
+
+#define BENCH_ALIAS_COUNT 4096
+#define BENCH_ALIAS_SIZE 128
+#define BENCH_ROUNDS 512
+
+static char AliasData[BENCH_ALIAS_COUNT][BENCH_ALIAS_SIZE];
+static String Aliases[BENCH_ALIAS_COUNT];
+static String AliasCopies[BENCH_ALIAS_COUNT];
+
+
+// Previous String_equal, kept here as the baseline.
+bool internal_Bench_String_equal_bytes (const String* left, const String* right) {
+    if (String_length(*left) != String_length(*right)) {
+        return false;
+    }
+
+    const char* l = left->start;
+    const char* r = right->start;
+
+    for (; l < left->end; ++l, ++r) {
+        if ((*l - *r)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+void internal_Bench_fill_uniforms () {
+    static const char* const members[] = { "position", "direction", "color", "attenuation", "view", "projection", "resolution", "time" };
+    static const char* const blocks[] = { "LightData", "FrameData", "u_Lights", "u_Material", "u_Camera" };
+
+    for (u64 i = 0; i < BENCH_ALIAS_COUNT; ++i) {
+        const char* member = members[i % (sizeof(members) / sizeof(*members))];
+        const char* block = blocks[(i / 8) % (sizeof(blocks) / sizeof(*blocks))];
+        switch (i % 3) {
+        case 0: snprintf(AliasData[i], BENCH_ALIAS_SIZE, "u_%s", member); break;
+        case 1: snprintf(AliasData[i], BENCH_ALIAS_SIZE, "%s.%s", block, member); break;
+        default: snprintf(AliasData[i], BENCH_ALIAS_SIZE, "%s[%llu].%s", block, (unsigned long long)(i % 64), member); break;
+        }
+    }
+}
+
+
+void internal_Bench_fill_paths () {
+    static const char* const folders[] = { "assets/textures/", "assets/models/environment/", "assets/shaders/", "assets/textures/characters/hero/" };
+    static const char* const names[] = { "brick_wall", "stone_floor_worn", "metal_plate", "grass", "skybox_cloudy_afternoon" };
+    static const char* const suffixes[] = { "_albedo.png", "_normal.png", ".obj", ".frag", ".vert", "_roughness_metallic.png" };
+
+    for (u64 i = 0; i < BENCH_ALIAS_COUNT; ++i) {
+        snprintf(AliasData[i], BENCH_ALIAS_SIZE, "%s%s_%llu%s", 
+            folders[i % (sizeof(folders) / sizeof(*folders))], 
+            names[(i / 4) % (sizeof(names) / sizeof(*names))], 
+            (unsigned long long)i,
+            suffixes[(i / 3) % (sizeof(suffixes) / sizeof(*suffixes))]
+        );
+    }
+}
+
+
+void internal_Bench_fill_textures () {
+    for (u64 i = 0; i < BENCH_ALIAS_COUNT; ++i) {
+        snprintf(AliasData[i], BENCH_ALIAS_SIZE, "Texture(%llu)", (unsigned long long)i);
+    }
+}
+
+
+void internal_Bench_run (const char* const distribution) {
+    char name[64];
+    u64 operations = (u64)BENCH_ALIAS_COUNT * BENCH_ROUNDS;
+    u64 totalLength = 0;
+
+    for (u64 i = 0; i < BENCH_ALIAS_COUNT; ++i) {
+        Aliases[i] = (String)String_from_ptr(AliasData[i]);
+        String_create_dirty(&Aliases[i], &AliasCopies[i]);
+        totalLength += String_length(Aliases[i]);
+    }
+
+    printf("\n%s (%llu aliases, mean length %.1f)\n", distribution, (unsigned long long)BENCH_ALIAS_COUNT, (double)totalLength / BENCH_ALIAS_COUNT);
+
+    u64 start = Bench_now();
+    for (u64 round = 0; round < BENCH_ROUNDS; ++round) {
+        for (u64 i = 0; i < BENCH_ALIAS_COUNT; ++i) {
+            Bench_consume(fnvHash64(Aliases[i].start, Aliases[i].end));
+        }
+    }
+    snprintf(name, sizeof(name), "  fnvHash64");
+    Bench_report(name, Bench_now() - start, operations);
+
+    start = Bench_now();
+    for (u64 round = 0; round < BENCH_ROUNDS; ++round) {
+        for (u64 i = 0; i < BENCH_ALIAS_COUNT; ++i) {
+            Bench_consume(wyHash64(Aliases[i].start, Aliases[i].end));
+        }
+    }
+    snprintf(name, sizeof(name), "  wyHash64");
+    Bench_report(name, Bench_now() - start, operations);
+
+    // Equal strings are the worst case for both compares, and the common case for a hash table hit.
+    start = Bench_now();
+    for (u64 round = 0; round < BENCH_ROUNDS; ++round) {
+        for (u64 i = 0; i < BENCH_ALIAS_COUNT; ++i) {
+            Bench_consume(internal_Bench_String_equal_bytes(&Aliases[i], &AliasCopies[i]));
+        }
+    }
+    snprintf(name, sizeof(name), "  String_equal (byte loop)");
+    Bench_report(name, Bench_now() - start, operations);
+
+    start = Bench_now();
+    for (u64 round = 0; round < BENCH_ROUNDS; ++round) {
+        for (u64 i = 0; i < BENCH_ALIAS_COUNT; ++i) {
+            Bench_consume(String_equal(Aliases[i], AliasCopies[i]));
+        }
+    }
+    snprintf(name, sizeof(name), "  String_equal");
+    Bench_report(name, Bench_now() - start, operations);
+
+    // End to end: lookups through a HashTable keyed by the same aliases.
+    HashTable table;
+    HashTable_initialize(u64, &table, BENCH_ALIAS_COUNT);
+    for (u64 i = 0; i < BENCH_ALIAS_COUNT; ++i) {
+        HashTable_insert(&table, Aliases[i], &i);
+    }
+
+    start = Bench_now();
+    for (u64 round = 0; round < BENCH_ROUNDS; ++round) {
+        for (u64 i = 0; i < BENCH_ALIAS_COUNT; ++i) {
+            u64* value;
+            HashTable_find_reference(&table, AliasCopies[i], (void**)&value);
+            Bench_consume(*value);
+        }
+    }
+    snprintf(name, sizeof(name), "  HashTable_find_reference");
+    Bench_report(name, Bench_now() - start, operations);
+
+    u64 histogram[8];
+    u64 longest = HashTable_probe_histogram(&table, histogram, 8);
+    printf("  longest probe %llu\n", (unsigned long long)longest);
+
+    HashTable_deinitialize(&table);
+    for (u64 i = 0; i < BENCH_ALIAS_COUNT; ++i) {
+        String_free_dirty(&AliasCopies[i]);
+    }
+}
+
+
+int main () {
+    internal_Bench_fill_uniforms();
+    internal_Bench_run("Uniform names");
+
+    internal_Bench_fill_paths();
+    internal_Bench_run("Asset paths");
+
+    internal_Bench_fill_textures();
+    internal_Bench_run("Texture(n) aliases");
+
+    return 0;
+}
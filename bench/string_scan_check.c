@@ -0,0 +1,239 @@
+#define BENCH_IMPLEMENTATION
+
+#include "stdio.h"
+#include <string.h>     // angle brackets, otherwise this finds engine_core/string.h first.
+
+#include "bench.h"
+#include "engine_core/engine_types.h"
+#include "engine_core/string.h"
+
+// Runs every level of the string scans String_select_scan can pick on the same random buffers and compares FindBufferEnd,
+// String_first, String_last, String_find and String_split_next against plain byte loops. Starts are at every offset into a
+// 64 byte aligned buffer and lengths run past two AVX2 blocks, so the unaligned heads, the aligned block scans and the tails
+// all run, and half the buffers only hold the pattern next to a 16 byte block edge. Exits with 1 if any scan disagrees.
+//
+
+#define CHECK_ITERATIONS 200000
+#define CHECK_MAX_LENGTH 160
+#define CHECK_BUFFER_SIZE 512      // Room for the longest buffer at the largest offset, and the blocks the end scans read past it.
+
+typedef struct CheckResult {
+    const char* name;
+    u64 failed;
+    u64 count;
+} CheckResult;
+
+static u64 RandomState = 0x9E3779B97F4A7C15ull;
+static _Alignas(64) char Buffer[CHECK_BUFFER_SIZE];
+
+
+u32 internal_Check_random (const u32 range) {
+    // xorshift64*, uniform in [0, range).
+    RandomState ^= RandomState >> 12;
+    RandomState ^= RandomState << 25;
+    RandomState ^= RandomState >> 27;
+    return (u32)(((RandomState * 0x2545F4914F6CDD1Dull) >> 32) % range);
+}
+
+
+void internal_Check_fill (char* start, const u32 length, const char pattern) {
+    // Either a few letters, so the pattern turns up often, or letters without the pattern and then the pattern placed on or
+    // next to a block edge.
+    if (internal_Check_random(2)) {
+        for (u32 i = 0; i < length; ++i) {
+            start[i] = (char)('a' + internal_Check_random(4));
+        }
+        return;
+    }
+
+    for (u32 i = 0; i < length; ++i) {
+        start[i] = (char)('e' + internal_Check_random(4));
+    }
+
+    u32 placed = internal_Check_random(3);
+    for (u32 i = 0; i < placed && length; ++i) {
+        i32 position = (i32)(16 * internal_Check_random(length / 16 + 1)) + (i32)internal_Check_random(3) - 1;
+        if (position >= 0 && position < (i32)length) {
+            start[position] = pattern;
+        }
+    }
+}
+
+
+char* internal_Check_first (const char* start, const char* end, const char pattern) {
+    for (; start < end; ++start) {
+        if (*start == pattern) {
+            return (char*)start;
+        }
+    }
+    return NULL;
+}
+
+
+char* internal_Check_last (const char* start, const char* end, const char pattern) {
+    for (const char* c = end; c > start; --c) {
+        if (c[-1] == pattern) {
+            return (char*)c - 1;
+        }
+    }
+    return NULL;
+}
+
+
+char* internal_Check_find (const String* string, const String* pattern) {
+    u64 patternLength = String_length(*pattern);
+
+    if (!patternLength) {
+        return NULL;
+    }
+
+    for (const char* c = string->start; c + patternLength <= string->end; ++c) {
+        if (!memcmp(c, pattern->start, patternLength)) {
+            return (char*)c;
+        }
+    }
+    return NULL;
+}
+
+
+void internal_Check_count (CheckResult* result, const bool ok) {
+    result->failed += !ok;
+    result->count++;
+}
+
+
+bool internal_Check_split (const char* text, const char* delimiter, const char** expected, const u32 expectedCount) {
+    // Split text and compare the tokens against expected.
+    String source = String_from_ptr(text);
+    String separator = String_from_ptr(delimiter);
+    String token;
+    u32 count = 0;
+
+    while (String_split_next(source, separator, token)) {
+        if (count >= expectedCount || String_length(token) != strlen(expected[count])
+            || memcmp(token.start, expected[count], String_length(token))) {
+            return false;
+        }
+        count++;
+    }
+    return count == expectedCount;
+}
+
+
+bool internal_Check_split_cases () {
+    // Delimiters at the start and end, repeated delimiters, a delimiter longer than a character, one that never appears and
+    // an empty one. A delimiter at the end ends the last token, it doesn't start an empty one.
+    const char* edges[] = { "", "a", "", "b" };
+    const char* repeated[] = { "", "a", "", "b" };
+    const char* longer[] = { "key", "value", "", "end" };
+    const char* whole[] = { "a,b,c" };
+    const char* single[] = { "" };
+    bool ok = true;
+
+    ok &= internal_Check_split(",a,,b,", ",", edges, 4);
+    ok &= internal_Check_split("--a----b--", "--", repeated, 4);
+    ok &= internal_Check_split("key => value =>  => end", " => ", longer, 4);
+    ok &= internal_Check_split("a,b,c", ";", whole, 1);
+    ok &= internal_Check_split("a,b,c", "", whole, 1);
+    ok &= internal_Check_split(",", ",", single, 1);
+    ok &= internal_Check_split("", ",", NULL, 0);
+    return ok;
+}
+
+
+bool internal_Check_level () {
+    CheckResult results[] = {
+        { "FindBufferEnd" }, { "String_first" }, { "String_last" }, { "String_find" }, { "String_split_next" },
+        { "String_split_next cases" },
+    };
+    bool passed = true;
+
+    RandomState = 0x9E3779B97F4A7C15ull;
+    for (u32 i = 0; i < CHECK_ITERATIONS; ++i) {
+        u32 offset = internal_Check_random(64);
+        u32 length = internal_Check_random(CHECK_MAX_LENGTH + 1);
+        char pattern = (char)('a' + internal_Check_random(4));
+        char* start = Buffer + offset;
+        char* end = start + length;
+
+        // Garbage around the buffer, including zeros before it that FindBufferEnd has to skip.
+        for (u32 j = 0; j < CHECK_BUFFER_SIZE; ++j) {
+            Buffer[j] = (char)internal_Check_random(3);
+        }
+        internal_Check_fill(start, length, pattern);
+        *end = '\0';
+
+        internal_Check_count(&results[0], FindBufferEnd(start) == end);
+
+        String text = String_from_ptr_size(start, length);
+        char* first = String_first(text, pattern);
+        char* last = String_last(text, pattern);
+        internal_Check_count(&results[1], first == internal_Check_first(start, end, pattern));
+        internal_Check_count(&results[2], last == internal_Check_last(start, end, pattern));
+
+        // A pattern from the text itself half the time, so it is found, and up to a little longer than the text.
+        char patternData[8];
+        u32 patternLength = internal_Check_random(6);
+        if (internal_Check_random(2) && patternLength <= length) {
+            memcpy(patternData, start + internal_Check_random(length - patternLength + 1), patternLength);
+        }
+        else {
+            for (u32 j = 0; j < patternLength; ++j) {
+                patternData[j] = (char)('a' + internal_Check_random(4));
+            }
+        }
+        String needle = String_from_ptr_size(patternData, patternLength);
+        internal_Check_count(&results[3], String_find(text, needle) == internal_Check_find(&text, &needle));
+
+        // Split on the pattern and rebuild the text from the tokens, checking each delimiter is where the plain search finds it.
+        if (patternLength) {
+            String source = text;
+            String token;
+            const char* expected = start;
+            bool ok = true;
+
+            while (String_split_next(source, needle, token)) {
+                u64 restLength = (u64)(end - expected);
+                String rest = String_from_ptr_size(expected, restLength);
+                char* match = internal_Check_find(&rest, &needle);
+
+                ok &= token.start == expected && token.end == (match ? match : end);
+                expected = match ? match + patternLength : end;
+                if (!ok) {
+                    break;
+                }
+            }
+            internal_Check_count(&results[4], ok && expected == end && source.start == end);
+        }
+    }
+
+    internal_Check_count(&results[5], internal_Check_split_cases());
+    internal_Check_count(&results[0], FindBufferEnd(NULL) == NULL);
+
+    for (u32 i = 0; i < sizeof(results) / sizeof(results[0]); ++i) {
+        bool ok = results[i].failed == 0;
+        printf("  %-28s %llu of %llu wrong  %s\n", results[i].name, (unsigned long long)results[i].failed,
+            (unsigned long long)results[i].count, ok ? "ok" : "FAILED");
+        passed &= ok;
+    }
+    return passed;
+}
+
+
+int main () {
+    const char* names[] = { "scalar", "SSE2", "AVX2" };
+    bool passed = true;
+
+    for (u8 level = STRING_SCAN_SCALAR; level <= STRING_SCAN_AVX2; ++level) {
+        u8 selected = String_select_scan(level);
+        if (selected != level) {
+            printf("%s: not supported here, skipped\n", names[level]);
+            continue;
+        }
+
+        printf("%s against byte loops (%d iterations)\n", names[level], CHECK_ITERATIONS);
+        passed &= internal_Check_level();
+    }
+
+    return passed ? 0 : 1;
+}
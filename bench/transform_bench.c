@@ -0,0 +1,171 @@
+#define BENCH_IMPLEMENTATION
+#define LIST_IMPLEMENTATION
+#define HASH_TABLE_IMPLEMENTATION
+
+#include "stdio.h"
+#include "math.h"
+
+#include "bench.h"
+#include "engine_core/engine_types.h"
+#include "engine_core/list.h"
+#include "engine_core/hash_table.h"
+#include "engine/math.h"
+#include "engine/object.h"
+
+// Moves a fraction of BENCH_OBJECTS objects every frame and reads every object's transform, the way a renderer would. Compares
+// rebuilding every matrix every frame, with the translate * rotate * scale multiplies or with mat4_from_trs, against the
+// setters and Object_get_transform, which only rebuild the matrices of objects that moved. Times are per object per frame.
+//
+
+#define BENCH_OBJECTS 100000
+#define BENCH_FRAMES 64
+
+typedef void (*BenchFrame)(Object** objects, const u64 count, const u64 moving, const u64 frame);
+
+static u64 RandomState = 0x9E3779B97F4A7C15ull;
+
+
+float internal_Bench_random () {
+    // xorshift64*, uniform in [-1, 1).
+    RandomState ^= RandomState >> 12;
+    RandomState ^= RandomState << 25;
+    RandomState ^= RandomState >> 27;
+    return (float)((RandomState * 0x2545F4914F6CDD1Dull) >> 40) / (float)(1 << 23) - 1.0f;
+}
+
+
+void internal_Bench_move (Object* object, const u64 frame, vec3 outPosition, quaternion outRotation) {
+    // Where a moving object is on a frame, so every version moves the objects the same way.
+    GLfloat step = 0.001f * (GLfloat)(frame + 1);
+    vec3 offset = { step, 0.0f, -step };
+    vec3_add(object->Local.Translation, offset, outPosition);
+    quaternion_from_axis(V3_UP, step, outRotation);
+}
+
+
+u64 internal_Bench_read (Object** objects, const u64 count) {
+    // Stand in for the renderer: read every transform.
+    u64 sum = 0;
+    for (u64 i = 0; i < count; ++i) {
+        sum += (u64)Object_get_transform(objects[i])[12];
+    }
+    return sum;
+}
+
+
+void internal_Bench_eager_multiply (Object** objects, const u64 count, const u64 moving, const u64 frame) {
+    for (u64 i = 0; i < moving; ++i) {
+        internal_Bench_move(objects[i], frame, objects[i]->Local.Translation, objects[i]->Local.Rotation);
+    }
+
+    // Every matrix, every frame, whether it changed or not.
+    for (u64 i = 0; i < count; ++i) {
+        Object* object = objects[i];
+        mat4 translation, rotation, scale;
+        mat4_translate(object->Local.Translation, translation);
+        mat4_from_quaternion(object->Local.Rotation, rotation);
+        mat4_scale(object->Local.Scale, scale);
+        mat4_multi_multiply(4, scale, rotation, translation, object->Transform);
+    }
+    Bench_consume(internal_Bench_read(objects, count));
+}
+
+
+void internal_Bench_eager_trs (Object** objects, const u64 count, const u64 moving, const u64 frame) {
+    for (u64 i = 0; i < moving; ++i) {
+        internal_Bench_move(objects[i], frame, objects[i]->Local.Translation, objects[i]->Local.Rotation);
+    }
+
+    for (u64 i = 0; i < count; ++i) {
+        Object* object = objects[i];
+        mat4_from_trs(object->Local.Translation, object->Local.Rotation, object->Local.Scale, object->Transform);
+    }
+    Bench_consume(internal_Bench_read(objects, count));
+}
+
+
+void internal_Bench_lazy (Object** objects, const u64 count, const u64 moving, const u64 frame) {
+    for (u64 i = 0; i < moving; ++i) {
+        vec3 position;
+        quaternion rotation;
+        internal_Bench_move(objects[i], frame, position, rotation);
+        Object_set_position(objects[i], position);
+        Object_set_rotation(objects[i], rotation);
+    }
+    Bench_consume(internal_Bench_read(objects, count));
+}
+
+
+void internal_Bench_reset (Object** objects, const u64 count) {
+    RandomState = 0x9E3779B97F4A7C15ull;
+
+    for (u64 i = 0; i < count; ++i) {
+        vec3 position = { 100.0f * internal_Bench_random(), 100.0f * internal_Bench_random(), 100.0f * internal_Bench_random() };
+        vec3 scale = { 1.0f + internal_Bench_random() * 0.5f, 1.0f, 1.0f };
+        vec3 axis = { internal_Bench_random(), internal_Bench_random(), internal_Bench_random() };
+        quaternion rotation;
+        quaternion_from_axis(axis, internal_Bench_random() * 3.14159, rotation);
+
+        Object_set_position(objects[i], position);
+        Object_set_rotation(objects[i], rotation);
+        Object_set_scale(objects[i], scale);
+        Object_get_transform(objects[i]);
+    }
+}
+
+
+void internal_Bench_run (const char* name, BenchFrame function, Object** objects, const u64 percent) {
+    u64 moving = (u64)BENCH_OBJECTS * percent / 100;
+    char label[64];
+
+    internal_Bench_reset(objects, BENCH_OBJECTS);
+
+    u64 start = Bench_now();
+    for (u64 frame = 0; frame < BENCH_FRAMES; ++frame) {
+        function(objects, BENCH_OBJECTS, moving, frame);
+    }
+    u64 elapsed = Bench_now() - start;
+
+    snprintf(label, sizeof(label), "%s, %llu%% moving", name, (unsigned long long)percent);
+    Bench_report(label, elapsed, (u64)BENCH_OBJECTS * BENCH_FRAMES);
+}
+
+
+int main () {
+    static const u64 percents[] = { 0, 1, 10, 100 };
+    Object** objects = (Object**)malloc(sizeof(Object*) * BENCH_OBJECTS);
+
+    for (u64 i = 0; i < BENCH_OBJECTS; ++i) {
+        objects[i] = (Object*)internal_Object_alloc(1, sizeof(Object));
+        internal_Object_Initialize(objects[i], NULL, 1);
+    }
+
+    // The lazy matrices have to come out the same as the ones built by multiplying.
+    internal_Bench_reset(objects, BENCH_OBJECTS);
+    internal_Bench_lazy(objects, BENCH_OBJECTS, BENCH_OBJECTS, 0);
+    GLfloat maxError = 0.0f;
+    for (u64 i = 0; i < BENCH_OBJECTS; ++i) {
+        mat4 lazy;
+        mat4_copy(Object_get_transform(objects[i]), lazy);
+        internal_Bench_eager_multiply(objects + i, 1, 0, 0);
+        for (u32 j = 0; j < 16; ++j) {
+            GLfloat error = fabsf(lazy[j] - objects[i]->Transform[j]);
+            maxError = (error > maxError) ? error : maxError;
+        }
+    }
+    printf("Transform rebuilds (%llu objects, %llu frames, max difference %g)\n", (unsigned long long)BENCH_OBJECTS, (unsigned long long)BENCH_FRAMES, (double)maxError);
+
+    for (u64 i = 0; i < sizeof(percents) / sizeof(percents[0]); ++i) {
+        internal_Bench_run("eager, translate * rotate * scale", internal_Bench_eager_multiply, objects, percents[i]);
+        internal_Bench_run("eager, mat4_from_trs", internal_Bench_eager_trs, objects, percents[i]);
+        internal_Bench_run("lazy, Object_get_transform", internal_Bench_lazy, objects, percents[i]);
+    }
+
+    for (u64 i = 0; i < BENCH_OBJECTS; ++i) {
+        internal_Object_Deinitialize(objects[i]);
+        internal_Object_free(objects[i]);
+    }
+    ObjectPools_deinitialize();
+    free(objects);
+    return 0;
+}
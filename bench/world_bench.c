@@ -0,0 +1,172 @@
+#define BENCH_IMPLEMENTATION
+#define LIST_IMPLEMENTATION
+#define HASH_TABLE_IMPLEMENTATION
+
+#include "stdio.h"
+#include "math.h"
+
+#include "bench.h"
+#include "engine_core/engine_types.h"
+#include "engine_core/list.h"
+#include "engine_core/hash_table.h"
+#include "engine_core/arena.h"
+#include "engine/math.h"
+#include "engine/culling.h"
+#include "engine/object.h"
+#include "engine/world.h"
+
+// The same BENCH_INSTANCES mesh instances as objects laid out like a StaticMesh and as entities in a World. Times reading one
+// field of every instance, then frames that move 1% of them, update their matrices and cull them against a camera, with the
+// objects read the way Object_StaticMesh_cull reads them. Times are per instance per frame. Also checks both keep the same
+// instances.
+//
+
+#define BENCH_INSTANCES 100000
+#define BENCH_FRAMES 64
+
+// StaticMesh without the renderer, so the bench doesn't need mesh.c or a GL context.
+typedef struct BenchMesh {
+    OBJECT_BODY();
+    List meshRenders;
+    List materials;
+    Bounds bounds;
+} BenchMesh;
+
+static u64 RandomState = 0x9E3779B97F4A7C15ull;
+
+
+float internal_Bench_random () {
+    // xorshift64*, uniform in [-1, 1).
+    RandomState ^= RandomState >> 12;
+    RandomState ^= RandomState << 25;
+    RandomState ^= RandomState >> 27;
+    return (float)((RandomState * 0x2545F4914F6CDD1Dull) >> 40) / (float)(1 << 23) - 1.0f;
+}
+
+
+u64 internal_Bench_cull_objects (BenchMesh** meshes, const u64 count, const Frustum* frustum) {
+    ArenaScope scratch = Scratch_begin();
+    const Bounds** bounds = Scratch_push(const Bounds*, count);
+    const GLfloat** transforms = Scratch_push(const GLfloat*, count);
+    u32* visible = Scratch_push(u32, count);
+
+    for (u64 i = 0; i < count; ++i) {
+        bounds[i] = &meshes[i]->bounds;
+        transforms[i] = Object_get_transform(meshes[i]);
+    }
+    u64 visibleCount = Frustum_cull_bounds(frustum, count, bounds, transforms, visible);
+
+    Scratch_end(scratch);
+    return visibleCount;
+}
+
+
+int main () {
+    BenchMesh** meshes = (BenchMesh**)malloc(sizeof(BenchMesh*) * BENCH_INSTANCES);
+    Entity* entities = (Entity*)malloc(sizeof(Entity) * BENCH_INSTANCES);
+    World world;
+
+    Arenas_initialize();
+    World_initialize(&world);
+
+    // A unit cube, placed and turned at random around a camera at the origin.
+    static const GLfloat cube[] = { -0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f };
+    Bounds cubeBounds;
+    Bounds_from_points(cube, 2, &cubeBounds);
+
+    for (u64 i = 0; i < BENCH_INSTANCES; ++i) {
+        vec3 position = { 100.0f * internal_Bench_random(), 100.0f * internal_Bench_random(), 100.0f * internal_Bench_random() };
+        vec3 axis = { internal_Bench_random(), internal_Bench_random(), internal_Bench_random() };
+        quaternion rotation;
+        quaternion_from_axis(axis, internal_Bench_random() * 3.14159, rotation);
+
+        meshes[i] = (BenchMesh*)internal_Object_alloc(1, sizeof(BenchMesh));
+        internal_Object_Initialize(meshes[i], NULL, 1);
+        meshes[i]->bounds = cubeBounds;
+        Object_set_position(meshes[i], position);
+        Object_set_rotation(meshes[i], rotation);
+
+        entities[i] = World_create_entity(&world);
+        *World_add(Bounds, &world, entities[i], COMPONENT_BOUNDS) = cubeBounds;
+        World_add(Transform, &world, entities[i], COMPONENT_TRANSFORM);
+        TRS* local = World_edit_transform(&world, entities[i]);
+        vec3_copy(position, local->Translation);
+        quaternion_copy(rotation, local->Rotation);
+    }
+
+    // The camera's view is the identity, so the projection alone is its view projection.
+    mat4 projection;
+    mat4_projection_perspective(70.0, 16.0 / 9.0, 0.1, 150.0, projection);
+    Frustum frustum;
+    Frustum_from_matrix(projection, &frustum);
+
+    u64 moving = BENCH_INSTANCES / 100;
+    vec3 offset = { 0.01f, 0.0f, -0.01f };
+    printf("Mesh instances (%llu instances, %llu moving a frame, %llu frames)\n", (unsigned long long)BENCH_INSTANCES, (unsigned long long)moving, (unsigned long long)BENCH_FRAMES);
+
+    // What a Tick loop over every instance that only needs its position touches.
+    u64 start = Bench_now();
+    GLfloat sum = 0.0f;
+    for (u64 frame = 0; frame < BENCH_FRAMES; ++frame) {
+        for (u64 i = 0; i < BENCH_INSTANCES; ++i) {
+            sum += meshes[i]->Local.Translation[0];
+        }
+    }
+    Bench_report("Objects, read every position", Bench_now() - start, (u64)BENCH_INSTANCES * BENCH_FRAMES);
+
+    start = Bench_now();
+    for (u64 frame = 0; frame < BENCH_FRAMES; ++frame) {
+        const Transform* transforms = World_components(Transform, &world, COMPONENT_TRANSFORM);
+        for (u64 i = 0; i < World_component_count(&world, COMPONENT_TRANSFORM); ++i) {
+            sum += transforms[i].Local.Translation[0];
+        }
+    }
+    Bench_report("World, read every position", Bench_now() - start, (u64)BENCH_INSTANCES * BENCH_FRAMES);
+    Bench_consume(sum);
+
+    u64 objectsVisible = 0;
+    start = Bench_now();
+    for (u64 frame = 0; frame < BENCH_FRAMES; ++frame) {
+        for (u64 i = 0; i < moving; ++i) {
+            Object_translate(meshes[(frame * moving + i) % BENCH_INSTANCES], offset);
+        }
+        objectsVisible = internal_Bench_cull_objects(meshes, BENCH_INSTANCES, &frustum);
+    }
+    Bench_report("Objects, Object_get_transform and cull", Bench_now() - start, (u64)BENCH_INSTANCES * BENCH_FRAMES);
+
+    u64 entitiesVisible = 0;
+    start = Bench_now();
+    for (u64 frame = 0; frame < BENCH_FRAMES; ++frame) {
+        for (u64 i = 0; i < moving; ++i) {
+            TRS* local = World_edit_transform(&world, entities[(frame * moving + i) % BENCH_INSTANCES]);
+            vec3_add(local->Translation, offset, local->Translation);
+        }
+        World_update_world_matrices(&world);
+
+        ArenaScope scratch = Scratch_begin();
+        List visible;
+        List_initialize_Arena(Entity, &visible, &ScratchArena, 64);
+        World_cull(&world, &frustum, &visible);
+        entitiesVisible = List_count(&visible);
+        Scratch_end(scratch);
+    }
+    Bench_report("World, World_update_world_matrices and World_cull", Bench_now() - start, (u64)BENCH_INSTANCES * BENCH_FRAMES);
+
+    printf("%llu objects visible, %llu entities visible\n", (unsigned long long)objectsVisible, (unsigned long long)entitiesVisible);
+
+    for (u64 i = 0; i < BENCH_INSTANCES; ++i) {
+        World_destroy_entity(&world, entities[i]);
+    }
+    u64 leftover = World_entity_count(&world) + World_component_count(&world, COMPONENT_TRANSFORM) + World_component_count(&world, COMPONENT_BOUNDS);
+
+    World_deinitialize(&world);
+    for (u64 i = 0; i < BENCH_INSTANCES; ++i) {
+        internal_Object_Deinitialize(meshes[i]);
+        internal_Object_free(meshes[i]);
+    }
+    ObjectPools_deinitialize();
+    Arenas_deinitialize();
+    free(entities);
+    free(meshes);
+    return (objectsVisible != entitiesVisible || leftover) ? 1 : 0;
+}
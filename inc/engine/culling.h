@@ -0,0 +1,58 @@
+#pragma once
+
+#include "glad/glad.h"
+
+#include "engine_core/engine_types.h"
+#include "engine/math.h"
+
+// View frustum culling. A Frustum is the 6 planes of a view projection matrix, and Bounds is a box and a sphere around a mesh.
+// The cull functions test many bounds against one frustum at a time, from structure of arrays buffers, 4 per iteration, and write
+// out the indices of the ones that are at least partly inside. Both tests are conservative: something that is visible is never
+// culled, but something just outside a corner of the frustum can be kept.
+//
+// Test spheres first, they only take a dot product per plane. Boxes are tighter for long or flat objects, so it is worth testing
+// the boxes of the spheres that passed.
+//
+
+#define FRUSTUM_LEFT 0
+#define FRUSTUM_RIGHT 1
+#define FRUSTUM_BOTTOM 2
+#define FRUSTUM_TOP 3
+#define FRUSTUM_NEAR 4
+#define FRUSTUM_FAR 5
+
+typedef struct Frustum {
+    vec4 planes[6];         // (a, b, c, d) with a unit normal pointing inside: a * x + b * y + c * z + d >= 0 is on the inside.
+} Frustum;
+
+typedef struct Bounds {
+    vec3 min;               // Axis aligned box.
+    vec3 max;
+    vec3 center;            // Sphere around every point in the box.
+    GLfloat radius;
+} Bounds;
+
+// Bounds that pass every test, for meshes whose extent isn't known.
+extern const Bounds BOUNDS_INFINITE;
+
+// Planes of the frustum viewProjection maps to the clip volume, in the space its input is in. Pass the camera's ViewMatrix to
+// get world space planes.
+void Frustum_from_matrix(const mat4 viewProjection, Frustum* out);
+
+// Bounds of count points packed as x, y, z. Zero sized at the origin when count is 0.
+void Bounds_from_points(const GLfloat* points, const u64 count, Bounds* out);
+
+// Bounds of bounds after transform: the box around the transformed box, and the sphere scaled by the largest axis scale.
+void Bounds_transform(const Bounds* bounds, const mat4 transform, Bounds* out);
+
+// Write the index of every sphere that isn't fully outside a plane to outVisible, in order, and return how many there are.
+// outVisible needs room for count indices.
+u64 Frustum_cull_spheres(const Frustum* frustum, const u64 count, const vec3_soa centers, const GLfloat* radii, u32* outVisible);
+
+// The same for boxes, from their min and max corners.
+u64 Frustum_cull_aabbs(const Frustum* frustum, const u64 count, const vec3_soa mins, const vec3_soa maxs, u32* outVisible);
+
+// Cull count bounds, each under its own transform, or as they are where transforms[i] is NULL. Moves them to world space into 
+// structure of arrays buffers on the ScratchArena, tests the spheres, then the boxes of the spheres that passed. Writes the 
+// index of every visible bounds to outVisible, in order, and returns how many there are. outVisible needs room for count indices.
+u64 Frustum_cull_bounds(const Frustum* frustum, const u64 count, const Bounds* const* bounds, const GLfloat* const* transforms, u32* outVisible);
@@ -146,6 +146,20 @@ typedef GLfloat mat4[16];
 typedef GLfloat mat4x2[8];
 typedef GLfloat mat4x3[12];
 
+// Structure of arrays views for the batch functions. Element i is (x[i], y[i], z[i]). The arrays belong to the caller.
+typedef struct vec3_soa {
+    GLfloat* x;
+    GLfloat* y;
+    GLfloat* z;
+} vec3_soa;
+
+typedef struct quaternion_soa {
+    GLfloat* x;
+    GLfloat* y;
+    GLfloat* z;
+    GLfloat* w;
+} quaternion_soa;
+
 // GLSL TYPE CONSTANTS:
 //
 //
@@ -198,6 +212,17 @@ void quaternion_from_axis(const vec3 axis, const double angle, quaternion out);
 void quaternion_invert(quaternion q);
 void quaternion_multiply(const quaternion left, const quaternion right, quaternion out);
 void mat4_from_quaternion(const quaternion q, mat4 out); // 4x4 matrix from quaternion.
+void mat4_from_trs(const vec3 translation, const quaternion rotation, const vec3 scale, mat4 out); // Scale, then rotate, then translate.
+
+// mat4_multiply, mat4_inverse, mat4_from_quaternion and the batch functions below use the widest of these the processor
+// supports. Engine_initialize makes the choice before starting any worker thread, or else the first call makes it, which isn't
+// safe with several threads. Math_select_kernels overrides it with the widest supported level up to the one given, and returns
+// that level.
+#define MATH_KERNELS_SCALAR 0
+#define MATH_KERNELS_SSE2 1
+#define MATH_KERNELS_AVX2 2
+
+u8 Math_select_kernels(u8 level);
 
 void mat4_multi_multiply (u64 count, ... );
 void mat4_multiply(const mat4 left, const mat4 right, mat4 out); // Multiply two 4x4 matrices.
@@ -217,6 +242,13 @@ void mat4_projection_perspective(const double fov, const double aspect, const do
 void mat4_projection_frustum(const double left, const double right, const double top, const double bottom, const double near, const double far, mat4 out);
 void mat4_projection_orthographic(const double left, const double right, const double top, const double bottom, const double near, const double far, mat4 out);
 
+// Batch versions for transforming many instances a frame. They give the same results as calling the single versions in a loop,
+// but work on 4 or 8 elements at a time. out may be the same arrays as the input. mat4_multiply_batch is the exception: it works
+// one matrix at a time, and is only wider than a loop over mat4_multiply at the AVX2 level.
+void mat4_multiply_batch(const u64 count, const mat4* left, const mat4* right, mat4* out); // out[i] = left[i] * right[i].
+void vec3_transform_points_soa(const mat4 m, const u64 count, const vec3_soa points, const vec3_soa out); // Points by m, w = 1.
+void quaternion_to_mat4_batch(const u64 count, const quaternion_soa q, mat4* out); // mat4_from_quaternion of each q.
+
 
 // internal size of lookup.
 const GLuint size_from_gl_type(const GLenum type);
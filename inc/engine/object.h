@@ -4,17 +4,26 @@
 
 #include "engine_core/engine_types.h"
 #include "engine_core/list.h"
+#include "engine_core/pool.h"
+#include "engine_core/string.h"
 #include "engine/math.h"
 
-// Standard Buffer Size is the maximum size any alias can be.
-#define OBJECT_ALIAS_SIZE 116
-
 // Object function return messages:
 #define ERRORCODE_OBJECT_SUCCESS          0x00
 #define ERRORCODE_OBJECT_MISSING_PARENT   0x01
 #define ERRORCODE_OBJECT_SELF_PARENT      0x02
 #define ERRORCODE_OBJECT_NULL_OBJECT      0x03
 
+// Object types are used to index the per-type pools, so every type must be less than this.
+#define OBJECT_TYPE_COUNT 8
+
+// internal_SceneIndex of an object that isn't in a Scene. See engine/scene.h.
+#define OBJECT_NOT_IN_SCENE 0xffffffff
+
+// Object flags. The low 8 bits of Data.Flags are the type.
+#define OBJECT_FLAG_TRANSFORM_DIRTY 0x00000100      // Local changed since Transform was last built.
+#define OBJECT_FLAG_WORLD_DIRTY 0x00000200          // Transform or Parent changed since the Scene last computed the world matrix.
+
 
 // Type Definitions:
 // 
@@ -22,6 +31,15 @@
 
 // TODO: Implemented "GetComponent" with ObjectType as input. This will be the basis for polymorphic data.
 
+typedef struct TRS {
+    // Position, rotation and scale of an object relative to its parent. Setting any of them through the Object_set functions
+    // only marks the object dirty, the matrix is built from them the next time Object_get_transform reads it.
+    //
+    vec3 Translation;
+    quaternion Rotation;
+    vec3 Scale;
+} TRS;
+
 
 typedef struct Object {
     // Holds basic information that all objects in a scene will have. Instead of using inheritance & polymorphism, which has some 
@@ -29,38 +47,100 @@ typedef struct Object {
     // like moving, rotating, scaling, etc can be done without a class-specific override.
     //
     // The union is used because by default, the c preprocessed will try to pack things into 4 bytes. 
-    //  
+    //
+    // Fields are ordered by how often a frame touches them. Everything Tick, Draw and the transform functions read comes first,
+    // in the first 136 bytes where u32 is 4 bytes, and what only creating, destroying and reparenting use comes after. The alias
+    // isn't stored in the object at all, see Object_set_alias.
+    //
     #define OBJECT_BODY() \
-    char Alias[OBJECT_ALIAS_SIZE];          /* <----- These will be the same for any object.                        */ \
     union {u8 Type;                         /*     _- Only use the lower 8 bits, the first 8 represent type.        */ \
     u32 Flags;} Data;                       /* <--+-- General purpose bit flags. useful for keeping object state.   */ \
-    mat4 Transform;                         /* <----- 4 * 4 matrix, represents the position & rotation.             */ \
-    List Children;                          /* <----- list of child objects.                                        */ \
-    u64 internal_IndexOf;                   /* <----- Index of the object in it's parent's children list.           */ \
-    Object* Parent;                         /* <----- pointer to the parent node. If NULL, assumed to be a root.    */ \
+    Handle Handle;                          /* <----- handle to the object in the pool for it's type.               */ \
     Function_Tick Tick;                     /* <----- function to update the object.                                */ \
     Function_Void_OneParam Draw;            /* <----- function to draw the object.                                  */ \
-    Function_Void_OneParam Destroy          /* <----- function to destroy the object.                               */ \
+    Object* Parent;                         /* <----- pointer to the parent node. If NULL, assumed to be a root.    */ \
+    TRS Local;                              /* <----- position, rotation & scale relative to the parent.            */ \
+    mat4 Transform;                         /* <----- Local as a matrix. Read with Object_get_transform.            */ \
+    u32 internal_SceneIndex;                /* <----- Node of the object in the Scene it was last flattened into.   */ \
+    Function_Void_OneParam Destroy;         /* <----- function to destroy the object.                               */ \
+    Object* FirstChild;                     /* <----- first of the object's children, NULL if it has none.          */ \
+    Object* NextSibling;                    /* <----- next child of the same parent, NULL after the last one.       */ \
+    Object* PreviousSibling                 /* <----- previous child of the same parent, NULL before the first one. */ \
 
     OBJECT_BODY();
 
 } Object;
 
-#define OBJECT_CREATE_BODY(T, parent, type) T* object = (T*)malloc(sizeof(T)); if(!object) { return NULL; } internal_Object_Initialize((void*)object, (void*)parent, type);
+// Loop over the direct children of an object. Creates Object* variable, child. Don't reparent or destroy child inside the loop.
+#define Object_child_iterator(object) Object* child = ((Object*)(object))->FirstChild; child; child = child->NextSibling
+
+// Objects are allocated from a pool for their type. Each pool keeps objects of one type packed together in slabs, and reuses the
+// memory of destroyed objects, so creating and destroying objects doesn't go to the heap once the pool has grown.
+//
+// OBJECT_DESTROY_BODY destroys the object's children and takes it out of its parent's. OBJECT_FREE_BODY returns the object to it's
+// pool, and must be the last thing a Destroy function does with the object.
+//
+// Children are linked through their siblings, so adding, reparenting and removing a child doesn't depend on how many children
+// the parent has. Destroying an object destroys its descendants leaves first, without recursing, so a deep hierarchy can't
+// overflow the call stack.
+#define OBJECT_CREATE_BODY(T, parent, type) T* object = (T*)internal_Object_alloc(type, sizeof(T)); internal_Object_Initialize((void*)object, (void*)parent, type);
 #define OBJECT_DESTROY_BODY(object) internal_Object_Deinitialize((void*)object);
+#define OBJECT_FREE_BODY(object) internal_Object_free((void*)object);
 #define OBJECT_TICK_BODY(object) 
 
 #define Object_IsType(object, Type) ((*((Object*)object)->Type) == Type)
 
+void*   internal_Object_alloc (const u8 type, const u32 size);
+void    internal_Object_free (void* objectPtr);
 u8 internal_Object_Initialize (void* objectPtr, void* parentPtr, const u8 type);
 void    internal_Object_Deinitialize (void* objectPtr);
 void    internal_Object_DestroyDefault (void* objectPtr);
 u8 internal_Object_TickDefault (void* objectPtr, const double deltaTime);
 
+// Handles stay safe to use after the object is destroyed. Resolving the handle of a destroyed object returns NULL.
+#define Object_get_handle(objectPtr) (((Object*)(objectPtr))->Handle)
+#define Object_resolve(T, type, handle) ((T*)Object_from_handle(type, handle))
+void* Object_from_handle (const u8 type, const Handle handle);
+
+// Bumped whenever an object is created with a parent, destroyed or reparented, so a Scene knows to flatten its hierarchy again.
+extern u64 ObjectHierarchyVersion;
+
+// Bumped whenever an object's transform or parent changes, so a Scene can skip its update when nothing has moved.
+extern u64 ObjectTransformVersion;
+
+// Free the memory of every object pool and the alias lists. Every object is invalid afterwards. Called by Engine_terminate.
+void ObjectPools_deinitialize ();
+
+// Local's matrix, rebuilt first if Local changed since it was last read. Use this instead of reading Transform directly.
+const GLfloat* Object_get_transform (void* objectPtr);
+
+// Replace the matrix outright, for transforms that aren't a translation, rotation and scale, like a look at matrix. Local isn't
+// updated to match, so the next change to Local replaces the matrix again.
+void Object_set_transform (void* objectPtr, const mat4 transform);
+
+void Object_set_position (void* objectPtr, const vec3 position);
+void Object_set_rotation (void* objectPtr, const quaternion rotation);
+void Object_set_scale (void* objectPtr, const vec3 scale);
+void Object_translate (void* objectPtr, const vec3 offset);
+void Object_rotate (void* objectPtr, const quaternion rotation);     // Apply rotation after the current rotation.
+
+// Multiplies up every parent's transform on each call. For objects in a Scene, read Scene_get_world_transform instead.
 void Object_get_world_space_transform (void* objectPtr, mat4 out);
 void Object_set_parent (void* objectPtr, void* parentPtr);
+
+// Aliases are kept out of the objects, as StringIds, so every distinct alias is stored once, in the StringId table. Set an
+// alias to find the object by it later. Several objects can share an alias, and an empty or NULL alias removes the object's.
+// Needs StringId_initialize, which Engine_initialize calls.
 void Object_set_alias (void* objectPtr, const char* string);
 
+// The object's alias, or "" if it has none. Stays valid until StringId_deinitialize, the StringId table never moves or frees
+// an alias before then.
+const char* Object_get_alias (void* objectPtr);
+
+// An object with the alias, the one it was given to last if there are several, or NULL if no object has it. Finding the same
+// object every frame is better done once, keeping its Handle.
+void* Object_find_by_alias (const char* alias);
+
 bool Object_flag_compare (u32 data, u32 mask);
 void Object_flag_set (u32* data, u32 mask);
 void Object_flag_unset (u32* data, u32 mask);
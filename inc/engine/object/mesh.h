@@ -3,15 +3,20 @@
 #include "engine_core/string.h"
 #include "engine_core/list.h"
 #include "engine/object.h"
+#include "engine/culling.h"
+#include "engine/scene.h"
+#include "engine/world.h"
 
 //Forward Definitions:
 typedef struct Material Material;
 typedef struct MeshRender MeshRender;
+typedef struct Camera Camera;
 
 typedef struct StaticMesh {
     OBJECT_BODY();
     List meshRenders;
     List materials;
+    Bounds bounds;          // Around every vertex, in the mesh's own space. BOUNDS_INFINITE until a loader sets it.
 } StaticMesh;
 
 
@@ -27,3 +32,19 @@ void Object_StaticMesh_destroy(void* objecti);
 
 void Object_StaticMesh_set_Material(StaticMesh* staticMesh, const u32 subMesh, Material* material);
 void Object_StaticMesh_Draw(void* object);
+
+// Push each mesh in meshes[0, count) that the camera can see onto outVisible, a List of StaticMesh*. Tests the bounds under each
+// mesh's world transform in scene against the camera's ViewMatrix, so call it after the camera has ticked and the scene has
+// updated. Usually outVisible is a List in the FrameArena, so the list costs nothing to build each frame.
+void Object_StaticMesh_cull(const Scene* scene, const Camera* camera, StaticMesh** meshes, const u64 count, List* outVisible);
+
+// Draw every StaticMesh* in visible at its world transform in scene.
+void Object_StaticMesh_draw_visible(const Scene* scene, const List* visible);
+
+// Make an entity in world that draws staticMesh, with the mesh's bounds and an identity Transform. Loading a mesh once and
+// instantiating it many times gives entities that World_update_world_matrices and World_cull go through densely. The mesh has to
+// outlive them, or they stop being drawn.
+Entity Object_StaticMesh_instantiate(World* world, const StaticMesh* staticMesh);
+
+// Draw every Entity in visible with a MeshRef at its WorldMatrix, usually the list World_cull filled.
+void Object_StaticMesh_draw_entities(const World* world, const List* visible);
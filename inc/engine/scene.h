@@ -0,0 +1,84 @@
+#pragma once
+
+#include "glad/glad.h"
+
+#include "engine_core/engine_types.h"
+#include "engine_core/list.h"
+#include "engine/math.h"
+#include "engine/object.h"
+
+// World transforms for every object in a scene. Instead of each object walking its parents for its world matrix, a Scene keeps
+// the whole hierarchy flattened into arrays, parents before children, and computes every world matrix in one pass over them:
+// each one is its parent's, which is already done, times its own local transform. Renderers read the results with
+// Scene_get_world_transform.
+//
+// The arrays are in depth first order, so every subtree is a contiguous range. The pass first does the few nodes whose subtrees
+// are bigger than SCENE_BATCH_SIZE on the calling thread, then splits everything under them into batches of whole subtrees and
+// runs those in parallel on the job system. A batch only reads world matrices from inside itself or from the nodes done first.
+//
+// The arrays are rebuilt when the hierarchy changes, which Scene_update_transforms notices by ObjectHierarchyVersion, so
+// creating, destroying and reparenting objects costs a rebuild on the next update, but moving them doesn't.
+//
+// Only the world matrices that can have changed are recomputed. Changing an object's transform or parent sets its
+// OBJECT_FLAG_WORLD_DIRTY, and the pass recomputes a node when its flag is set or its parent was recomputed in the same pass, so
+// a change reaches the whole subtree under it without walking it at the time of the change. Nodes that weren't recomputed cost
+// a flag check. The change also bumps ObjectTransformVersion, and an update that finds it the same as last time returns without
+// visiting any node, so a scene where nothing moved costs one comparison. recomputed counts the nodes the last update
+// recomputed.
+//
+// Call Scene_update_transforms from the main thread, after anything that moves objects and before anything that draws them.
+//
+
+// Largest number of nodes a job gets. Subtrees bigger than this are split at their root.
+#define SCENE_BATCH_SIZE 1024
+
+#define SCENE_NO_PARENT 0xffffffff
+
+typedef struct SceneBatch {
+    u32 start;              // Range of nodes, [start, end).
+    u32 end;
+    u32 recomputed;         // Nodes in the range the last update recomputed.
+} SceneBatch;
+
+typedef struct Scene {
+    List roots;             // Object*. Every object under these is in the scene.
+
+    // The flattened hierarchy. Node i is objects[i].
+    Object** objects;
+    u32* parents;           // Node of each node's parent, or SCENE_NO_PARENT for roots.
+    mat4* worlds;           // World matrix of each node, as of the last Scene_update_transforms.
+    u8* changed;            // Whether each node was recomputed in the last update. Bytes, not bits, since batches on other
+                            // threads write the nodes next to each other.
+    u32 count;
+    u32 capacity;
+
+    // How the pass is split. tops are done in order first, then batches in parallel.
+    u32* tops;
+    u32 topCount;
+    SceneBatch* batches;
+    u32 batchCount;
+
+    u64 version;            // ObjectHierarchyVersion when the arrays were built.
+    u64 transformVersion;   // ObjectTransformVersion as of the last update.
+    bool rootsChanged;
+    bool rebuilt;           // Nodes moved, so the next pass recomputes all of them.
+
+    u32 recomputed;         // Nodes the last Scene_update_transforms recomputed.
+} Scene;
+
+void Scene_initialize(Scene* scene);
+void Scene_deinitialize(Scene* scene);
+
+// Add an object and everything under it to the scene. root shouldn't have a parent. An object that is given a parent later is
+// only reached through that parent, and drops out of the scene if the parent isn't in it.
+void Scene_add(Scene* scene, void* root);
+
+// Remove a root added with Scene_add. Remove roots before destroying them.
+void Scene_remove(Scene* scene, void* root);
+
+// Compute the world matrix of every object in the scene, rebuilding the arrays first if the hierarchy has changed.
+void Scene_update_transforms(Scene* scene);
+
+// World matrix of object as of the last Scene_update_transforms. For an object that isn't in scene, or a NULL scene, this falls
+// back to the object's local transform, which is only its world matrix if it has no parent.
+const GLfloat* Scene_get_world_transform(const Scene* scene, void* object);
@@ -5,6 +5,8 @@
 #include "engine/shader/shader_compile.h"
 
 #include "engine_core/string.h"
+#include "engine_core/string_id.h"
+#include "engine_core/pool.h"
 
 // Forward declarations:
 typedef struct HashTable HashTable;
@@ -36,16 +38,28 @@ void internal_Shader_create(const GLuint program, const char* alias);
 void Shader_delete (const char* alias);
 void Shader_delete_String (String alias);
 
+// Drop a reference to the Shader. The Shader is deleted once the last reference is released.
+void Shader_release (Handle handle);
+
 void Shader_deinitialize (Shader* shader);
 
+// Look up the Handle of a Shader once, then resolve it whenever the Shader is used. Handles to a deleted Shader resolve to NULL.
+Handle Shader_find (const char* alias);
+Handle Shader_find_String (String alias);
+Handle Shader_find_Id (StringId alias);
+Shader* Shader_resolve (Handle handle);
+
 Shader* Shader_get (const char* alias);
 Shader* Shader_get_String (String alias);
+Shader* Shader_get_Id (StringId alias);
 
 void Shader_set_uniform(const Shader* shader, const char* alias, void* data);
 void Shader_set_uniformBuffer(const Shader* shader, const char* alias, void* data);
 
 void Shader_get_uniform(const Shader* shader, const char* alias, Uniform** outVal);
 void Shader_get_uniformBuffer(const Shader* shader, const char* alias, UniformBuffer** outVal);
+void Shader_get_uniform_Id(const Shader* shader, StringId alias, Uniform** outVal);
+void Shader_get_uniformBuffer_Id(const Shader* shader, StringId alias, UniformBuffer** outVal);
 
 #define Shader_get_uniform_count(shader) (shader->Uniforms->SlotsUsed)
 #define Shader_get_buffer_count(shader) (shader->UniformBuffers->SlotsUsed)
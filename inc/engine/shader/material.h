@@ -2,15 +2,18 @@
 
 #include "stdint.h"
 
+#include "engine_core/pool.h"
+
 // Forward Declarations
 typedef struct HashTable HashTable;
 typedef struct Texture Texture;
 typedef struct Shader Shader;
 
 typedef struct Material {
+    // Resources are held by Handle, resolved once when the Material is created. Binding doesn't look anything up by alias.
     u64         TextureCount;
-    String*     TextureAliases;
-    String      ShaderAlias;
+    Handle*     TextureHandles;
+    Handle      ShaderHandle;
     GLenum      CullFunction;
     GLenum      DepthFunction;
 } Material;
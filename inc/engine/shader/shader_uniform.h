@@ -2,6 +2,8 @@
 
 #include "glad/glad.h"
 
+#include "engine_core/string_id.h"
+
 // Forward declarations:
 typedef struct HashTable HashTable;
 
@@ -50,6 +52,11 @@ typedef struct Uniform {
     void* Data;
 } Uniform;
 
+// Insert a Uniform, UniformStruct or UniformBuffer into a table by value. The inserted copy's Alias points at the table's copy of 
+// the key, so aliases don't need an allocation of their own. If the insert compacts the table's keys, every uniform in the 
+// table has its Alias pointed at the new copy.
+void internal_Uniform_insert(HashTable* table, const String alias, const void* uniform);
+
 Uniform* internal_Uniform_create_shared(const UniformInformation* info, void* sharedBuffer);
 Uniform* internal_Uniform_create(const UniformInformation* info);
 
@@ -78,6 +85,9 @@ void UniformStruct_get_member(UniformStruct* uniformStruct, const char* alias, U
 void UniformStruct_set_member_at(UniformStruct* uniformStruct, const char* alias, u64 i, void* data);
 void UniformStruct_set_member(UniformStruct* uniformStruct, const char* alias, void* data);
 
+void UniformStruct_get_member_Id(UniformStruct* uniformStruct, StringId alias, Uniform** outVal);
+void UniformStruct_set_member_at_Id(UniformStruct* uniformStruct, StringId alias, u64 i, void* data);
+
 //  SHADER UNIFORM BUFFER
 //
 //
@@ -110,8 +120,19 @@ void internal_UniformBuffer_set_Struct_at(UniformBuffer* buffer, const char* ali
 UniformBuffer* UniformBuffer_get_self(const char* alias);
 void UniformBuffer_update_all();
 
+// StringId versions of the lookups above. Get the ids once with StringId_get, these skip hashing the alias every call.
+void internal_UniformBuffer_set_Id(UniformBuffer* buffer, StringId alias, void* data);
+void UniformBuffer_get_Uniform_Id(const UniformBuffer* buffer, StringId alias, Uniform** outVal);
+void UniformBuffer_get_Struct_Id(const UniformBuffer* buffer, StringId alias, UniformStruct** outVal);
+void internal_UniformBuffer_set_Struct_at_Id(UniformBuffer* buffer, StringId alias, StringId memberAlias, u64 i, void* data);
+UniformBuffer* UniformBuffer_get_self_Id(StringId alias);
+
 #define UniformBuffer_set(buffer, alias, Value) (internal_UniformBuffer_set(buffer, alias, (void*)Value))
 #define UniformBuffer_set_Global(bufferAlias, alias, Value) (UniformBuffer_set(UniformBuffer_get_self(bufferAlias), alias, Value))
 #define UniformBuffer_set_Struct_Global(bufferAlias, structAlias, memberAlias, Value) (internal_UniformBuffer_set_Struct(UniformBuffer_get_self(bufferAlias), structAlias, memberAlias, Value))
 #define UniformBuffer_set_Struct_at_Global(bufferAlias, structAlias, memberAlias, index, Value) (internal_UniformBuffer_set_Struct_at(UniformBuffer_get_self(bufferAlias), structAlias, memberAlias, index, Value))
 
+#define UniformBuffer_set_Id(buffer, alias, Value) (internal_UniformBuffer_set_Id(buffer, alias, (void*)Value))
+#define UniformBuffer_set_Global_Id(bufferAlias, alias, Value) (UniformBuffer_set_Id(UniformBuffer_get_self_Id(bufferAlias), alias, Value))
+#define UniformBuffer_set_Struct_at_Global_Id(bufferAlias, structAlias, memberAlias, index, Value) (internal_UniformBuffer_set_Struct_at_Id(UniformBuffer_get_self_Id(bufferAlias), structAlias, memberAlias, index, Value))
+
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "engine_core/string.h"
+#include "engine_core/string_id.h"
+#include "engine_core/pool.h"
 
 typedef struct HashTable Hashtable;
 
@@ -28,12 +30,25 @@ typedef struct TextureDescriptor {
 void    InitTextures ();
 ecode   DereferenceTextures ();
 
-void    Texture_create(const char* alias, const TextureDescriptor descriptor);
+// Returns the Handle of the new Texture, or HANDLE_NULL if it couldn't be loaded. If alias is taken, the Texture gets a numbered
+// alias instead, like "alias(1)".
+Handle  Texture_create(const char* alias, const TextureDescriptor descriptor);
 void    Texture_delete(const char* alias);
 void    Texture_delete_String(String alias);
 
+// Drop a reference to the Texture. The Texture is deleted once the last reference is released.
+void    Texture_release(Handle handle);
+
 void    internal_Texture_extend_alias (const char* alias, String* out);
 void    Internal_Texture_upload (Texture* texture, const TextureDescriptor descriptor, int width, int height, int channels, u32 pathCount, void* data);
 
+// Look up the Handle of a Texture once, then resolve it whenever the Texture is used. Pointers to a Texture stay valid until it is
+// deleted, Handles to a deleted Texture resolve to NULL.
+Handle  Texture_find(const char* alias);
+Handle  Texture_find_String(String alias);
+Handle  Texture_find_Id(StringId alias);
+Texture* Texture_resolve(Handle handle);
+
 bool    Texture_get(const char* alias, Texture** outVal);
 bool    Texture_get_String(String alias, Texture** outVal);
+bool    Texture_get_Id(StringId alias, Texture** outVal);
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "glad/glad.h"
+
+#include "engine_core/engine_types.h"
+#include "engine_core/list.h"
+#include "engine_core/pool.h"
+#include "engine/math.h"
+#include "engine/object.h"
+#include "engine/culling.h"
+
+// Component storage for things there are a lot of, like instances of a mesh. An Object carries its alias, children, function
+// pointers and matrices in one struct, so a loop that only needs one of them still strides over all of them. A World instead
+// keeps each kind of component in its own dense array, and the systems below loop over those arrays start to end.
+//
+// An Entity is a Handle to a small record of where each of its components is. Each ComponentArray is a sparse set: the
+// components are packed at the front of the array with the Entity each belongs to alongside, and removing one moves the last
+// into its place. So component pointers are only good until the next add or remove of that kind of component.
+//
+// Every entity with a Transform also has a WorldMatrix. The two are added and removed together, so they're always at the same
+// index in their arrays and World_update_world_matrices reads one array and writes the other in step.
+//
+// Objects keep working as before, and are still the way to load things. Object_StaticMesh_instantiate makes an entity that draws
+// a loaded StaticMesh, see engine/object/mesh.h.
+//
+
+// Kinds of component. Indexes World.components.
+#define COMPONENT_TRANSFORM 0       // Transform
+#define COMPONENT_WORLD_MATRIX 1    // WorldMatrix, comes with COMPONENT_TRANSFORM.
+#define COMPONENT_MESH 2            // MeshRef
+#define COMPONENT_MATERIAL 3        // MaterialRef
+#define COMPONENT_BOUNDS 4          // Bounds, in the entity's own space.
+#define COMPONENT_TYPE_COUNT 5
+
+// Index in a ComponentArray of a component an entity doesn't have.
+#define COMPONENT_NONE 0xffffffff
+
+// Forward declarations:
+typedef struct Material Material;
+
+typedef Handle Entity;
+
+typedef struct Transform {
+    TRS Local;
+    bool Dirty;             // Local changed since the WorldMatrix was last built. Set by World_edit_transform.
+} Transform;
+
+typedef struct WorldMatrix {
+    mat4 Matrix;
+} WorldMatrix;
+
+typedef struct MeshRef {
+    Handle Mesh;            // StaticMesh whose submeshes are drawn for the entity. Entities of a destroyed mesh aren't drawn.
+} MeshRef;
+
+typedef struct MaterialRef {
+    Material* Material;     // Drawn with this instead of the mesh's own materials, or NULL to use those.
+} MaterialRef;
+
+typedef struct ComponentArray {
+    u8* data;               // count components of itemSize bytes, packed.
+    Entity* entities;       // Entity each component belongs to.
+    u32 itemSize;
+    u32 count;
+    u32 capacity;
+} ComponentArray;
+
+typedef struct EntityRecord {
+    u32 components[COMPONENT_TYPE_COUNT];   // Index of each component in its array, or COMPONENT_NONE.
+} EntityRecord;
+
+typedef struct World {
+    Pool entities;          // EntityRecord of every entity.
+    ComponentArray components[COMPONENT_TYPE_COUNT];
+} World;
+
+void World_initialize(World* world);
+void World_deinitialize(World* world);
+
+Entity World_create_entity(World* world);
+
+// Remove every component of the entity and free it. Stale entities are ignored.
+void World_destroy_entity(World* world, const Entity entity);
+
+#define World_entity_count(world) Pool_count(&(world)->entities)
+
+// Add a component and return it for the caller to fill in, or return the one the entity already has. A new Transform starts
+// at the identity and dirty, which also adds its WorldMatrix. Returns NULL for a stale entity.
+void* World_add_component(World* world, const Entity entity, const u8 type);
+void World_remove_component(World* world, const Entity entity, const u8 type);
+
+// The entity's component, or NULL if it doesn't have one.
+void* World_get_component(const World* world, const Entity entity, const u8 type);
+
+#define World_add(T, world, entity, type) ((T*)World_add_component(world, entity, type))
+#define World_get(T, world, entity, type) ((T*)World_get_component(world, entity, type))
+
+// Components of one kind, and the entity of each, for systems to loop over. Indices are in [0, World_component_count).
+#define World_component_count(world, type) ((world)->components[type].count)
+#define World_components(T, world, type) ((T*)(world)->components[type].data)
+#define World_component_entity(world, type, i) ((world)->components[type].entities[i])
+
+// Local transform of the entity, marked dirty so the next World_update_world_matrices rebuilds its WorldMatrix. NULL if it has
+// no Transform.
+TRS* World_edit_transform(World* world, const Entity entity);
+
+// Systems:
+
+// Rebuild the WorldMatrix of every dirty Transform. Entities have no parents here, a WorldMatrix is its Transform as a matrix.
+// Returns how many were rebuilt.
+u64 World_update_world_matrices(World* world);
+
+// Push every entity with Bounds whose bounds under its WorldMatrix are at least partly inside frustum onto outVisible, a List of
+// Entity. Entities with Bounds but no Transform are tested in their own space. Call after World_update_world_matrices.
+void World_cull(const World* world, const Frustum* frustum, List* outVisible);
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "engine_core/engine_types.h"
+
+// Linear allocators. An Arena hands out memory by moving a pointer forward through a block, and frees everything at once when it
+// is reset or rewound. Blocks are kept when an Arena is reset, so once it has grown to fit a frame's worth of allocations, it
+// never goes back to the heap.
+//
+// Two engine wide arenas are set up by Engine_initialize:
+//  - FrameArena is reset at the start of every Engine_execute_tick. Use it for anything that only has to live until the end of
+//    the current frame.
+//  - ScratchArena is for temporary allocations inside a single function. Open a scope with Scratch_begin, and everything
+//    allocated since is freed by the matching Scratch_end. Scopes nest, and must be closed in the reverse order they were opened.
+//
+
+#ifndef ENGINE_FRAME_ARENA_SIZE
+#define ENGINE_FRAME_ARENA_SIZE (1 << 20)
+#endif
+
+#ifndef ENGINE_SCRATCH_ARENA_SIZE
+#define ENGINE_SCRATCH_ARENA_SIZE (1 << 20)
+#endif
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    u64 capacity;           // Bytes of data following the header.
+} ArenaBlock;
+
+typedef struct Arena {
+    ArenaBlock* first;
+    ArenaBlock* current;
+    u8* position;           // Next free byte in the current block.
+    u8* end;                // End of the current block.
+    u64 blockSize;          // Size new blocks are created with, unless an allocation needs more.
+    u64 reserved;           // Total bytes held in blocks.
+} Arena;
+
+// Everything allocated from arena after Arena_scope_begin is freed by Arena_scope_end.
+typedef struct ArenaScope {
+    Arena* arena;
+    ArenaBlock* block;
+    u8* position;
+} ArenaScope;
+
+void Arena_initialize(Arena* arena, const u64 blockSize);
+void Arena_deinitialize(Arena* arena);
+
+// Free everything allocated from the Arena. Blocks are kept for reuse.
+void Arena_reset(Arena* arena);
+
+void* Arena_alloc(Arena* arena, const u64 size, const u64 alignment);
+void* Arena_alloc_zero(Arena* arena, const u64 size, const u64 alignment);
+
+#define Arena_push(T, arena, count) ((T*)Arena_alloc(arena, sizeof(T) * (u64)(count), _Alignof(T)))
+#define Arena_push_zero(T, arena, count) ((T*)Arena_alloc_zero(arena, sizeof(T) * (u64)(count), _Alignof(T)))
+
+ArenaScope Arena_scope_begin(Arena* arena);
+void Arena_scope_end(ArenaScope scope);
+
+// Bytes allocated from the Arena since it was last reset. Counts the unused tail of any block that was skipped over.
+u64 Arena_bytes_used(const Arena* arena);
+
+// Engine wide arenas.
+//
+
+extern Arena FrameArena;
+extern Arena ScratchArena;
+
+void Arenas_initialize();
+void Arenas_deinitialize();
+
+// Called by Engine_execute_tick.
+void Arenas_reset_frame();
+
+#define Frame_push(T, count) Arena_push(T, &FrameArena, count)
+
+#define Scratch_begin() Arena_scope_begin(&ScratchArena)
+#define Scratch_end(scope) Arena_scope_end(scope)
+#define Scratch_push(T, count) Arena_push(T, &ScratchArena, count)
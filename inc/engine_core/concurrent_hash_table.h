@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdatomic.h>
+
+#include "engine_core/engine_types.h"
+#include "engine_core/string.h"
+#include "engine_core/vector.h"
+#include "engine_core/thread.h"
+
+// Hash table for read-mostly data shared between threads, like asset aliases that worker threads resolve while the main thread
+// keeps adding new ones.
+//
+// Readers never lock or write to shared memory. The table is an open addressing table with linear probing, held in a snapshot
+// that readers load with a single atomic read. Writers take a lock, and only ever change a snapshot in ways a reader can't
+// observe half done:
+//  - An insert fills an empty slot, and publishes it by storing the slot's hash last.
+//  - A remove marks the slot as a tombstone. Its key and value are left alone, and the slot isn't reused until the next resize.
+//  - Overwriting a key inserts the new value in another slot before the old one is marked as a tombstone.
+//  - A resize builds a new snapshot and swaps it in. The old snapshot is kept, since readers may still be probing it.
+//
+// Memory a reader might still be looking at, old snapshots and the keys of removed items, is only freed by
+// ConcurrentHashTable_reclaim. Call it at a point where no thread is inside a find, like the end of a frame once the worker
+// threads are done.
+//
+
+// Max load, counting tombstones, before the table is rebuilt. As a fraction of 256.
+#define CONCURRENT_HASH_TABLE_MAX_LOAD 192
+
+typedef struct ConcurrentHashTableSnapshot {
+    u64 capacity;           // Power of 2.
+    _Atomic(u64)* hashes;   // Hash of the key in each slot, or one of the reserved empty / tombstone values.
+    String* keys;
+    u8* values;
+} ConcurrentHashTableSnapshot;
+
+typedef struct ConcurrentHashTable {
+    _Atomic(ConcurrentHashTableSnapshot*) current;
+    _Atomic(u64) count;     // Number of items.
+    u64 itemSize;
+    u64 used;               // Slots in the current snapshot that are not empty, including tombstones. Only used by writers.
+    Mutex writeLock;
+    Vector retiredSnapshots;    // Snapshots replaced by a resize, waiting for ConcurrentHashTable_reclaim.
+    Vector retiredKeys;         // Keys of removed items, waiting for ConcurrentHashTable_reclaim.
+} ConcurrentHashTable;
+
+#define ConcurrentHashTable_initialize(T, table, capacity) internal_ConcurrentHashTable_initialize(table, sizeof(T), (u64)capacity)
+void internal_ConcurrentHashTable_initialize(ConcurrentHashTable* table, const u64 itemSize, const u64 capacity);
+
+// Frees everything. No other thread may be using the table.
+void ConcurrentHashTable_deinitialize(ConcurrentHashTable* table);
+
+// Insert a new value, or overwrite an existing one. Safe to call from any thread, writers are serialized by a lock.
+void ConcurrentHashTable_insert(ConcurrentHashTable* table, const String key, const void* value);
+void ConcurrentHashTable_remove(ConcurrentHashTable* table, const String key);
+
+// Copy the value stored under key to out. Lock free, safe to call from any thread at any time.
+#define ConcurrentHashTable_find(table, key, out) (internal_ConcurrentHashTable_find(table, key, (void*)(&out)))
+bool internal_ConcurrentHashTable_find(ConcurrentHashTable* table, const String key, void* out);
+
+// Free old snapshots and removed keys. No thread may be inside ConcurrentHashTable_find while this runs.
+void ConcurrentHashTable_reclaim(ConcurrentHashTable* table);
+
+#define ConcurrentHashTable_count(table) atomic_load_explicit(&(table)->count, memory_order_relaxed)
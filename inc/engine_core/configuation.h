@@ -5,3 +5,46 @@
 
 // Prefer to use stdint.h and stdbool.h over engine's definitions.  
 //#define ENGINE_USE_STDDEF
+
+// Count every heap allocation the engine makes, by subsystem. See engine_core/memory.h.
+#if defined(ENGINE_DEBUG) && !defined(ENGINE_NO_ALLOCATION_TRACKING)
+#define ENGINE_TRACK_ALLOCATIONS
+#endif
+
+// Assert when a frame allocates from the heap once the first ENGINE_ALLOCATION_WARMUP_FRAMES frames are over.
+// Needs ENGINE_TRACK_ALLOCATIONS.
+//#define ENGINE_ASSERT_FRAME_ALLOCATIONS
+#define ENGINE_ALLOCATION_WARMUP_FRAMES 120
+
+// Use SSE2 intrinsics in engine_core. Every x86-64 processor has SSE2, so this is on whenever the compiler targets it.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_USE_SSE2
+#endif
+
+// Let engine_core pick AVX2 code at runtime when the processor has it. Needs a compiler that can target AVX2 per function.
+#if defined(ENGINE_USE_SSE2) && (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define ENGINE_USE_AVX2_DISPATCH
+#endif
+
+#ifdef ENGINE_USE_AVX2_DISPATCH
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Whether the processor running the engine has AVX2, for the code that picks its kernels at runtime.
+static inline _Bool Engine_cpu_has_avx2 () {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    // AVX2 needs both the instructions and an OS that saves the ymm registers.
+    int info[4];
+    __cpuid(info, 1);
+    if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)) || (_xgetbv(0) & 6) != 6) {
+        return 0;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#endif
+}
+#endif
@@ -58,6 +58,7 @@ typedef void	(*Function_Void_OneParam)		(void*);
 typedef void	(*Function_Void_TwoParam)		(void*, void*);
 typedef void	(*Function_Void_ThreeParam)		(void*, void*, void*);
 typedef void	(*Function_Void_FourParam)		(void*, void*, void*, void*);
+typedef void	(*Function_Void_Range)			(void*, const u64, const u64);
 
 // Similar to assert(value) function. Forces the engine to exit with an error code. 
 // See errno.h for generic codes, and engine_error.h for engine specific errors.
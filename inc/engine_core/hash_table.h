@@ -5,21 +5,51 @@
 // #include "hash_table.h"
 // 
 // There are internal functions not defined in this header. you may link to them externally.
-// See: fnvHash64, and FindBufferEnd.
+// See: fnvHash64, and FindBufferEnd. Keys are hashed with String_hash.
 //
 
 #pragma once
 
 #include "engine_core/engine_types.h"
 #include "engine_core/string.h"
+#include "engine_core/arena.h"
+
+// Open addressing table using Robin Hood linear probing. Every slot keeps the full hash of its key, which gives how far it is from
+// the slot its key hashed to. Inserts keep each run of colliding keys ordered by that distance, and removal shifts the run back 
+// instead of leaving a tombstone. The table grows once it is HASH_TABLE_MAX_LOAD full so probe lengths stay short.
+//
+// Keys are only compared when their hashes match, and resizing reuses the stored hashes, so neither scales with key length.
+//
+// Keys are copied into an Arena owned by the table, so inserting a key doesn't call malloc once the arena has room, and every 
+// key is freed at once by HashTable_deinitialize. Copies are null terminated. The bytes of a removed key are not reused in 
+// place. Instead, once removed keys take up more of the arena than live ones, inserting a new key copies the live keys into a 
+// fresh arena and frees the old one. That bumps keyCompactions: anything holding a pointer to a key has to look it up again 
+// when keyCompactions changes. Removing a key never moves the others, and a table that never removes keys never compacts.
+
+// Max load before the table grows, as a fraction of 256.
+#define HASH_TABLE_MAX_LOAD 224
+
+// Bytes of key storage reserved per slot of the initial capacity, and the limits on the size of each block of key storage.
+#define HASH_TABLE_KEY_BYTES_PER_SLOT 16
+#define HASH_TABLE_KEY_BLOCK_MIN 256
+#define HASH_TABLE_KEY_BLOCK_MAX 0x10000
 
 typedef struct HashTable {
     u64 capacity;
     u64 itemSize;
     u64 slotsUsed;
-    u64* activeIndicies;
+    u64* activeIndicies;    // Dense array of occupied slots, in no particular order.
+    u64* denseIndicies;     // For each occupied slot, the index of that slot in activeIndicies.
+    u64* hashes;            // For each occupied slot, the full hash of its key.
+    u32* ids;               // For each occupied slot, the StringId its key was looked up by, or 0 if it never has been.
+    u64* idSlots;           // Cache of StringId to slot. Checked against ids before use, so stale entries are harmless.
+    u64 idSlotCount;
     String* keys;
     u8* values;
+    Arena keyArena;         // Storage for the keys. Set up by the first insert.
+    u64 keyBytes;           // Bytes of keyArena held by keys in the table, terminators included.
+    u64 removedKeyBytes;    // Bytes of keyArena held by keys removed since the last compaction.
+    u32 keyCompactions;     // Number of times the keys have been moved to a new arena.
 } HashTable;
 
 #define HashTable_create(T, capacity) internal_HashTable_create(sizeof(T), (u64)capacity);
@@ -40,18 +70,90 @@ void HashTable_resize(HashTable* table, const u64 capacity);
 #define HashTable_find(table, key, out) (internal_HashTable_find(table, key, (void*)(&out)))
 bool internal_HashTable_find(const HashTable* table, const String key, void* out);
 
-// Get the value of what's stored in the HashTable by reference. These values should be only used temporarily, as the pointer will change if the table is reallocated.
+// Get the value of what's stored in the HashTable by reference. These values should be only used temporarily, as the pointer will change if the table is reallocated,
+// or if any other key is inserted or removed.
 bool HashTable_find_reference(const HashTable* table, const String key, void** outVal);
 
+// Same as HashTable_find_reference, but remembers which slot the key was found in under id, so the next lookup with the same id 
+// is an array index. id must be a StringId for key (see engine_core/string_id.h). The key is only used if the cached slot is stale.
+bool HashTable_find_reference_Id(HashTable* table, const u32 id, const String key, void** outVal);
+
+// Count how many keys sit at each probe length. histogram[i] is the number of keys found i slots after the slot they hashed to,
+// the last bucket also counts every key further away than that. Returns the longest probe length in the table.
+u64 HashTable_probe_histogram(const HashTable* table, u64* histogram, const u64 bucketCount);
+
+// Removing a key moves the last item in the array into its place, so do not remove items while iterating forwards.
+
 #define HashTable_array_iterator(table) u64 i = 0; i < (table)->slotsUsed; i++
 #define HashTable_array_at(T, table, i) (T*)(&(table)->values[(table)->activeIndicies[i] * ((table)->itemSize)])
 #define HashTable_array_key_at(table, i) (&(table)->keys[(table)->activeIndicies[i]])
 
+// Slot level operations, used by typed tables. Each returns false if the key isn't valid or isn't in the table.
+// insert_slot adds the key if it is new and leaves its value for the caller to write.
+bool internal_HashTable_lookup_slot(const HashTable* table, const String key, u64* outSlot);
+bool internal_HashTable_lookup_slot_Id(HashTable* table, const u32 id, const String key, u64* outSlot);
+bool internal_HashTable_insert_slot(HashTable* table, const String key, u64* outSlot);
+
+// Typed tables:
+//
+// DECLARE_HASHTABLE(Name, T) declares a table of T called Name. Its functions read and write values as T, so the compiler knows 
+// the size of every copy instead of going through memcpy with table->itemSize. The table inside is a normal HashTable, so 
+// &map->table can still be passed to any HashTable function.
+//
+// DECLARE_HASHTABLE(TextureMap, Texture)
+// TextureMap_insert(&textures, alias, texture);
+// Texture* found = TextureMap_find_reference(&textures, alias);
+//
+
+#define DECLARE_HASHTABLE(Name, T)\
+typedef struct Name { HashTable table; } Name;\
+\
+static inline void Name##_initialize (Name* map, const u64 capacity) {\
+    internal_HashTable_initialize(&map->table, sizeof(T), capacity);\
+}\
+static inline void Name##_deinitialize (Name* map) {\
+    HashTable_deinitialize(&map->table);\
+}\
+static inline void Name##_insert (Name* map, const String key, T value) {\
+    u64 slot;\
+    if (internal_HashTable_insert_slot(&map->table, key, &slot)) {\
+        ((T*)map->table.values)[slot] = value;\
+    }\
+}\
+static inline void Name##_remove (Name* map, const String key) {\
+    HashTable_remove(&map->table, key);\
+}\
+static inline bool Name##_find (const Name* map, const String key, T* out) {\
+    u64 slot;\
+    if (!internal_HashTable_lookup_slot(&map->table, key, &slot)) {\
+        return false;\
+    }\
+    *out = ((T*)map->table.values)[slot];\
+    return true;\
+}\
+static inline T* Name##_find_reference (const Name* map, const String key) {\
+    u64 slot;\
+    return internal_HashTable_lookup_slot(&map->table, key, &slot) ? &((T*)map->table.values)[slot] : NULL;\
+}\
+static inline T* Name##_find_reference_Id (Name* map, const u32 id, const String key) {\
+    u64 slot;\
+    return internal_HashTable_lookup_slot_Id(&map->table, id, key, &slot) ? &((T*)map->table.values)[slot] : NULL;\
+}\
+static inline u64 Name##_count (const Name* map) {\
+    return map->table.slotsUsed;\
+}\
+static inline T* Name##_array_at (const Name* map, const u64 i) {\
+    return &((T*)map->table.values)[map->table.activeIndicies[i]];\
+}
+
 //#define HASH_TABLE_IMPLEMENTATION
 #ifdef HASH_TABLE_IMPLEMENTATION
 
 #include "stdlib.h"
-#include "string.h"
+#include "errno.h"
+#include <string.h>     // angle brackets, otherwise this finds engine_core/string.h first.
+
+#include "engine_core/memory.h"
 
 // Internal Functions
 // 
@@ -59,6 +161,9 @@ bool HashTable_find_reference(const HashTable* table, const String key, void** o
 
 #define Pow2Ceiling(T, num) ((T)internal_Pow2Ceiling(sizeof(T), num))
 
+// Distance of an occupied slot from the slot its key hashed to.
+#define internal_HashTable_probe_length(table, slot) (((slot) - ((table)->hashes[slot] & ((table)->capacity - 1))) & ((table)->capacity - 1))
+
 u64 fnvHash64 (const char* buffer, const char* const bufferEnd) {
     // implementation of the fnv64 hashing function, created by Glenn Fowler, Landon Curt Noll,
     // and Kiem-Phong Vo. I used fixed-width integers here for maximum portability.
@@ -79,20 +184,6 @@ u64 fnvHash64 (const char* buffer, const char* const bufferEnd) {
 }
 
 
-char* FindBufferEnd (const char* buffer) {
-    // Find the end of a buffer from a given c-string. 
-
-    char* bufferEnd = (char*)buffer;
-
-    // Assume the key is a c_string, iterate through to find the null terminator.
-    for (u16 i = 0; i < 0xffff; ++i, ++bufferEnd) {
-        if (*bufferEnd == '\0') {
-            return bufferEnd;
-        }
-    }
-    return NULL;
-}
-
 u64 internal_Pow2Ceiling (u64 size, u64 num) {
     /* This function returns the next nearest power of 2 from the input number. */
 
@@ -109,11 +200,11 @@ u64 internal_Pow2Ceiling (u64 size, u64 num) {
 
 
 HashTable* internal_HashTable_create (u64 itemSize, u64 capacity) {
-    HashTable* table = (HashTable*)malloc(sizeof(HashTable));
+    HashTable* table = (HashTable*)Engine_malloc(sizeof(HashTable), MEMORY_TAG_HASH_TABLE);
     internal_HashTable_initialize(table, itemSize, capacity);
     
     if (!table->activeIndicies) {
-        free(table);
+        Engine_free(table);
         table = NULL;
     }
 
@@ -125,186 +216,327 @@ void internal_HashTable_initialize (HashTable* table, u64 itemSize, u64 capacity
 
     if (!table) goto TableMallocFailure;
 
-    table->keys = (String*)calloc(Capacity, sizeof(String));
+    table->activeIndicies = NULL;
+
+    table->keys = (String*)Engine_calloc(Capacity, sizeof(String), MEMORY_TAG_HASH_TABLE);
     if (!table->keys) goto TableKeyArrayMallocFalure;
 
-    table->values = calloc(Capacity, itemSize);
+    table->values = Engine_calloc(Capacity, itemSize, MEMORY_TAG_HASH_TABLE);
     if (!table->values) goto TableValueArrayMallocFailure;
 
-    table->activeIndicies = (u64*)calloc(Capacity, 8);
+    table->hashes = (u64*)Engine_calloc(Capacity, sizeof(u64), MEMORY_TAG_HASH_TABLE);
+    if (!table->hashes) goto TableHashesFalure;
+
+    table->ids = (u32*)Engine_calloc(Capacity, sizeof(u32), MEMORY_TAG_HASH_TABLE);
+    if (!table->ids) goto TableIdsFalure;
+
+    table->denseIndicies = (u64*)Engine_calloc(Capacity, sizeof(u64), MEMORY_TAG_HASH_TABLE);
+    if (!table->denseIndicies) goto TableDenseIndiciesFalure;
+
+    table->activeIndicies = (u64*)Engine_calloc(Capacity, sizeof(u64), MEMORY_TAG_HASH_TABLE);
     if (!table->activeIndicies) goto TableActiveIndiciesFalure;
 
     table->capacity = Capacity;
     table->itemSize = itemSize;
     table->slotsUsed = 0;
+    table->idSlots = NULL;
+    table->idSlotCount = 0;
+
+    u64 keyBlockSize = Capacity * HASH_TABLE_KEY_BYTES_PER_SLOT;
+    keyBlockSize = (keyBlockSize < HASH_TABLE_KEY_BLOCK_MIN) ? HASH_TABLE_KEY_BLOCK_MIN : keyBlockSize;
+    keyBlockSize = (keyBlockSize > HASH_TABLE_KEY_BLOCK_MAX) ? HASH_TABLE_KEY_BLOCK_MAX : keyBlockSize;
+    memset(&table->keyArena, 0, sizeof(Arena));
+    table->keyArena.blockSize = keyBlockSize;
+    table->keyBytes = 0;
+    table->removedKeyBytes = 0;
+    table->keyCompactions = 0;
     return;
 
 TableActiveIndiciesFalure:
-    free(table->values);
+    Engine_free(table->denseIndicies);
+
+TableDenseIndiciesFalure:
+    Engine_free(table->ids);
+
+TableIdsFalure:
+    Engine_free(table->hashes);
+
+TableHashesFalure:
+    Engine_free(table->values);
 
 TableValueArrayMallocFailure:
-    free(table->keys);
+    Engine_free(table->keys);
 
 TableKeyArrayMallocFalure:
-    free(table);
+    Engine_free(table);
 
 TableMallocFailure:
     return;
 }
 
+
+u64 internal_HashTable_capacity_for (u64 count) {
+    // Smallest capacity which can store count keys without going over the max load.
+    return (count * 256) / HASH_TABLE_MAX_LOAD + 1;
+}
+
+
+void internal_HashTable_move_slot (HashTable* table, const u64 from, const u64 to) {
+    // Move the key and value in one slot to another, keeping the dense array pointing at it.
+
+    memcpy(&table->values[to * table->itemSize], &table->values[from * table->itemSize], table->itemSize);
+    table->keys[to] = table->keys[from];
+    table->hashes[to] = table->hashes[from];
+    table->ids[to] = table->ids[from];
+    table->denseIndicies[to] = table->denseIndicies[from];
+    table->activeIndicies[table->denseIndicies[to]] = to;
+
+    if (table->ids[to] && table->ids[to] < table->idSlotCount) {
+        table->idSlots[table->ids[to]] = to;
+    }
+}
+
+
+u64 internal_HashTable_place (HashTable* table, const u64 hash, const String key, const void* value, const u64 denseIndex, const u32 id) {
+    // Place a key that is not already in the table. The key is stored as is, so it must already be owned by the table.
+    // Returns the slot the key ended up in. If value is NULL, the caller writes the value.
+    //
+    // Keys in a run are kept in order of the slot they hashed to. Find the first key that is closer to its own slot than the 
+    // new key would be, then shift that key and everything after it up to the next free slot forward by one.
+
+    u64 mask = table->capacity - 1;
+    u64 slot = hash & mask;
+    u64 probeLength = 0;
+
+    while (table->keys[slot].start && internal_HashTable_probe_length(table, slot) >= probeLength) {
+        slot = (slot + 1) & mask;
+        probeLength++;
+    }
+
+    u64 freeSlot = slot;
+    while (table->keys[freeSlot].start) {
+        freeSlot = (freeSlot + 1) & mask;
+    }
+
+    while (freeSlot != slot) {
+        u64 previous = (freeSlot - 1) & mask;
+        internal_HashTable_move_slot(table, previous, freeSlot);
+        freeSlot = previous;
+    }
+
+    if (value) {
+        memcpy(&table->values[slot * table->itemSize], value, table->itemSize);
+    }
+    table->keys[slot] = key;
+    table->hashes[slot] = hash;
+    table->ids[slot] = id;
+    table->denseIndicies[slot] = denseIndex;
+    table->activeIndicies[denseIndex] = slot;
+
+    if (id && id < table->idSlotCount) {
+        table->idSlots[id] = slot;
+    }
+    return slot;
+}
+
+
+bool internal_HashTable_find_slot (const HashTable* table, const u64 hash, const String key, u64* outSlot) {
+    // Find the slot a key is stored in. A key can't be past a slot that is closer to its own hashed slot than the key would be,
+    // so the search can stop there instead of at the next empty slot.
+
+    u64 mask = table->capacity - 1;
+    u64 slot = hash & mask;
+
+    for (u64 probeLength = 0; probeLength < table->capacity; ++probeLength, slot = (slot + 1) & mask) {
+        if (!table->keys[slot].start || internal_HashTable_probe_length(table, slot) < probeLength) {
+            return false;
+        }
+
+        if (table->hashes[slot] == hash && String_equal(key, table->keys[slot])) {
+            *outSlot = slot;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void internal_HashTable_compact_keys (HashTable* table) {
+    // Copy every live key into a new arena, in the order of the dense array, and free the old one with the removed keys in it.
+    Arena compacted;
+    Arena_initialize(&compacted, table->keyArena.blockSize);
+
+    for (HashTable_array_iterator(table)) {
+        String* key = &table->keys[table->activeIndicies[i]];
+        String old = *key;
+        String_create_Arena(&compacted, &old, key);
+    }
+
+    Arena_deinitialize(&table->keyArena);
+    table->keyArena = compacted;
+    table->removedKeyBytes = 0;
+    table->keyCompactions++;
+}
+
 // Public Functions:
 //
 //
 
 void HashTable_destroy (HashTable** table) {
     HashTable_deinitialize(*table);
-    free((*table));
+    Engine_free((*table));
     *table = NULL;
 }
 
 void HashTable_deinitialize (HashTable* table) {
     
-    for (HashTable_array_iterator(table)) {
-        String* key = HashTable_array_key_at(table, i);
-        String_free_dirty(key);
+    if (table->keyArena.first) {
+        Arena_deinitialize(&table->keyArena);
     }
 
-    free(table->activeIndicies);
-    free(table->keys);
-    free(table->values);
+    Engine_free(table->activeIndicies);
+    Engine_free(table->denseIndicies);
+    Engine_free(table->hashes);
+    Engine_free(table->ids);
+    Engine_free(table->idSlots);
+    Engine_free(table->keys);
+    Engine_free(table->values);
 }
 
-//#include "stdio.h"
 
-void HashTable_insert (HashTable* table, const String key, void* value) {
-    // if out of space, increase size by 1.5.
-    if(table->slotsUsed == table->capacity) {
-        HashTable_resize(table, (table->capacity + (table->capacity >> 1)));
+bool internal_HashTable_insert_slot (HashTable* table, const String key, u64* outSlot) {
+    if (!key.start || !key.end) {
+        return false;
     }
 
-    u64 hash = fnvHash64(key.start, key.end) % table->capacity;
-    u64 originalHash = hash;
+    u64 hash = String_hash(key);
 
-    //printf("insert\t c %u h %u, l %u, %s \n", table->capacity, hash, String_length(key), key.start);
+    // index already exists. The caller overwrites it.
+    if (internal_HashTable_find_slot(table, hash, key, outSlot)) {
+        return true;
+    }
 
-    // Check for collisions. Insert at the next free location.
-    while (table->keys[hash].start) {
+    // Grow before the table gets full enough for runs to start merging.
+    if ((table->slotsUsed + 1) * 256 > table->capacity * HASH_TABLE_MAX_LOAD) {
+        HashTable_resize(table, table->capacity << 1);
+    }
 
-        // index already exists. Overwrite.
-        if (String_equal(key, table->keys[hash])) {
-            goto WriteValue;
-        }
+    // Copy the string across. Many tables are created and never written to, so only set up key storage when it's needed.
+    if (!table->keyArena.first) {
+        Arena_initialize(&table->keyArena, table->keyArena.blockSize);
+    }
 
-        hash++;
-        hash %= table->capacity;
+    String keyCopy;
+    String_create_Arena(&table->keyArena, &key, &keyCopy);
 
-        if (hash == originalHash) {
-            Engine_exit_forced(-1);
-        }
-    }
-    
-    // Allocate and copy the string across.
-    String_create_dirty(&key, &(table->keys[hash]));
+    *outSlot = internal_HashTable_place(table, hash, keyCopy, NULL, table->slotsUsed, 0);
+    table->slotsUsed++;
+    table->keyBytes += String_length(keyCopy) + 1;
 
-WriteValue:
-    for (u64 i = 0; i < table->itemSize; ++i) {
-        table->values[(hash * table->itemSize) + i] = ((u8*)value)[i];
+    // Compact after the new key is copied, since key may point at a removed key's bytes in the old arena. Waiting until the 
+    // removed keys outweigh the live ones keeps the copying to O(1) per removed byte.
+    if (table->removedKeyBytes > table->keyBytes && table->removedKeyBytes >= HASH_TABLE_KEY_BLOCK_MIN) {
+        internal_HashTable_compact_keys(table);
     }
+    return true;
+}
 
-    table->activeIndicies[table->slotsUsed] = hash;
-    table->slotsUsed++;
+
+void HashTable_insert (HashTable* table, const String key, void* value) {
+    u64 slot;
+
+    if (internal_HashTable_insert_slot(table, key, &slot)) {
+        memcpy(&table->values[slot * table->itemSize], value, table->itemSize);
+    }
 }
 
 
 void HashTable_remove (HashTable* table, const String key) {
-    u64 hash = fnvHash64(key.start, key.end) % table->capacity;
-    u64 originalHash = hash;
-
-    // TODO: implement some system to handle correcting other items after one is removed since all colliding items have to move.
-
-    while (table->keys[hash].start) {
-        if (String_equal(key, table->keys[hash])) {
-            String_free_dirty(&table->keys[hash]);
-            
-            u64 i = 0;
-            for (; i < table->slotsUsed; i++) {
-                if (table->activeIndicies[i] == hash) break;
-            }
-
-            for (u64 k = i + 1; k < table->slotsUsed; k++) {
-                table->activeIndicies[k - 1] = table->activeIndicies[k];
-            }
-
-            table->slotsUsed--;
-            return;
-        }
+    u64 slot;
 
-        hash++;
-        hash %= table->capacity;
+    if (!internal_HashTable_find_slot(table, String_hash(key), key, &slot)) {
+        return;
+    }
 
-        if (originalHash == hash) {
-            return;
-        }
+    u64 keySize = String_length(table->keys[slot]) + 1;
+    table->keyBytes -= keySize;
+    table->removedKeyBytes += keySize;
+
+    // Swap the last active index into the removed one's place.
+    u64 denseIndex = table->denseIndicies[slot];
+    u64 lastSlot = table->activeIndicies[table->slotsUsed - 1];
+    table->activeIndicies[denseIndex] = lastSlot;
+    table->denseIndicies[lastSlot] = denseIndex;
+    table->slotsUsed--;
+
+    // Shift the rest of the run back one slot, until a key that is already in its own slot or an empty slot is found.
+    u64 mask = table->capacity - 1;
+    u64 next = (slot + 1) & mask;
+
+    while (table->keys[next].start && internal_HashTable_probe_length(table, next) != 0) {
+        internal_HashTable_move_slot(table, next, slot);
+        slot = next;
+        next = (next + 1) & mask;
     }
+
+    table->keys[slot].start = NULL;
+    table->keys[slot].end = NULL;
+    table->hashes[slot] = 0;
+    table->ids[slot] = 0;
 }
 
 
 void HashTable_resize (HashTable* table, const u64 size) {
     // Resize a hash table to the nearest power of 2 to the size provided. (values less than 16 will be rounded up to 16).
-    u64 capacity = (size <= 16) ? 16 : Pow2Ceiling(u64, size);
+    // The table will not shrink below what it needs to store the keys it already has.
+    u64 minimumSize = internal_HashTable_capacity_for(table->slotsUsed);
+    u64 capacity = (size < minimumSize) ? minimumSize : size;
+    capacity = (capacity <= 16) ? 16 : Pow2Ceiling(u64, capacity);
 
     // if the table is already the size provided, skip resizing.
     if (table->capacity == capacity) {
         return;
     }
 
-    u64* activeIndicies = (u64*)calloc(capacity, sizeof(u64));
-    Engine_validate(activeIndicies, ENOMEM);
-
-    String* keys = (String*)calloc(capacity, sizeof(String));
-    Engine_validate(keys, ENOMEM);
-
-    u8* values = (u8*)calloc(capacity, table->itemSize);
-    Engine_validate(values, ENOMEM);
-
-    u64 slotsUsed = 0;
-
+    HashTable resized = {
+        .capacity = capacity,
+        .itemSize = table->itemSize,
+        .slotsUsed = table->slotsUsed,
+        .activeIndicies = (u64*)Engine_calloc(capacity, sizeof(u64), MEMORY_TAG_HASH_TABLE),
+        .denseIndicies = (u64*)Engine_calloc(capacity, sizeof(u64), MEMORY_TAG_HASH_TABLE),
+        .hashes = (u64*)Engine_calloc(capacity, sizeof(u64), MEMORY_TAG_HASH_TABLE),
+        .ids = (u32*)Engine_calloc(capacity, sizeof(u32), MEMORY_TAG_HASH_TABLE),
+        .idSlots = table->idSlots,
+        .idSlotCount = table->idSlotCount,
+        .keys = (String*)Engine_calloc(capacity, sizeof(String), MEMORY_TAG_HASH_TABLE),
+        .values = (u8*)Engine_calloc(capacity, table->itemSize, MEMORY_TAG_HASH_TABLE),
+        .keyArena = table->keyArena,
+        .keyBytes = table->keyBytes,
+        .removedKeyBytes = table->removedKeyBytes,
+        .keyCompactions = table->keyCompactions,
+    };
+
+    Engine_validate(resized.activeIndicies, ENOMEM);
+    Engine_validate(resized.denseIndicies, ENOMEM);
+    Engine_validate(resized.hashes, ENOMEM);
+    Engine_validate(resized.ids, ENOMEM);
+    Engine_validate(resized.keys, ENOMEM);
+    Engine_validate(resized.values, ENOMEM);
+
+    // Keys are moved across rather than copied, and keep their place in the dense array. Only the stored hash is needed to place them.
     for (HashTable_array_iterator(table)) {
-        void* value = HashTable_array_at(void, table, i);
-        String* key = HashTable_array_key_at(table, i);
-
-        u64 hash = fnvHash64(key->start, key->end) % capacity;
-        u64 oldHash = fnvHash64(key->start, key->end) % table->capacity;
-        u64 originalHash = hash;
-
-        while (keys[hash].start) {
-            hash++;
-            hash %= capacity;
-
-            if (hash == originalHash) {
-                Engine_exit_forced(-1);
-            }
-        }
-
-        for (u64 i = 0; i < table->itemSize; ++i) {
-            values[(hash * table->itemSize) + i] = table->values[(oldHash * table->itemSize) + i];
-        }
-
-        keys[hash].start = key->start;
-        keys[hash].end = key->end;
-
-        activeIndicies[slotsUsed] = hash;
-        slotsUsed++;
+        u64 slot = table->activeIndicies[i];
+        internal_HashTable_place(&resized, table->hashes[slot], table->keys[slot], &table->values[slot * table->itemSize], i, table->ids[slot]);
     }
 
-    free(table->activeIndicies);
-    free(table->keys);
-    free(table->values);
+    Engine_free(table->activeIndicies);
+    Engine_free(table->denseIndicies);
+    Engine_free(table->hashes);
+    Engine_free(table->ids);
+    Engine_free(table->keys);
+    Engine_free(table->values);
 
-    table->capacity = capacity;
-    table->activeIndicies = activeIndicies;
-    table->keys = keys;
-    table->values = values;
+    *table = resized;
 }
 
 
@@ -314,45 +546,99 @@ bool internal_HashTable_find (const HashTable* table, const String key, void* ou
         return false;
     }
 
-    u64 hash = fnvHash64(key.start, key.end) % table->capacity;
-    
-    for (u64 i = 0; i < table->itemSize; ++i) {
-        ((u8*)out)[i] = table->values[(hash * table->itemSize) + i];
+    memcpy(out, outref, table->itemSize);
+    return true;
+}
+
+bool internal_HashTable_lookup_slot (const HashTable* table, const String key, u64* outSlot) {
+    return !String_invalid(key) && internal_HashTable_find_slot(table, String_hash(key), key, outSlot);
+}
+
+
+bool HashTable_find_reference (const HashTable* table, const String key, void** outVal) {
+    u64 slot;
+
+    if (!internal_HashTable_lookup_slot(table, key, &slot)) {
+        if (outVal) *outVal = NULL;
+        return false;
     }
 
+    if (outVal) *outVal = (void*)(&table->values[slot * table->itemSize]);
     return true;
 }
 
-bool HashTable_find_reference (const HashTable* table, const String key, void** outVal) {
-    u64 hash = fnvHash64(key.start, key.end) % table->capacity;
-    u64 originalHash = hash;
 
-    //printf("find\t c %u h %u, l %u, %s \n", table->capacity, hash, String_length(key), key.start);
+bool internal_HashTable_lookup_slot_Id (HashTable* table, const u32 id, const String key, u64* outSlot) {
+    u64 slot;
 
-    if (String_invalid(table->keys[hash])) {
-        goto ItemNotFound;
+    if (!id) {
+        return internal_HashTable_lookup_slot(table, key, outSlot);
     }
 
-    while (table->keys[hash].start) {
-        if (String_equal(key, table->keys[hash])) {
+    if (id < table->idSlotCount) {
+        slot = table->idSlots[id];
+        if (slot < table->capacity && table->ids[slot] == id) {
             goto ItemFound;
         }
+    }
+
+    if (!internal_HashTable_lookup_slot(table, key, &slot)) {
+        return false;
+    }
 
-        hash++;
-        hash %= table->capacity;
+    // Grow the cache to fit the id. Ids are dense so this only happens a handful of times.
+    if (id >= table->idSlotCount) {
+        u64 idSlotCount = Pow2Ceiling(u64, (u64)id + 1);
+        u64* idSlots = (u64*)Engine_realloc(table->idSlots, idSlotCount * sizeof(u64), MEMORY_TAG_HASH_TABLE);
+        Engine_validate(idSlots, ENOMEM);
 
-        if (hash == originalHash) {
-            goto ItemNotFound;
+        for (u64 i = table->idSlotCount; i < idSlotCount; ++i) {
+            idSlots[i] = (u64)-1;
         }
+
+        table->idSlots = idSlots;
+        table->idSlotCount = idSlotCount;
     }
 
-ItemNotFound:
-    if (outVal) *outVal = NULL;
-    return false;
+    table->ids[slot] = id;
+    table->idSlots[id] = slot;
 
 ItemFound:
-    if (outVal) *outVal = (void*)(&table->values[hash * table->itemSize]);
+    *outSlot = slot;
     return true;
 }
 
+
+bool HashTable_find_reference_Id (HashTable* table, const u32 id, const String key, void** outVal) {
+    u64 slot;
+
+    if (!internal_HashTable_lookup_slot_Id(table, id, key, &slot)) {
+        if (outVal) *outVal = NULL;
+        return false;
+    }
+
+    if (outVal) *outVal = (void*)(&table->values[slot * table->itemSize]);
+    return true;
+}
+
+
+u64 HashTable_probe_histogram (const HashTable* table, u64* histogram, const u64 bucketCount) {
+    u64 longestProbe = 0;
+
+    for (u64 i = 0; i < bucketCount; ++i) {
+        histogram[i] = 0;
+    }
+
+    for (HashTable_array_iterator(table)) {
+        u64 probeLength = internal_HashTable_probe_length(table, table->activeIndicies[i]);
+        longestProbe = (probeLength > longestProbe) ? probeLength : longestProbe;
+
+        if (bucketCount) {
+            histogram[(probeLength < bucketCount) ? probeLength : bucketCount - 1]++;
+        }
+    }
+
+    return longestProbe;
+}
+
 #endif
\ No newline at end of file
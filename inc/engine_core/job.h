@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdatomic.h>
+
+#include "engine_core/engine_types.h"
+#include "engine_core/thread.h"
+
+// Job system. Jobs_initialize starts a worker thread for each core besides the main thread, and gives every thread, the main
+// thread included, its own deque of jobs. A thread pushes the jobs it submits onto the bottom of its own deque and takes work
+// back from the bottom, newest first. A thread which runs out steals from the top of another thread's deque, oldest first, so
+// it takes the biggest piece of work left and rarely touches the same end as the owner.
+//
+// Dependencies are expressed with a JobCounter. Submitting a job with a counter adds 1 to it, and the job subtracts 1 once it
+// has run. JobCounter_wait blocks until a counter reaches 0, running other jobs in the meantime, so it is fine to wait from
+// inside a job.
+//
+// OpenGL calls only work on the thread that owns the context. Job_submit_main queues a job that only the main thread runs, from
+// Jobs_run_main, which Engine_execute_tick calls every frame.
+//
+// Jobs run on any thread, so they must not use the FrameArena or the ScratchArena, which belong to the main thread.
+//
+// Jobs submitted from a thread the job system didn't start, or before Jobs_initialize, run immediately on the calling thread.
+//
+
+// Jobs each deque holds. A thread whose deque is full runs the job it tried to push itself.
+#define JOB_DEQUE_CAPACITY 4096
+
+typedef struct JobCounter {
+    _Atomic(u32) value;     // Jobs submitted with this counter that have not finished yet.
+} JobCounter;
+
+// Start a worker thread for every core but one, or workerCount of them, if it isn't 0. Call from the main thread.
+void Jobs_initialize(const u32 workerCount);
+
+// Run the jobs that are left and stop the worker threads. Wait on every counter first, a job still running can't submit more.
+void Jobs_deinitialize();
+
+// Number of threads that run jobs, counting the main thread.
+u32 Jobs_thread_count();
+
+// Index of the calling thread among the threads that run jobs. The main thread is 0. Threads the job system didn't start get
+// Jobs_thread_count(), so the result can always be used to pick a per thread slot out of Jobs_thread_count() + 1.
+u32 Jobs_thread_index();
+
+// Run function(data) on any thread. counter may be NULL.
+void Job_submit(Function_Void_OneParam function, void* data, JobCounter* counter);
+
+// Run function(data, start, end) over [0, count), split into batches of at most batchSize. With a counter, each batch is added
+// to it and the call returns straight away. Without one, the call returns once every batch has run.
+void Job_parallel_for(const u64 count, const u64 batchSize, Function_Void_Range function, void* data, JobCounter* counter);
+
+// Run function(data) on the main thread, from the next Jobs_run_main or JobCounter_wait there. counter may be NULL.
+void Job_submit_main(Function_Void_OneParam function, void* data, JobCounter* counter);
+
+// Run the jobs queued by Job_submit_main. Main thread only.
+void Jobs_run_main();
+
+void JobCounter_initialize(JobCounter* counter);
+bool JobCounter_is_done(JobCounter* counter);
+
+// Block until every job submitted with counter has run. Runs other jobs while it waits.
+void JobCounter_wait(JobCounter* counter);
@@ -11,6 +11,8 @@
 
 #include "engine_core/engine_types.h"
 
+typedef struct Arena Arena;
+
 //#define LIST_USE_MEMCPY
 
 #ifdef LIST_USE_MEMCPY
@@ -31,6 +33,7 @@ typedef struct List {
     u8* head;       // Pointer to the "head" of the list.
     u8* tail;       // Pointer to the "tail" of the list.
     u8* data;       // Pointer to the data block of "head" and "tail".
+    Arena* arena;   // Arena the data block is allocated from, or NULL for the heap.
 } List;
 
     // List Functions:
@@ -43,6 +46,11 @@ List* internal_List_create(const u32 ItemSize, const u32 Capacity);
 #define List_initialize(T, list, capacity) internal_List_initialize(list, sizeof(T), capacity)
 void internal_List_initialize(List* list, const u32 ItemSize, const u32 Capacity);
 
+// Initialize a List which allocates from an Arena instead of the heap. Growing the list leaves the old data block in the arena
+// until it is reset, and deinitializing it frees nothing. See engine_core/arena.h.
+#define List_initialize_Arena(T, list, arena, capacity) internal_List_initialize_Arena(list, arena, sizeof(T), capacity)
+void internal_List_initialize_Arena(List* list, Arena* arena, const u32 ItemSize, const u32 Capacity);
+
 void List_destroy(List** list);
 void List_deinitialize(List* list);
 
@@ -100,11 +108,70 @@ void* List_at(const List* list, const u64 index);
 
 void List_append(List* dst, List* src);
 
+// Grow the list if there is no room to push another item.
+void internal_List_grow_if_full(List* list);
+
+    // Typed Lists:
+    //
+    // DECLARE_LIST(Name, T) declares a list of T called Name. Its functions copy items as T, so the compiler knows the size of 
+    // every copy instead of looping over itemSize bytes. The list inside is a normal List, so &list->list can still be passed 
+    // to any List function, and List_iterator(T, &list->list) works as usual.
+    //
+    // DECLARE_LIST(Mat4List, mat4)
+    // Mat4List_push_back(&transforms, transform);
+    //
+
+#define DECLARE_LIST(Name, T)\
+typedef struct Name { List list; } Name;\
+\
+static inline void Name##_initialize (Name* list, const u32 capacity) {\
+    internal_List_initialize(&list->list, sizeof(T), capacity);\
+}\
+static inline void Name##_deinitialize (Name* list) {\
+    List_deinitialize(&list->list);\
+}\
+static inline u32 Name##_count (const Name* list) {\
+    return List_count(&list->list);\
+}\
+static inline void Name##_push_back (Name* list, T item) {\
+    internal_List_grow_if_full(&list->list);\
+    *(T*)list->list.head = item;\
+    internal_List_getNextPtr(u8, &list->list, list->list.head);\
+}\
+static inline void Name##_push_front (Name* list, T item) {\
+    internal_List_grow_if_full(&list->list);\
+    internal_List_getPrevPtr(u8, &list->list, list->list.tail);\
+    *(T*)list->list.tail = item;\
+}\
+static inline bool Name##_pop_front (Name* list, T* out) {\
+    if (List_isEmpty(&list->list)) return false;\
+    internal_List_getPrevPtr(u8, &list->list, list->list.head);\
+    *out = *(T*)list->list.head;\
+    return true;\
+}\
+static inline bool Name##_pop_back (Name* list, T* out) {\
+    if (List_isEmpty(&list->list)) return false;\
+    *out = *(T*)list->list.tail;\
+    internal_List_getNextPtr(u8, &list->list, list->list.tail);\
+    return true;\
+}\
+static inline T* Name##_at (const Name* list, const u64 index) {\
+    /* No bounds check. Index counts up from the tail, and can wrap around the end of the buffer once. */\
+    T* item = (T*)list->list.tail + index;\
+    return (item < internal_List_end(T, &list->list)) ? item : item - list->list.capacity;\
+}
+
 
 #ifdef LIST_IMPLEMENTATION
 
+#include "engine_core/arena.h"
+#include "engine_core/memory.h"
+
+#define internal_List_alloc(list, bytes) ((list)->arena ? Arena_alloc((list)->arena, bytes, 16) : Engine_malloc(bytes, MEMORY_TAG_LIST))
+#define internal_List_free(list, pointer) do { if (!(list)->arena) { Engine_free(pointer); } } while(0)
+
 List* internal_List_create(const u32 ItemSize, const u32 Capacity) {
-    List* newList = (List*)malloc(sizeof(List));
+    List* newList = (List*)Engine_malloc(sizeof(List), MEMORY_TAG_LIST);
 
     internal_List_initialize(newList, ItemSize, Capacity);
     return newList;
@@ -127,17 +194,18 @@ List* List_create_subset(List* list, const u32 start, const u32 end) {
     u32 capacity = end - start;                    // capacity needed to store the number of items in the subset.
     u32 capacityBytes = capacity * list->itemSize; // capacity needed in bytes.
 
-    void* subsetArray = malloc(capacityBytes);
+    void* subsetArray = Engine_malloc(capacityBytes, MEMORY_TAG_LIST);
     void* listArray = List_create_array(list);
     internal_list_copy(subsetArray, listArray, capacityBytes);
 
-    List* subset = (List*)malloc(sizeof(List));
+    List* subset = (List*)Engine_malloc(sizeof(List), MEMORY_TAG_LIST);
 
     subset->capacity = capacity;
     subset->itemSize = list->itemSize;
     subset->data = (u8*)subsetArray;
     subset->head = (u8*)subsetArray;
     subset->tail = (u8*)subsetArray;
+    subset->arena = NULL;
 
     return subset;
 }
@@ -148,8 +216,9 @@ void internal_List_initialize(List* list, const u32 ItemSize, const u32 Capacity
     //
     //
 
-    list->data = (u8*)calloc(ItemSize, Capacity);
+    list->data = (u8*)Engine_calloc(ItemSize, Capacity, MEMORY_TAG_LIST);
     //list->data = (u8*)malloc(ItemSize * Capacity);
+    list->arena = NULL;
 
     // Set capacity and size.
     list->capacity = Capacity;
@@ -161,12 +230,24 @@ void internal_List_initialize(List* list, const u32 ItemSize, const u32 Capacity
 }
 
 
+void internal_List_initialize_Arena(List* list, Arena* arena, const u32 ItemSize, const u32 Capacity) {
+    list->data = (u8*)Arena_alloc_zero(arena, (u64)ItemSize * Capacity, 16);
+    list->arena = arena;
+
+    list->capacity = Capacity;
+    list->itemSize = ItemSize;
+
+    list->head = list->data;
+    list->tail = list->data;
+}
+
+
 void List_deinitialize(List* list) {
     // De-initialize a List.
 
     if (!list) return;
 
-    free(list->data);
+    internal_List_free(list, list->data);
     list->data = NULL;
     list->head = NULL;  // points into list->data, no need to free.
     list->tail = NULL;  // points into list->data, no need to free.
@@ -178,12 +259,12 @@ void List_destroy(List** list) {
 
     if (!(*list)) return;
 
-    free((*list)->data);
+    internal_List_free(*list, (*list)->data);
     (*list)->data = NULL;
     (*list)->head = NULL;   // points into list->data, no need to free.
     (*list)->tail = NULL;   // points into list->data, no need to free.
 
-    free((*list));
+    Engine_free((*list));
     (*list) = NULL;
 }
 
@@ -195,8 +276,8 @@ void internal_List_set(List* list, void* template, const u32 count) {
 
     // If count is greater than the list capacity, reallocate with doubling factor of 1.5
     if (count >= list->capacity) {
-        u8* newData = (u8*)malloc(list->itemSize * (count + (count >> 1)));
-        free(list->data);
+        u8* newData = (u8*)internal_List_alloc(list, list->itemSize * (count + (count >> 1)));
+        internal_List_free(list, list->data);
         list->head = newData;
         list->tail = newData;
         list->data = newData;
@@ -217,7 +298,7 @@ void* List_create_array(List* list) {
     // you must free this list yourself!
     //
 
-    void* array = malloc(List_byte_count(list));
+    void* array = Engine_malloc(List_byte_count(list), MEMORY_TAG_LIST);
 
     // The copy can be simplified since the list is either continuous, or split in two.
     //
@@ -261,7 +342,7 @@ void List_reorder(List* list) {
     else {
         void* temp = List_create_array(list);
         internal_list_copy(list->data, temp, list->itemSize * List_count(list));
-        free(temp);
+        Engine_free(temp);
     }
 
     list->tail = list->data;
@@ -281,7 +362,7 @@ void List_realloc(List* list, u32 Capacity) {
         Capacity = oldCount;
     }
 
-    u8* newData = (u8*)malloc(list->itemSize * Capacity);
+    u8* newData = (u8*)internal_List_alloc(list, list->itemSize * Capacity);
 
     // Jump to end if for some reason you're reallocating an empty array?? why are you doing that?
     if (list->head == list->tail) {
@@ -312,7 +393,7 @@ void List_realloc(List* list, u32 Capacity) {
     list->head = newData + (oldCount * list->itemSize);
 
     // free the old data, and set the pointer.
-    free(list->data);
+    internal_List_free(list, list->data);
     list->data = newData;
 
     // Update the capacity.
@@ -425,23 +506,25 @@ void List_remove_at(List* list, const u64 index) {
 }
 
 
-void internal_List_push_back(List* list, void* data) {
+void internal_List_grow_if_full(List* list) {
     // Reallocate the array with a doubling factor of 1.5
     if (List_count(list) >= list->capacity - 1) {
         List_realloc(list, list->capacity + (list->capacity << 1));
     }
+}
+
+
+void internal_List_push_back(List* list, void* data) {
+    internal_List_grow_if_full(list);
     internal_list_copy(list->head, data, list->itemSize);
     internal_List_getNextPtr(u8, list, list->head);
 }
 
 
 void internal_List_push_front(List* list, void* data) {
-    // Reallocate the array with a doubling factor of 1.5
-    if (List_count(list) >= list->capacity - 1) {
-        List_realloc(list, list->capacity + (list->capacity << 1));
-    }
-    internal_list_copy(list->tail, data, list->itemSize);
+    internal_List_grow_if_full(list);
     internal_List_getPrevPtr(u8, list, list->tail);
+    internal_list_copy(list->tail, data, list->itemSize);
 }
 
 
@@ -508,6 +591,6 @@ void List_append(List* dst, List* src) {
     // At this point, the list must be in order since both realloc and reorder cause the array to not be split.
     internal_list_copy(dst->head, srcArray, sourceByteCount);
     dst->head += sourceByteCount;
-    free(srcArray);
+    Engine_free(srcArray);
 }
 #endif
\ No newline at end of file
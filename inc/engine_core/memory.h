@@ -0,0 +1,67 @@
+#pragma once
+
+#include "engine_core/engine_types.h"
+
+// Tracked heap allocations. Engine code allocates with Engine_malloc, Engine_calloc and Engine_realloc, passing the tag of the
+// subsystem the memory belongs to, and frees with Engine_free. With ENGINE_TRACK_ALLOCATIONS defined (see configuation.h), each
+// allocation carries a small header with its size and tag, and the counters below are kept for every tag. Without it, the
+// macros are plain malloc, calloc, realloc and free.
+//
+// Memory from Engine_malloc must be freed with Engine_free, and never with free, or the other way around.
+//
+// The counters are atomic, so allocating from any thread is safe.
+//
+
+#define MEMORY_TAG_GENERAL      0
+#define MEMORY_TAG_LIST         1
+#define MEMORY_TAG_VECTOR       2
+#define MEMORY_TAG_HASH_TABLE   3
+#define MEMORY_TAG_STRING       4
+#define MEMORY_TAG_ARENA        5
+#define MEMORY_TAG_POOL         6
+#define MEMORY_TAG_SHADER       7   // Shaders, uniforms and uniform buffers.
+#define MEMORY_TAG_TEXTURE      8
+#define MEMORY_TAG_MATERIAL     9
+#define MEMORY_TAG_MESH         10
+#define MEMORY_TAG_COUNT        11
+
+typedef struct MemoryStats {
+    u64 liveBytes;          // Bytes allocated and not freed yet.
+    u64 peakBytes;          // Most liveBytes has ever been.
+    u64 liveAllocations;
+    u64 totalAllocations;   // Every allocation and reallocation since the engine started.
+    u64 frameAllocations;   // Allocations and reallocations since the start of the current frame.
+    u64 frameBytes;
+} MemoryStats;
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+#define Engine_malloc(size, tag) Memory_alloc((u64)(size), tag)
+#define Engine_calloc(count, size, tag) Memory_calloc((u64)(count), (u64)(size), tag)
+#define Engine_realloc(pointer, size, tag) Memory_realloc(pointer, (u64)(size), tag)
+#define Engine_free(pointer) Memory_free(pointer)
+#else
+#define Engine_malloc(size, tag) malloc(size)
+#define Engine_calloc(count, size, tag) calloc(count, size)
+#define Engine_realloc(pointer, size, tag) realloc(pointer, size)
+#define Engine_free(pointer) free(pointer)
+#endif
+
+void* Memory_alloc(const u64 size, const u8 tag);
+void* Memory_calloc(const u64 count, const u64 size, const u8 tag);
+void* Memory_realloc(void* pointer, const u64 size, const u8 tag);
+void Memory_free(void* pointer);
+
+// Counters for one tag. Every counter reads 0 unless ENGINE_TRACK_ALLOCATIONS is defined.
+void Memory_get_stats(const u8 tag, MemoryStats* out);
+
+// Counters summed over every tag. peakBytes is the sum of the peaks of each tag, which may not have happened at the same time.
+void Memory_get_total(MemoryStats* out);
+
+const char* Memory_tag_name(const u8 tag);
+
+// Print the counters of every tag to stdout.
+void Memory_report();
+
+// Start counting the allocations of a new frame. Called by Engine_execute_tick. With ENGINE_ASSERT_FRAME_ALLOCATIONS defined,
+// asserts when the frame that just ended allocated, once ENGINE_ALLOCATION_WARMUP_FRAMES frames have gone by.
+void Memory_begin_frame();
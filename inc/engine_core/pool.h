@@ -0,0 +1,68 @@
+#pragma once
+
+#include "engine_core/engine_types.h"
+
+// Fixed size object pools. A Pool hands out items of one size from slabs of POOL_SLAB_CAPACITY items. Slabs are never moved or
+// freed until the Pool is deinitialized, so a pointer to an item stays valid for as long as the item is alive, and freed items
+// are kept on a free list and reused by the next allocation without going back to the heap.
+//
+// Every item is also addressed by a Handle, which packs the item's slot index with a generation count. The generation of a slot
+// is bumped whenever the item in it is freed, so Pool_resolve returns NULL for a Handle to an item which no longer exists, even
+// if the slot has been reused since. Hold on to Handles instead of pointers for references that can outlive the item.
+//
+// Freed slots are reused oldest first, so churn is spread over every free slot instead of wearing out one. A slot whose
+// generation has reached POOL_HANDLE_GENERATION_MASK is retired when it's freed, rather than wrapping back to a generation an
+// old Handle may still carry. Retired slots are never handed out again, so a Pool can allocate about POOL_MAX_ITEMS times
+// POOL_HANDLE_GENERATION_MASK items over its lifetime.
+//
+
+// Number of items in a slab. Must be a power of 2.
+#ifndef POOL_SLAB_CAPACITY
+#define POOL_SLAB_CAPACITY 64
+#endif
+
+// Handle layout: the low POOL_HANDLE_INDEX_BITS bits are the slot index, the rest are the generation.
+#define POOL_HANDLE_INDEX_BITS 20
+#define POOL_HANDLE_GENERATION_BITS 12
+#define POOL_HANDLE_INDEX_MASK ((1ul << POOL_HANDLE_INDEX_BITS) - 1)
+#define POOL_HANDLE_GENERATION_MASK ((1ul << POOL_HANDLE_GENERATION_BITS) - 1)
+
+// Largest number of items a Pool can hold at once.
+#define POOL_MAX_ITEMS (1ul << POOL_HANDLE_INDEX_BITS)
+
+// Generations start at 1, so a Handle is never 0. Use HANDLE_NULL for "no item".
+#define HANDLE_NULL 0
+
+typedef u32 Handle;
+
+#define Handle_index(handle) ((u32)(handle) & POOL_HANDLE_INDEX_MASK)
+#define Handle_generation(handle) (((u32)(handle) >> POOL_HANDLE_INDEX_BITS) & POOL_HANDLE_GENERATION_MASK)
+#define Handle_make(index, generation) ((Handle)((((u32)(generation) & POOL_HANDLE_GENERATION_MASK) << POOL_HANDLE_INDEX_BITS) | ((u32)(index) & POOL_HANDLE_INDEX_MASK)))
+
+typedef struct Pool {
+    u8** slabs;             // Slab pointers. Only this array grows, the slabs themselves never move.
+    u16* generations;       // Current generation of each slot.
+    u32 slabCount;
+    u32 capacity;           // Number of slots in all slabs.
+    u32 count;              // Number of live items.
+    u32 itemSize;           // Size in bytes of a slot. At least the requested size, rounded up to 16 bytes.
+    u32 retired;            // Number of slots whose generation ran out.
+    u32 freeHead;           // Index of the free slot Pool_alloc hands out next, or POOL_MAX_ITEMS when every slot is in use.
+    u32 freeTail;           // Index of the slot freed last, where Pool_free appends. Only valid when freeHead is a slot.
+} Pool;
+
+#define Pool_initialize(T, pool) internal_Pool_initialize(pool, sizeof(T))
+void internal_Pool_initialize(Pool* pool, const u32 itemSize);
+void Pool_deinitialize(Pool* pool);
+
+// Allocate an item. Its memory is not cleared. If outHandle is not NULL, it receives the item's Handle.
+void* Pool_alloc(Pool* pool, Handle* outHandle);
+
+// Return an item to the Pool. Stale Handles are ignored, so freeing an item twice is safe.
+void Pool_free(Pool* pool, const Handle handle);
+
+// Pointer to the item, or NULL if handle doesn't refer to a live item.
+void* Pool_resolve(const Pool* pool, const Handle handle);
+
+#define Pool_is_valid(pool, handle) (Pool_resolve(pool, handle) != NULL)
+#define Pool_count(pool) ((pool)->count)
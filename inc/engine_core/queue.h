@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stdatomic.h>
+
+#include "engine_core/engine_types.h"
+
+// Bounded ring queues for passing items between threads without locks, like upload requests from loader threads to the GL
+// thread, log messages or input events. Both copy items in and out by value, like List, but the capacity is rounded up to a
+// power of 2 so a slot is found with a mask, and neither ever grows: a push to a full queue fails and the caller decides what to
+// do with the item.
+//
+//  - SpscQueue takes exactly one producer thread and one consumer thread. Each side only writes its own index, and keeps a
+//    cached copy of the other side's, so it only touches the other side's cache line when the queue looks full or empty.
+//  - MpmcQueue takes any number of producers and consumers. Every slot has a sequence number saying whether it is ready to be
+//    written or read in the current lap, so threads claim slots with a single compare and swap on the shared index.
+//
+// The indices written by producers and by consumers are kept on separate cache lines, so the two sides don't slow each other
+// down by writing to the same line.
+//
+// The batch functions move as many items as fit, up to count, with one update of the shared index, and return how many moved.
+//
+
+#define QUEUE_CACHE_LINE 64
+
+typedef struct SpscQueue {
+    // Read only after initialize.
+    u8* data;
+    u64 mask;               // Capacity - 1.
+    u64 itemSize;
+    u8 padding0[QUEUE_CACHE_LINE - sizeof(u8*) - 2 * sizeof(u64)];
+
+    // Producer.
+    _Atomic(u64) tail;      // Next slot to write.
+    u64 cachedHead;
+    u8 padding1[QUEUE_CACHE_LINE - 2 * sizeof(u64)];
+
+    // Consumer.
+    _Atomic(u64) head;      // Next slot to read.
+    u64 cachedTail;
+    u8 padding2[QUEUE_CACHE_LINE - 2 * sizeof(u64)];
+} SpscQueue;
+
+typedef struct MpmcQueue {
+    // Read only after initialize.
+    u8* data;
+    _Atomic(u64)* sequences;    // Slot i is ready to write at position p when its sequence is p, and to read when it is p + 1.
+    u64 mask;
+    u64 itemSize;
+    u8 padding0[QUEUE_CACHE_LINE - 2 * sizeof(void*) - 2 * sizeof(u64)];
+
+    _Atomic(u64) tail;          // Next position producers claim.
+    u8 padding1[QUEUE_CACHE_LINE - sizeof(u64)];
+
+    _Atomic(u64) head;          // Next position consumers claim.
+    u8 padding2[QUEUE_CACHE_LINE - sizeof(u64)];
+} MpmcQueue;
+
+#define SpscQueue_initialize(T, queue, capacity) internal_SpscQueue_initialize(queue, sizeof(T), (u64)(capacity))
+void internal_SpscQueue_initialize(SpscQueue* queue, const u64 itemSize, const u64 capacity);
+void SpscQueue_deinitialize(SpscQueue* queue);
+
+#define SpscQueue_push(queue, Data) internal_SpscQueue_push((queue), (const void*)&Data)
+#define SpscQueue_pop(queue, outVal) internal_SpscQueue_pop((queue), (void*)&outVal)
+bool internal_SpscQueue_push(SpscQueue* queue, const void* item);
+bool internal_SpscQueue_pop(SpscQueue* queue, void* out);
+
+u64 SpscQueue_push_n(SpscQueue* queue, const void* items, const u64 count);
+u64 SpscQueue_pop_n(SpscQueue* queue, void* out, const u64 count);
+
+// Only exact when called from the producer or the consumer while the other side is idle.
+u64 SpscQueue_count(SpscQueue* queue);
+#define SpscQueue_capacity(queue) ((queue)->mask + 1)
+
+#define MpmcQueue_initialize(T, queue, capacity) internal_MpmcQueue_initialize(queue, sizeof(T), (u64)(capacity))
+void internal_MpmcQueue_initialize(MpmcQueue* queue, const u64 itemSize, const u64 capacity);
+void MpmcQueue_deinitialize(MpmcQueue* queue);
+
+#define MpmcQueue_push(queue, Data) internal_MpmcQueue_push((queue), (const void*)&Data)
+#define MpmcQueue_pop(queue, outVal) internal_MpmcQueue_pop((queue), (void*)&outVal)
+bool internal_MpmcQueue_push(MpmcQueue* queue, const void* item);
+bool internal_MpmcQueue_pop(MpmcQueue* queue, void* out);
+
+// Claims count slots at once, or fewer if the queue is nearly full or empty, or another thread holds a slot in the way.
+u64 MpmcQueue_push_n(MpmcQueue* queue, const void* items, const u64 count);
+u64 MpmcQueue_pop_n(MpmcQueue* queue, void* out, const u64 count);
+
+// Approximate while other threads are pushing or popping.
+u64 MpmcQueue_count(MpmcQueue* queue);
+#define MpmcQueue_capacity(queue) ((queue)->mask + 1)
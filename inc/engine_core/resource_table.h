@@ -0,0 +1,44 @@
+#pragma once
+
+#include "engine_core/engine_types.h"
+#include "engine_core/string.h"
+#include "engine_core/string_id.h"
+#include "engine_core/hash_table.h"
+#include "engine_core/pool.h"
+
+// Tables of named resources, like textures and shaders. Resources are stored in a Pool, so they never move once created, and are
+// addressed by a Handle. Aliases are only used to find a resource's Handle, normally once when something that uses the resource
+// is created. After that, getting the resource from its Handle is an array index and a generation check.
+//
+// Handles to a removed resource resolve to NULL, even if its slot has been reused by another resource.
+//
+
+DECLARE_HASHTABLE(HandleMap, Handle)
+
+typedef struct ResourceTable {
+    Pool items;             // The resources.
+    StringId* aliases;      // Alias of the resource in each slot of items.
+    u32 aliasCapacity;
+    HandleMap handles;      // Alias to Handle. Its values are also a dense list of every live resource.
+} ResourceTable;
+
+#define ResourceTable_initialize(T, table, capacity) internal_ResourceTable_initialize(table, sizeof(T), capacity)
+void internal_ResourceTable_initialize(ResourceTable* table, const u32 itemSize, const u64 capacity);
+void ResourceTable_deinitialize(ResourceTable* table);
+
+// Add a resource called alias, and return a pointer to it so the caller can fill it in. Returns NULL if the alias is taken.
+void* ResourceTable_insert(ResourceTable* table, const String alias, Handle* outHandle);
+void ResourceTable_remove(ResourceTable* table, const Handle handle);
+
+// Handle of the resource called alias, or HANDLE_NULL if there is none.
+Handle ResourceTable_find(const ResourceTable* table, const String alias);
+Handle ResourceTable_find_Id(ResourceTable* table, const StringId alias);
+
+// Alias of a live resource, or STRING_ID_NONE.
+StringId ResourceTable_alias(const ResourceTable* table, const Handle handle);
+
+#define ResourceTable_get(T, table, handle) ((T*)Pool_resolve(&(table)->items, handle))
+
+// Number of live resources. Handles of the live resources are in [0, ResourceTable_count). Removing a resource reorders them.
+#define ResourceTable_count(table) HandleMap_count(&(table)->handles)
+#define ResourceTable_handle_at(table, i) (*HandleMap_array_at(&(table)->handles, i))
@@ -18,6 +18,10 @@ void String_create_dirty(String* source, String* destination);
 // Only use to free strings created on the heap with the String_create_dirty method.
 void String_free_dirty(String* str);
 
+// Same as String_create_dirty, but the copy is allocated from an Arena and is freed with it. See engine_core/arena.h.
+typedef struct Arena Arena;
+void String_create_Arena(Arena* arena, const String* source, String* destination);
+
 // writes the contents of a String to a char*, with a null terminator. Ensure the destination is at least String length + 1. 
 #define String_clone_to_ptr(string, destination) internal_String_clone_to_chars(&string, (char*)destination)
 
@@ -33,6 +37,10 @@ void String_free_dirty(String* str);
 #define String_from_ptr_size(buffer, buffersize) { .start = (char*)buffer, .end = (char*)buffer + (u64)buffersize }
 
 #define String_equal(left, right) internal_String_equal(&left, &right)
+
+// Hash of the contents of a String. This is the hash HashTable uses for its keys.
+#define String_hash(string) wyHash64((string).start, (string).end)
+
 #define String_invalid(string) (!(string).start || !(string).end || (string).start == (string).end)
 
 #define String_length(string) ((u64)((string).end - (string).start))
@@ -42,17 +50,37 @@ void String_free_dirty(String* str);
 #define String_first(string, pattern) internal_String_first(&(string), pattern);
 #define String_last(string, pattern) internal_String_last(&(string), pattern);
 
+// Pointer to the first occurrence of pattern in string, or NULL.
+#define String_find(string, pattern) internal_String_find(&(string), &(pattern))
+
+// Take the next token off the front of source, up to the next occurrence of delimiter, and move source past the delimiter. 
+// Delimiters can be any length. Adjacent delimiters give empty tokens. Returns false once source is used up.
+#define String_split_next(source, delimiter, token) internal_String_split_next(&(source), &(delimiter), &(token))
+
 #define String_clone(source, destination) (destination).end = (destination).start; for (char* c = (source).start; c < (source).end; ++c, ++(destination).end) { *((destination).end) = *c; }  
 #define String_substring(source, start, end) { .start = (source).start + (u64)start, .end = (source).start + (u64)end }
 #define String_clone_substring(source, destination, start, end) internal_String_clone_substring (&source, &destination, (u64)start, (u64)end)
 
-bool internal_String_equal(String* left, String* right);
+bool internal_String_equal(const String* left, const String* right);
 
 void internal_String_clone_substring (String* source, String* destination, u64 start, u64 end);
 void internal_String_clone_to_chars (String* string, char* destination);
 
 char* internal_String_first (String* string, char pattern);
 char* internal_String_last (String* string, char pattern);
+char* internal_String_find (const String* string, const String* pattern);
+bool internal_String_split_next (String* source, const String* delimiter, String* token);
 
 u64 fnvHash64 (const char* buffer, const char* const bufferEnd);
+u64 wyHash64 (const char* buffer, const char* const bufferEnd);
+// Find the null terminator of a c-string. Returns NULL for a NULL buffer.
 char* FindBufferEnd (const char* buffer);
+
+// FindBufferEnd, String_first, String_last and String_find use the widest of these the processor supports. Engine_initialize 
+// makes the choice before starting any worker thread, or else the first scan makes it, which isn't safe with several threads. 
+// String_select_scan overrides it with the widest supported level up to the one given, and returns that level.
+#define STRING_SCAN_SCALAR 0
+#define STRING_SCAN_SSE2 1
+#define STRING_SCAN_AVX2 2
+
+u8 String_select_scan (u8 level);
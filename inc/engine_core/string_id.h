@@ -0,0 +1,29 @@
+#pragma once
+
+#include "engine_core/engine_types.h"
+#include "engine_core/string.h"
+
+// Interned aliases. Every distinct alias is given a small, dense id the first time it is seen, and keeps it until the system is 
+// deinitialized. Resolve an alias to an id once, outside of any loop, then use the "_Id" version of a lookup every frame.
+//
+// Ids start at 1. STRING_ID_NONE is never given to an alias.
+
+typedef u32 StringId;
+
+#define STRING_ID_NONE 0
+
+void StringId_initialize();
+void StringId_deinitialize();
+
+// Get the id of an alias, adding it if it hasn't been seen before.
+StringId StringId_get(const char* alias);
+StringId StringId_get_String(String alias);
+
+// Get the id of an alias without adding it. STRING_ID_NONE if it hasn't been seen.
+StringId StringId_find(const char* alias);
+
+// Get the alias of an id. The String is owned by the system, don't free it.
+String StringId_as_String(const StringId id);
+
+// Number of ids given out so far, including STRING_ID_NONE.
+u32 StringId_count();
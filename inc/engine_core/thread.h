@@ -0,0 +1,58 @@
+#pragma once
+
+#include "engine_core/engine_types.h"
+
+// Thin wrapper over the platform's threads and locks, Win32 on Windows and pthreads everywhere else. Atomics come straight from
+// <stdatomic.h>.
+//
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+typedef struct Thread {
+#ifdef _WIN32
+    void* handle;
+#else
+    pthread_t handle;
+#endif
+    Function_Void_OneParam function;
+    void* argument;
+} Thread;
+
+typedef struct Mutex {
+#ifdef _WIN32
+    void* lock;             // SRWLOCK, which is the size of a pointer.
+#else
+    pthread_mutex_t lock;
+#endif
+} Mutex;
+
+typedef struct Condition {
+#ifdef _WIN32
+    void* condition;        // CONDITION_VARIABLE, which is the size of a pointer.
+#else
+    pthread_cond_t condition;
+#endif
+} Condition;
+
+// Start function(argument) on a new thread. The Thread must stay at the same address until it is joined.
+bool Thread_create(Thread* thread, Function_Void_OneParam function, void* argument);
+void Thread_join(Thread* thread);
+void Thread_yield();
+
+// Number of threads the processor can run at once. At least 1.
+u32 Thread_hardware_concurrency();
+
+void Mutex_initialize(Mutex* mutex);
+void Mutex_deinitialize(Mutex* mutex);
+void Mutex_lock(Mutex* mutex);
+void Mutex_unlock(Mutex* mutex);
+
+void Condition_initialize(Condition* condition);
+void Condition_deinitialize(Condition* condition);
+
+// Unlock mutex, sleep until woken, and lock it again. May wake up without being signalled, so check what was waited for in a loop.
+void Condition_wait(Condition* condition, Mutex* mutex);
+void Condition_wake_one(Condition* condition);
+void Condition_wake_all(Condition* condition);
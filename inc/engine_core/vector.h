@@ -0,0 +1,307 @@
+// Vector implementation.
+//
+// To use this library, add a source file with these two lines.
+// #define VECTOR_IMPLEMENTATION
+// #include "vector.h"
+//
+// A Vector is a contiguous, growable array. It uses the same itemSize based API as List, but never wraps around, so items can
+// be iterated with a plain pointer, and bulk operations are a single memcpy. Prefer it over List for anything filled in bulk
+// and read front to back, like loader output and render queues. List is still the better fit for queues that pop from the front.
+//
+
+#pragma once
+
+#include "engine_core/engine_types.h"
+
+
+// Type Definitions:
+//
+//
+
+typedef struct Vector {
+    u64 count;      // Number of items stored.
+    u64 capacity;   // Number of items that fit before the data has to grow.
+    u32 itemSize;   // Size in bytes of an item.
+    u8* data;       // Pointer to the first item.
+} Vector;
+
+    // Vector Functions:
+    //
+    //
+
+#define Vector_create(T, capacity) internal_Vector_create(sizeof(T), (u64)capacity)
+Vector* internal_Vector_create(const u32 ItemSize, const u64 Capacity);
+
+#define Vector_initialize(T, vector, capacity) internal_Vector_initialize(vector, sizeof(T), (u64)capacity)
+void internal_Vector_initialize(Vector* vector, const u32 ItemSize, const u64 Capacity);
+
+void Vector_destroy(Vector** vector);
+void Vector_deinitialize(Vector* vector);
+
+#define Vector_isEmpty(vector) ((vector)->count == 0)
+#define Vector_byte_count(vector) ((vector)->count * (vector)->itemSize)
+
+// Typed pointers to the first item and one past the last item.
+#define Vector_begin(T, vector) ((T*)(vector)->data)
+#define Vector_end(T, vector) ((T*)((vector)->data + (vector)->count * (vector)->itemSize))
+
+// Creates T* variable, it, which is the current item in the loop. T must be the type the Vector was created with. The end is
+// read again every iteration, like List_iterator, since a second declarator would not be a T* when T is itself a pointer type.
+#define Vector_iterator(T, vector) T* it = Vector_begin(T, vector); it < Vector_end(T, vector); ++it
+
+// Item at index, without a bounds check.
+#define Vector_at_unchecked(T, vector, index) ((T*)((vector)->data + (u64)(index) * (vector)->itemSize))
+
+#define Vector_push_back(vector, Data) internal_Vector_push_back((vector), (void*)&Data)
+#define Vector_pop_back(vector, outVal) internal_Vector_pop_back((vector), (void*)&outVal)
+#define Vector_peak_back(vector, outVal) internal_Vector_peak_back((vector), (void*)&outVal)
+
+// Append count copies of template.
+#define Vector_push_back_n(vector, template, count) internal_Vector_push_back_n((vector), (void*)&template, (u64)count)
+
+void* internal_Vector_push_back(Vector* vector, const void* data);
+void* internal_Vector_push_back_n(Vector* vector, const void* template, const u64 count);
+void internal_Vector_pop_back(Vector* vector, void* outVal);
+void internal_Vector_peak_back(Vector* vector, void* outVal);
+
+// Append count items read from a contiguous array. Returns a pointer to the first appended item.
+void* Vector_append_range(Vector* vector, const void* items, const u64 count);
+
+// Grow count by count items and return a pointer to the first of them. The new items are not initialized, so a loader can
+// write into them directly.
+void* Vector_extend(Vector* vector, const u64 count);
+
+void Vector_append(Vector* dst, const Vector* src);
+
+// Make sure the Vector can hold at least Capacity items without growing again. Never shrinks.
+void Vector_reserve(Vector* vector, const u64 Capacity);
+void Vector_shrink_to_fit(Vector* vector);
+void Vector_clear(Vector* vector);
+
+void* Vector_at(const Vector* vector, const u64 index);
+
+// Remove an item and shift every item after it down by one.
+void Vector_remove_at(Vector* vector, const u64 index);
+
+// Remove an item by moving the last item into its place. Does not keep the order of items.
+void Vector_remove_at_swap(Vector* vector, const u64 index);
+
+
+#ifdef VECTOR_IMPLEMENTATION
+
+#include "errno.h"
+#include <string.h>
+
+#include "engine_core/memory.h"
+
+// Smallest capacity a Vector grows to.
+#define VECTOR_MIN_CAPACITY 8
+
+void internal_Vector_grow(Vector* vector, const u64 required) {
+    // Grow the data by at least a factor of 2, so pushing one item at a time is amortized O(1).
+    //
+
+    u64 capacity = vector->capacity << 1;
+    if (capacity < required) {
+        capacity = required;
+    }
+    if (capacity < VECTOR_MIN_CAPACITY) {
+        capacity = VECTOR_MIN_CAPACITY;
+    }
+
+    Vector_reserve(vector, capacity);
+}
+
+
+Vector* internal_Vector_create(const u32 ItemSize, const u64 Capacity) {
+    Vector* newVector = (Vector*)Engine_malloc(sizeof(Vector), MEMORY_TAG_VECTOR);
+    Engine_validate(newVector, ENOMEM);
+
+    internal_Vector_initialize(newVector, ItemSize, Capacity);
+    return newVector;
+}
+
+
+void internal_Vector_initialize(Vector* vector, const u32 ItemSize, const u64 Capacity) {
+    vector->count = 0;
+    vector->capacity = 0;
+    vector->itemSize = ItemSize;
+    vector->data = NULL;
+
+    if (Capacity) {
+        Vector_reserve(vector, Capacity);
+    }
+}
+
+
+void Vector_deinitialize(Vector* vector) {
+    if (!vector) return;
+
+    Engine_free(vector->data);
+    vector->data = NULL;
+    vector->count = 0;
+    vector->capacity = 0;
+}
+
+
+void Vector_destroy(Vector** vector) {
+    if (!(*vector)) return;
+
+    Vector_deinitialize(*vector);
+
+    Engine_free((*vector));
+    (*vector) = NULL;
+}
+
+
+void Vector_reserve(Vector* vector, const u64 Capacity) {
+    if (Capacity <= vector->capacity) {
+        return;
+    }
+
+    u8* newData = (u8*)Engine_realloc(vector->data, Capacity * vector->itemSize, MEMORY_TAG_VECTOR);
+    Engine_validate(newData, ENOMEM);
+
+    vector->data = newData;
+    vector->capacity = Capacity;
+}
+
+
+void Vector_shrink_to_fit(Vector* vector) {
+    if (vector->count == vector->capacity) {
+        return;
+    }
+
+    if (!vector->count) {
+        Engine_free(vector->data);
+        vector->data = NULL;
+        vector->capacity = 0;
+        return;
+    }
+
+    u8* newData = (u8*)Engine_realloc(vector->data, vector->count * vector->itemSize, MEMORY_TAG_VECTOR);
+    Engine_validate(newData, ENOMEM);
+
+    vector->data = newData;
+    vector->capacity = vector->count;
+}
+
+
+void Vector_clear(Vector* vector) {
+    vector->count = 0;
+}
+
+
+void* internal_Vector_push_back(Vector* vector, const void* data) {
+    if (vector->count == vector->capacity) {
+        internal_Vector_grow(vector, vector->count + 1);
+    }
+
+    u8* slot = vector->data + vector->count * vector->itemSize;
+    memcpy(slot, data, vector->itemSize);
+    ++vector->count;
+    return slot;
+}
+
+
+void* Vector_extend(Vector* vector, const u64 count) {
+    if (vector->count + count > vector->capacity) {
+        internal_Vector_grow(vector, vector->count + count);
+    }
+
+    u8* first = vector->data + vector->count * vector->itemSize;
+    vector->count += count;
+    return first;
+}
+
+
+void* Vector_append_range(Vector* vector, const void* items, const u64 count) {
+    if (!count) {
+        return vector->data + vector->count * vector->itemSize;
+    }
+
+    u8* first = (u8*)Vector_extend(vector, count);
+    memcpy(first, items, count * vector->itemSize);
+    return first;
+}
+
+
+void* internal_Vector_push_back_n(Vector* vector, const void* template, const u64 count) {
+    if (!count) {
+        return vector->data + vector->count * vector->itemSize;
+    }
+
+    u8* first = (u8*)Vector_extend(vector, count);
+    memcpy(first, template, vector->itemSize);
+
+    // Fill by copying what has been written so far, doubling each time, so large fills are a handful of large memcpys.
+    u64 filledBytes = vector->itemSize;
+    const u64 totalBytes = count * vector->itemSize;
+    while (filledBytes < totalBytes) {
+        u64 copyBytes = (totalBytes - filledBytes < filledBytes)? totalBytes - filledBytes : filledBytes;
+        memcpy(first + filledBytes, first, copyBytes);
+        filledBytes += copyBytes;
+    }
+
+    return first;
+}
+
+
+void Vector_append(Vector* dst, const Vector* src) {
+    if (!dst || !src) return;
+
+    // leave early if the vectors contain different data "types".
+    if (dst->itemSize != src->itemSize) return;
+
+    // Reserve first, so appending a Vector to itself reads from the grown buffer.
+    Vector_reserve(dst, dst->count + src->count);
+    Vector_append_range(dst, src->data, src->count);
+}
+
+
+void internal_Vector_pop_back(Vector* vector, void* outVal) {
+    if (!vector->count) return;   // Leave early if there is no data.
+
+    --vector->count;
+    memcpy(outVal, vector->data + vector->count * vector->itemSize, vector->itemSize);
+}
+
+
+void internal_Vector_peak_back(Vector* vector, void* outVal) {
+    if (!vector->count) return;   // Leave early if there is no data.
+
+    memcpy(outVal, vector->data + (vector->count - 1) * vector->itemSize, vector->itemSize);
+}
+
+
+void* Vector_at(const Vector* vector, const u64 index) {
+    // Return NULL if index is out of range.
+    if (index >= vector->count) {
+        return NULL;
+    }
+    return vector->data + index * vector->itemSize;
+}
+
+
+void Vector_remove_at(Vector* vector, const u64 index) {
+    if (index >= vector->count) {
+        return;
+    }
+
+    u8* item = vector->data + index * vector->itemSize;
+    memmove(item, item + vector->itemSize, (vector->count - index - 1) * vector->itemSize);
+    --vector->count;
+}
+
+
+void Vector_remove_at_swap(Vector* vector, const u64 index) {
+    if (index >= vector->count) {
+        return;
+    }
+
+    --vector->count;
+    if (index != vector->count) {
+        memcpy(vector->data + index * vector->itemSize, vector->data + vector->count * vector->itemSize, vector->itemSize);
+    }
+}
+#endif
@@ -0,0 +1,283 @@
+#include "glad/glad.h"
+
+#include "math.h"
+#include "float.h"
+
+#include "engine_core/engine_types.h"
+#include "engine_core/arena.h"
+#include "engine/math.h"
+#include "engine/culling.h"
+
+#ifdef ENGINE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+const Bounds BOUNDS_INFINITE = {
+    { -FLT_MAX, -FLT_MAX, -FLT_MAX },
+    { FLT_MAX, FLT_MAX, FLT_MAX },
+    { 0.0f, 0.0f, 0.0f },
+    INFINITY
+};
+
+
+void Frustum_from_matrix(const mat4 viewProjection, Frustum* out) {
+    const GLfloat* m = viewProjection;
+
+    // A point is inside when -w <= x, y, z <= w in clip space, so each plane is the w row plus or minus the x, y or z row.
+    // Matrices are column major, so row r is m[r], m[4 + r], m[8 + r], m[12 + r].
+    for (u32 i = 0; i < 6; ++i) {
+        u32 row = i / 2;
+        GLfloat sign = (i % 2) ? -1.0f : 1.0f;
+        GLfloat* plane = out->planes[i];
+
+        plane[0] = m[3] + sign * m[row];
+        plane[1] = m[7] + sign * m[4 + row];
+        plane[2] = m[11] + sign * m[8 + row];
+        plane[3] = m[15] + sign * m[12 + row];
+
+        // Unit normals, so the distance to a plane can be compared with a radius.
+        GLfloat length = sqrtf(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (length > 0.0f) {
+            plane[0] /= length;
+            plane[1] /= length;
+            plane[2] /= length;
+            plane[3] /= length;
+        }
+    }
+}
+
+
+void Bounds_from_points(const GLfloat* points, const u64 count, Bounds* out) {
+    vec3 min = { 0.0f, 0.0f, 0.0f };
+    vec3 max = { 0.0f, 0.0f, 0.0f };
+
+    if (count) {
+        vec3_copy(points, min);
+        vec3_copy(points, max);
+    }
+
+    for (u64 i = 1; i < count; ++i) {
+        const GLfloat* point = points + 3 * i;
+        for (u32 axis = 0; axis < 3; ++axis) {
+            min[axis] = (point[axis] < min[axis]) ? point[axis] : min[axis];
+            max[axis] = (point[axis] > max[axis]) ? point[axis] : max[axis];
+        }
+    }
+
+    vec3_copy(min, out->min);
+    vec3_copy(max, out->max);
+    out->center[0] = (min[0] + max[0]) * 0.5f;
+    out->center[1] = (min[1] + max[1]) * 0.5f;
+    out->center[2] = (min[2] + max[2]) * 0.5f;
+
+    // The farthest point from the center of the box, which is usually a lot closer than the box's corners.
+    GLfloat radiusSquared = 0.0f;
+    for (u64 i = 0; i < count; ++i) {
+        const GLfloat* point = points + 3 * i;
+        vec3 offset = vec3_def_sub(point, out->center);
+        GLfloat distanceSquared = vec3_dot(offset, offset);
+        radiusSquared = (distanceSquared > radiusSquared) ? distanceSquared : radiusSquared;
+    }
+    out->radius = sqrtf(radiusSquared);
+}
+
+
+void Bounds_transform(const Bounds* bounds, const mat4 transform, Bounds* out) {
+    const GLfloat* m = transform;
+
+    if (isinf(bounds->radius)) {
+        *out = *bounds;
+        return;
+    }
+
+    vec3 boxCenter = { (bounds->min[0] + bounds->max[0]) * 0.5f, (bounds->min[1] + bounds->max[1]) * 0.5f, (bounds->min[2] + bounds->max[2]) * 0.5f };
+    vec3 extent = { bounds->max[0] - boxCenter[0], bounds->max[1] - boxCenter[1], bounds->max[2] - boxCenter[2] };
+    vec3 sphereCenter = vec3_def_copy(bounds->center);
+
+    // Each world axis of the new box reaches as far as the transformed local axes can add up to along it.
+    for (u32 axis = 0; axis < 3; ++axis) {
+        GLfloat center = boxCenter[0] * m[axis] + boxCenter[1] * m[4 + axis] + boxCenter[2] * m[8 + axis] + m[12 + axis];
+        GLfloat reach = fabsf(m[axis]) * extent[0] + fabsf(m[4 + axis]) * extent[1] + fabsf(m[8 + axis]) * extent[2];
+
+        out->min[axis] = center - reach;
+        out->max[axis] = center + reach;
+        out->center[axis] = sphereCenter[0] * m[axis] + sphereCenter[1] * m[4 + axis] + sphereCenter[2] * m[8 + axis] + m[12 + axis];
+    }
+
+    GLfloat scaleX = m[0] * m[0] + m[1] * m[1] + m[2] * m[2];
+    GLfloat scaleY = m[4] * m[4] + m[5] * m[5] + m[6] * m[6];
+    GLfloat scaleZ = m[8] * m[8] + m[9] * m[9] + m[10] * m[10];
+    GLfloat scale = (scaleX > scaleY) ? scaleX : scaleY;
+    scale = (scaleZ > scale) ? scaleZ : scale;
+    out->radius = bounds->radius * sqrtf(scale);
+}
+
+
+u64 internal_Frustum_cull_spheres_scalar(const Frustum* frustum, const u64 start, const u64 count, const vec3_soa centers, const GLfloat* radii, u32* outVisible) {
+    u64 visible = 0;
+
+    for (u64 i = start; i < count; ++i) {
+        bool inside = true;
+        for (u32 p = 0; p < 6 && inside; ++p) {
+            const GLfloat* plane = frustum->planes[p];
+            inside = plane[0] * centers.x[i] + plane[1] * centers.y[i] + plane[2] * centers.z[i] + plane[3] + radii[i] >= 0.0f;
+        }
+
+        if (inside) {
+            outVisible[visible++] = (u32)i;
+        }
+    }
+    return visible;
+}
+
+
+u64 internal_Frustum_cull_aabbs_scalar(const Frustum* frustum, const u64 start, const u64 count, const vec3_soa mins, const vec3_soa maxs, u32* outVisible) {
+    u64 visible = 0;
+
+    // Only the corner furthest along a plane's normal has to be inside it.
+    for (u64 i = start; i < count; ++i) {
+        bool inside = true;
+        for (u32 p = 0; p < 6 && inside; ++p) {
+            const GLfloat* plane = frustum->planes[p];
+            GLfloat x = (plane[0] >= 0.0f) ? maxs.x[i] : mins.x[i];
+            GLfloat y = (plane[1] >= 0.0f) ? maxs.y[i] : mins.y[i];
+            GLfloat z = (plane[2] >= 0.0f) ? maxs.z[i] : mins.z[i];
+            inside = plane[0] * x + plane[1] * y + plane[2] * z + plane[3] >= 0.0f;
+        }
+
+        if (inside) {
+            outVisible[visible++] = (u32)i;
+        }
+    }
+    return visible;
+}
+
+
+u64 Frustum_cull_spheres(const Frustum* frustum, const u64 count, const vec3_soa centers, const GLfloat* radii, u32* outVisible) {
+    u64 visible = 0;
+    u64 i = 0;
+
+#ifdef ENGINE_USE_SSE2
+    // 4 spheres a time, one per lane. Stops testing planes once all 4 are outside one.
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(centers.x + i);
+        __m128 y = _mm_loadu_ps(centers.y + i);
+        __m128 z = _mm_loadu_ps(centers.z + i);
+        __m128 radius = _mm_loadu_ps(radii + i);
+        u32 mask = 0xF;
+
+        for (u32 p = 0; p < 6 && mask; ++p) {
+            const GLfloat* plane = frustum->planes[p];
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(plane[0]), x),
+                _mm_mul_ps(_mm_set1_ps(plane[1]), y)),
+                _mm_mul_ps(_mm_set1_ps(plane[2]), z)),
+                _mm_set1_ps(plane[3])),
+                radius);
+            mask &= (u32)_mm_movemask_ps(_mm_cmpge_ps(distance, zero));
+        }
+
+        for (u32 lane = 0; lane < 4; ++lane) {
+            if (mask & (1u << lane)) {
+                outVisible[visible++] = (u32)(i + lane);
+            }
+        }
+    }
+#endif
+
+    return visible + internal_Frustum_cull_spheres_scalar(frustum, i, count, centers, radii, outVisible + visible);
+}
+
+
+u64 Frustum_cull_aabbs(const Frustum* frustum, const u64 count, const vec3_soa mins, const vec3_soa maxs, u32* outVisible) {
+    u64 visible = 0;
+    u64 i = 0;
+
+#ifdef ENGINE_USE_SSE2
+    // The plane is the same for every lane, so picking the corner is picking which array to load from.
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        u32 mask = 0xF;
+
+        for (u32 p = 0; p < 6 && mask; ++p) {
+            const GLfloat* plane = frustum->planes[p];
+            __m128 x = _mm_loadu_ps(((plane[0] >= 0.0f) ? maxs.x : mins.x) + i);
+            __m128 y = _mm_loadu_ps(((plane[1] >= 0.0f) ? maxs.y : mins.y) + i);
+            __m128 z = _mm_loadu_ps(((plane[2] >= 0.0f) ? maxs.z : mins.z) + i);
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(plane[0]), x),
+                _mm_mul_ps(_mm_set1_ps(plane[1]), y)),
+                _mm_mul_ps(_mm_set1_ps(plane[2]), z)),
+                _mm_set1_ps(plane[3]));
+            mask &= (u32)_mm_movemask_ps(_mm_cmpge_ps(distance, zero));
+        }
+
+        for (u32 lane = 0; lane < 4; ++lane) {
+            if (mask & (1u << lane)) {
+                outVisible[visible++] = (u32)(i + lane);
+            }
+        }
+    }
+#endif
+
+    return visible + internal_Frustum_cull_aabbs_scalar(frustum, i, count, mins, maxs, outVisible + visible);
+}
+
+
+u64 Frustum_cull_bounds(const Frustum* frustum, const u64 count, const Bounds* const* bounds, const GLfloat* const* transforms, u32* outVisible) {
+    // World space bounds as structure of arrays: sphere centers, radii, box mins and box maxes.
+    ArenaScope scratch = Scratch_begin();
+    GLfloat* values = Scratch_push(GLfloat, count * 10 + 1);
+    vec3_soa centers = { values, values + count, values + 2 * count };
+    GLfloat* radii = values + 3 * count;
+    vec3_soa mins = { values + 4 * count, values + 5 * count, values + 6 * count };
+    vec3_soa maxs = { values + 7 * count, values + 8 * count, values + 9 * count };
+    u32* spheresVisible = Scratch_push(u32, count + 1);
+
+    for (u64 i = 0; i < count; ++i) {
+        Bounds world;
+
+        if (transforms[i]) {
+            Bounds_transform(bounds[i], transforms[i], &world);
+        }
+
+        else {
+            world = *bounds[i];
+        }
+
+        centers.x[i] = world.center[0];
+        centers.y[i] = world.center[1];
+        centers.z[i] = world.center[2];
+        radii[i] = world.radius;
+        mins.x[i] = world.min[0];
+        mins.y[i] = world.min[1];
+        mins.z[i] = world.min[2];
+        maxs.x[i] = world.max[0];
+        maxs.y[i] = world.max[1];
+        maxs.z[i] = world.max[2];
+    }
+
+    u64 sphereCount = Frustum_cull_spheres(frustum, count, centers, radii, spheresVisible);
+
+    // Pack the boxes that passed to the front, then test those. spheresVisible is in order, so nothing is overwritten before it
+    // is read.
+    for (u64 i = 0; i < sphereCount; ++i) {
+        u32 from = spheresVisible[i];
+        mins.x[i] = mins.x[from];
+        mins.y[i] = mins.y[from];
+        mins.z[i] = mins.z[from];
+        maxs.x[i] = maxs.x[from];
+        maxs.y[i] = maxs.y[from];
+        maxs.z[i] = maxs.z[from];
+    }
+
+    // The box test gives indices into the packed boxes. Turn them back into indices into bounds.
+    u64 boxCount = Frustum_cull_aabbs(frustum, sphereCount, mins, maxs, outVisible);
+    for (u64 i = 0; i < boxCount; ++i) {
+        outVisible[i] = spheresVisible[outVisible[i]];
+    }
+
+    Scratch_end(scratch);
+    return boxCount;
+}
@@ -5,6 +5,13 @@
 
 #include "engine_core/configuation.h"
 #include "engine_core/engine_error.h"
+#include "engine_core/string.h"
+#include "engine_core/string_id.h"
+#include "engine_core/arena.h"
+#include "engine_core/memory.h"
+#include "engine_core/job.h"
+#include "engine/math.h"
+#include "engine/object.h"
 #include "engine/engine.h"
 
 
@@ -122,6 +129,13 @@ bool Engine_initialize(const int width, const int height, const char* tittle) {
     glFrontFace(GL_CCW);
 
     List_initialize(Function_Errorcode_NoParam, &(frame.TerminationFunctions), 16);
+    StringId_initialize();
+    Arenas_initialize();
+
+    // Pick the kernels before there are workers, so no two threads race to fill in the tables on first use.
+    String_select_scan(STRING_SCAN_AVX2);
+    Math_select_kernels(MATH_KERNELS_AVX2);
+    Jobs_initialize(0);
 
     frame.rawInputAvailable = glfwRawMouseMotionSupported();
 
@@ -148,7 +162,16 @@ void Engine_terminate () {
 
     }
 
+    Jobs_deinitialize();
     List_deinitialize(&(frame.TerminationFunctions));
+    StringId_deinitialize();
+    Arenas_deinitialize();
+    ObjectPools_deinitialize();
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+    // Anything still live here was never freed.
+    Memory_report();
+#endif
 }
 
 
@@ -178,6 +201,10 @@ void PollEvents () {
 }
 
 bool Engine_execute_tick () {
+    // Everything allocated from FrameArena last frame is released here.
+    Arenas_reset_frame();
+    Memory_begin_frame();
+
     glfwSwapBuffers(frame.ActiveWindow);
     PollEvents();
 
@@ -195,6 +222,9 @@ bool Engine_execute_tick () {
 
     InitializeFrame();
 
+    // OpenGL work that jobs queued for the main thread since the last frame.
+    Jobs_run_main();
+
     if (IsKeyPressed(GLFW_KEY_ESCAPE)) {
         glfwSetWindowShouldClose(frame.ActiveWindow, true);
     }
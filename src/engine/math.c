@@ -5,6 +5,36 @@
 #include "engine_core/engine_types.h"
 #include "engine/math.h"
 
+#ifdef ENGINE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+// The kernels behind mat4_multiply, mat4_inverse, mat4_from_quaternion and the batch functions. See Math_select_kernels.
+typedef struct internal_MathKernels {
+    void (*mat4_multiply) (const mat4 left, const mat4 right, mat4 out);
+    void (*mat4_inverse) (const mat4 m, mat4 out);
+    void (*mat4_from_quaternion) (const quaternion q, mat4 out);
+    void (*mat4_multiply_batch) (const u64 count, const mat4* left, const mat4* right, mat4* out);
+    void (*vec3_transform_points_soa) (const mat4 m, const u64 count, const vec3_soa points, const vec3_soa out);
+    void (*quaternion_to_mat4_batch) (const u64 count, const quaternion_soa q, mat4* out);
+} internal_MathKernels;
+
+void internal_mat4_multiply_select (const mat4 left, const mat4 right, mat4 out);
+void internal_mat4_inverse_select (const mat4 m, mat4 out);
+void internal_mat4_from_quaternion_select (const quaternion q, mat4 out);
+void internal_mat4_multiply_batch_select (const u64 count, const mat4* left, const mat4* right, mat4* out);
+void internal_vec3_transform_points_soa_select (const mat4 m, const u64 count, const vec3_soa points, const vec3_soa out);
+void internal_quaternion_to_mat4_batch_select (const u64 count, const quaternion_soa q, mat4* out);
+
+static internal_MathKernels internal_Math_kernels = {
+    internal_mat4_multiply_select,
+    internal_mat4_inverse_select,
+    internal_mat4_from_quaternion_select,
+    internal_mat4_multiply_batch_select,
+    internal_vec3_transform_points_soa_select,
+    internal_quaternion_to_mat4_batch_select
+};
+
 // GL TYPE CONSTANT DEFINITIONS:
 //
 //
@@ -244,6 +274,7 @@ void vec3_rotate_axis(const vec3 v, const vec3 axis, double angle, vec3 out) {
 }
 
 void vec3_rotate(const vec3 v, const quaternion q, vec3 out) {
+    // Not one of the kernels. An SSE2 version spends more building the rotation's columns than it saves on 3 multiplies.
     vec3 result = {
         v[0] * (q[0] * q[0] + q[3] * q[3] - q[1] * q[1] - q[2] * q[2]) + v[1] * (2 * q[0] * q[1] - 2 * q[3] * q[2]) + v[2] * (2 * q[0] * q[2] + 2 * q[3] * q[1]),
         v[0] * (2 * q[3] * q[2] + 2 * q[0] * q[1]) + v[1] * (q[3] * q[3] - q[0] * q[0] + q[1] * q[1] - q[2] * q[2]) + v[2] * (-2 * q[3] * q[0] + 2 * q[1] * q[2]),
@@ -284,6 +315,10 @@ void quaternion_multiply (const quaternion left, const quaternion right, quatern
 }
 
 void mat4_from_quaternion (const quaternion q, mat4 out) {
+    internal_Math_kernels.mat4_from_quaternion(q, out);
+}
+
+void internal_mat4_from_quaternion_scalar (const quaternion q, mat4 out) {
     float a2 = q[0] * q[0];
     float b2 = q[1] * q[1];
     float c2 = q[2] * q[2];
@@ -305,6 +340,24 @@ void mat4_from_quaternion (const quaternion q, mat4 out) {
 }
 
 
+void mat4_from_trs (const vec3 translation, const quaternion rotation, const vec3 scale, mat4 out) {
+    mat4 result;
+    mat4_from_quaternion(rotation, result);
+
+    // Same as translation * rotation * scale, without the two multiplies: scale each rotated axis, then set the translation.
+    for (u32 i = 0; i < 3; ++i) {
+        result[4 * i] *= scale[i];
+        result[4 * i + 1] *= scale[i];
+        result[4 * i + 2] *= scale[i];
+    }
+    result[12] = translation[0];
+    result[13] = translation[1];
+    result[14] = translation[2];
+
+    mat4_copy(result, out);
+}
+
+
 void mat4_multi_multiply (u64 count, ... ) {
     va_list args;
     va_start(args, count);
@@ -324,6 +377,10 @@ void mat4_multi_multiply (u64 count, ... ) {
 
 
 void mat4_multiply (const mat4 left, const mat4 right, mat4 out) {
+    internal_Math_kernels.mat4_multiply(left, right, out);
+}
+
+void internal_mat4_multiply_scalar (const mat4 left, const mat4 right, mat4 out) {
     mat4 result = {
         left[0] * right[0] + left[1] * right[4] + left[2] * right[8] + left[3] * right[12],
         left[0] * right[1] + left[1] * right[5] + left[2] * right[9] + left[3] * right[13],
@@ -418,6 +475,10 @@ float mat4_determinant(const mat4 m) {
 }
 
 void mat4_inverse(const mat4 m, mat4 out) {
+    internal_Math_kernels.mat4_inverse(m, out);
+}
+
+void internal_mat4_inverse_scalar (const mat4 m, mat4 out) {
     float b00 = m[0] * m[5] - m[4] * m[1];
     float b01 = m[0] * m[9] - m[8] * m[1];
     float b02 = m[0] * m[13] - m[12] * m[1];
@@ -519,3 +580,379 @@ void mat4_projection_orthographic (const double left, const double right, const
 
     mat4_copy(result, out);
 }
+
+// BATCHES:
+//
+//
+
+#define internal_vec3_soa_offset(soa, offset) ((vec3_soa){ (soa).x + (offset), (soa).y + (offset), (soa).z + (offset) })
+#define internal_quaternion_soa_offset(soa, offset) ((quaternion_soa){ (soa).x + (offset), (soa).y + (offset), (soa).z + (offset), (soa).w + (offset) })
+
+void mat4_multiply_batch (const u64 count, const mat4* left, const mat4* right, mat4* out) {
+    internal_Math_kernels.mat4_multiply_batch(count, left, right, out);
+}
+
+void vec3_transform_points_soa (const mat4 m, const u64 count, const vec3_soa points, const vec3_soa out) {
+    internal_Math_kernels.vec3_transform_points_soa(m, count, points, out);
+}
+
+void quaternion_to_mat4_batch (const u64 count, const quaternion_soa q, mat4* out) {
+    internal_Math_kernels.quaternion_to_mat4_batch(count, q, out);
+}
+
+void internal_mat4_multiply_batch_scalar (const u64 count, const mat4* left, const mat4* right, mat4* out) {
+    for (u64 i = 0; i < count; ++i) {
+        internal_mat4_multiply_scalar(left[i], right[i], out[i]);
+    }
+}
+
+void internal_vec3_transform_points_soa_scalar (const mat4 m, const u64 count, const vec3_soa points, const vec3_soa out) {
+    for (u64 i = 0; i < count; ++i) {
+        GLfloat x = points.x[i];
+        GLfloat y = points.y[i];
+        GLfloat z = points.z[i];
+
+        out.x[i] = x * m[0] + y * m[4] + z * m[8] + m[12];
+        out.y[i] = x * m[1] + y * m[5] + z * m[9] + m[13];
+        out.z[i] = x * m[2] + y * m[6] + z * m[10] + m[14];
+    }
+}
+
+void internal_quaternion_to_mat4_batch_scalar (const u64 count, const quaternion_soa q, mat4* out) {
+    for (u64 i = 0; i < count; ++i) {
+        quaternion element = { q.x[i], q.y[i], q.z[i], q.w[i] };
+        internal_mat4_from_quaternion_scalar(element, out[i]);
+    }
+}
+
+// SIMD KERNELS:
+//
+// Every kernel works on whole rows of 4 floats with broadcast, multiply, add, shuffle and sign flips, and does the same 
+// operations in the same order as the scalar version, so without FMA contraction the results match it bit for bit. The same 
+// steps map one to one onto NEON (vdupq_n_f32, vmulq_f32, vaddq_f32, vextq_f32 and veorq_u32), so an ARM path is a copy of 
+// this block with the intrinsics swapped.
+//
+
+#ifdef ENGINE_USE_SSE2
+
+// Shuffle lanes in reading order: the first two come from a, the last two from b.
+#define internal_Math_shuffle(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+#define internal_Math_sign(x, y, z, w) _mm_setr_ps(x ? -0.0f : 0.0f, y ? -0.0f : 0.0f, z ? -0.0f : 0.0f, w ? -0.0f : 0.0f)
+
+void internal_mat4_multiply_sse2 (const mat4 left, const mat4 right, mat4 out) {
+    __m128 r0 = _mm_loadu_ps(right);
+    __m128 r1 = _mm_loadu_ps(right + 4);
+    __m128 r2 = _mm_loadu_ps(right + 8);
+    __m128 r3 = _mm_loadu_ps(right + 12);
+    __m128 rows[4];
+
+    // Row i of the result is left[i][0] * r0 + left[i][1] * r1 + left[i][2] * r2 + left[i][3] * r3. Every row is done before the 
+    // first store, so out may be left or right.
+    for (u32 i = 0; i < 4; ++i) {
+        const GLfloat* l = left + 4 * i;
+        rows[i] = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(_mm_set1_ps(l[0]), r0), 
+            _mm_mul_ps(_mm_set1_ps(l[1]), r1)), 
+            _mm_mul_ps(_mm_set1_ps(l[2]), r2)), 
+            _mm_mul_ps(_mm_set1_ps(l[3]), r3));
+    }
+
+    _mm_storeu_ps(out, rows[0]);
+    _mm_storeu_ps(out + 4, rows[1]);
+    _mm_storeu_ps(out + 8, rows[2]);
+    _mm_storeu_ps(out + 12, rows[3]);
+}
+
+__m128 internal_mat4_inverse_row_sse2 (const __m128 c, const __m128 ka, const __m128 kb, const __m128 kc) {
+    // One row of the adjugate: c[1] * ka[0] + c[2] * kb[0] + c[3] * kc[0] in lane 0, and so on, skipping c[lane] each time.
+    return _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(internal_Math_shuffle(c, c, 1, 0, 0, 0), ka), 
+        _mm_mul_ps(internal_Math_shuffle(c, c, 2, 2, 1, 1), kb)), 
+        _mm_mul_ps(internal_Math_shuffle(c, c, 3, 3, 3, 2), kc));
+}
+
+void internal_mat4_inverse_sse2 (const mat4 m, mat4 out) {
+    __m128 c0 = _mm_loadu_ps(m);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    // The 2x2 determinants b00 to b11 of the scalar version, 4 at a time.
+    __m128 a = _mm_sub_ps(
+        _mm_mul_ps(internal_Math_shuffle(c0, c0, 0, 0, 0, 1), internal_Math_shuffle(c1, c1, 1, 2, 3, 2)), 
+        _mm_mul_ps(internal_Math_shuffle(c0, c0, 1, 2, 3, 2), internal_Math_shuffle(c1, c1, 0, 0, 0, 1)));
+    __m128 b = _mm_sub_ps(
+        _mm_mul_ps(internal_Math_shuffle(c0, c2, 1, 2, 0, 0), internal_Math_shuffle(c1, c3, 3, 3, 1, 2)), 
+        _mm_mul_ps(internal_Math_shuffle(c0, c2, 3, 3, 1, 2), internal_Math_shuffle(c1, c3, 1, 2, 0, 0)));
+    __m128 c = _mm_sub_ps(
+        _mm_mul_ps(internal_Math_shuffle(c2, c2, 0, 1, 1, 2), internal_Math_shuffle(c3, c3, 3, 2, 3, 3)), 
+        _mm_mul_ps(internal_Math_shuffle(c2, c2, 3, 2, 3, 3), internal_Math_shuffle(c3, c3, 0, 1, 1, 2)));
+
+    GLfloat d[12];
+    _mm_storeu_ps(d, a);
+    _mm_storeu_ps(d + 4, b);
+    _mm_storeu_ps(d + 8, c);
+    __m128 invDet = _mm_set1_ps(1.0f / (d[0] * d[11] - d[1] * d[10] + d[2] * d[9] + d[3] * d[8] - d[4] * d[7] + d[5] * d[6]));
+
+    // Rows 0 and 1 use b06 to b11, rows 2 and 3 use b00 to b05, with the signs of the cofactors folded in.
+    const __m128 oddSigns = internal_Math_sign(0, 1, 0, 1);
+    const __m128 evenSigns = internal_Math_sign(1, 0, 1, 0);
+    const __m128 allSigns = internal_Math_sign(1, 1, 1, 1);
+
+    __m128 ka = _mm_xor_ps(internal_Math_shuffle(c, c, 3, 3, 2, 1), oddSigns);
+    __m128 kb = _mm_xor_ps(internal_Math_shuffle(c, internal_Math_shuffle(c, b, 0, 0, 3, 3), 2, 0, 0, 2), evenSigns);
+    __m128 kc = _mm_xor_ps(internal_Math_shuffle(internal_Math_shuffle(c, b, 1, 1, 3, 2), b, 0, 2, 2, 2), oddSigns);
+    __m128 row0 = internal_mat4_inverse_row_sse2(c1, ka, kb, kc);
+    __m128 row1 = internal_mat4_inverse_row_sse2(_mm_xor_ps(c0, allSigns), ka, kb, kc);
+
+    ka = _mm_xor_ps(internal_Math_shuffle(b, internal_Math_shuffle(b, a, 0, 0, 3, 3), 1, 1, 0, 2), oddSigns);
+    kb = _mm_xor_ps(internal_Math_shuffle(internal_Math_shuffle(b, a, 0, 0, 2, 2), a, 0, 2, 2, 1), evenSigns);
+    kc = _mm_xor_ps(internal_Math_shuffle(a, a, 3, 1, 0, 0), oddSigns);
+    __m128 row2 = internal_mat4_inverse_row_sse2(c3, ka, kb, kc);
+    __m128 row3 = internal_mat4_inverse_row_sse2(_mm_xor_ps(c2, allSigns), ka, kb, kc);
+
+    _mm_storeu_ps(out, _mm_mul_ps(row0, invDet));
+    _mm_storeu_ps(out + 4, _mm_mul_ps(row1, invDet));
+    _mm_storeu_ps(out + 8, _mm_mul_ps(row2, invDet));
+    _mm_storeu_ps(out + 12, _mm_mul_ps(row3, invDet));
+}
+
+void internal_quaternion_rows_sse2 (const __m128 q, __m128* outSquares, __m128 outRows[3]) {
+    // The products of the scalar mat4_from_quaternion, a2 = q[0] * q[0], ab = q[0] * q[1], ad = q[3] * q[0] and so on, paired 
+    // up so that lane j of row i holds the two terms of entry (i, j) added together, before the factor of 2.
+    __m128 x = _mm_mul_ps(q, q);                                                                     // a2 b2 c2 d2
+    __m128 p = _mm_mul_ps(internal_Math_shuffle(q, q, 0, 0, 1, 1), internal_Math_shuffle(q, q, 1, 2, 2, 2)); // ab ac bc bc
+    __m128 r = _mm_mul_ps(internal_Math_shuffle(q, q, 3, 3, 3, 3), q);                              // ad bd cd dd
+
+    __m128 u0 = internal_Math_shuffle(internal_Math_shuffle(x, p, 1, 1, 0, 0), p, 0, 2, 1, 1);
+    __m128 v0 = internal_Math_shuffle(x, r, 2, 2, 2, 1);
+    v0 = _mm_xor_ps(internal_Math_shuffle(v0, v0, 0, 2, 3, 3), internal_Math_sign(0, 0, 1, 0));
+    __m128 u1 = internal_Math_shuffle(internal_Math_shuffle(p, x, 0, 0, 0, 0), p, 0, 2, 2, 2);
+    __m128 v1 = _mm_xor_ps(internal_Math_shuffle(internal_Math_shuffle(r, x, 2, 2, 2, 2), r, 0, 2, 0, 0), internal_Math_sign(1, 0, 0, 0));
+    __m128 u2 = internal_Math_shuffle(p, x, 1, 2, 0, 0);
+    __m128 v2 = _mm_xor_ps(internal_Math_shuffle(r, x, 1, 0, 1, 1), internal_Math_sign(0, 1, 0, 0));
+
+    *outSquares = x;
+    outRows[0] = _mm_add_ps(u0, v0);    // b2 + c2, ab + cd, ac - bd
+    outRows[1] = _mm_add_ps(u1, v1);    // ab - cd, a2 + c2, bc + ad
+    outRows[2] = _mm_add_ps(u2, v2);    // ac + bd, bc - ad, a2 + b2
+}
+
+void internal_mat4_from_quaternion_sse2 (const quaternion q, mat4 out) {
+    __m128 squares;
+    __m128 rows[3];
+    internal_quaternion_rows_sse2(_mm_loadu_ps(q), &squares, rows);
+
+    // 1 - 2 * sum on the diagonal, 2 * sum off it, 0 in the last column.
+    _mm_storeu_ps(out, _mm_add_ps(_mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f), _mm_mul_ps(_mm_setr_ps(-2.0f, 2.0f, 2.0f, 0.0f), rows[0])));
+    _mm_storeu_ps(out + 4, _mm_add_ps(_mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f), _mm_mul_ps(_mm_setr_ps(2.0f, -2.0f, 2.0f, 0.0f), rows[1])));
+    _mm_storeu_ps(out + 8, _mm_add_ps(_mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f), _mm_mul_ps(_mm_setr_ps(2.0f, 2.0f, -2.0f, 0.0f), rows[2])));
+    _mm_storeu_ps(out + 12, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+void internal_vec3_transform_points_soa_sse2 (const mat4 m, const u64 count, const vec3_soa points, const vec3_soa out) {
+    const __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+    const __m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m6 = _mm_set1_ps(m[6]);
+    const __m128 m8 = _mm_set1_ps(m[8]), m9 = _mm_set1_ps(m[9]), m10 = _mm_set1_ps(m[10]);
+    const __m128 m12 = _mm_set1_ps(m[12]), m13 = _mm_set1_ps(m[13]), m14 = _mm_set1_ps(m[14]);
+    u64 i = 0;
+
+    // 4 points a time, one per lane.
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(points.x + i);
+        __m128 y = _mm_loadu_ps(points.y + i);
+        __m128 z = _mm_loadu_ps(points.z + i);
+
+        _mm_storeu_ps(out.x + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m0), _mm_mul_ps(y, m4)), _mm_mul_ps(z, m8)), m12));
+        _mm_storeu_ps(out.y + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m1), _mm_mul_ps(y, m5)), _mm_mul_ps(z, m9)), m13));
+        _mm_storeu_ps(out.z + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m2), _mm_mul_ps(y, m6)), _mm_mul_ps(z, m10)), m14));
+    }
+
+    internal_vec3_transform_points_soa_scalar(m, count - i, internal_vec3_soa_offset(points, i), internal_vec3_soa_offset(out, i));
+}
+
+void internal_quaternion_to_mat4_batch_sse2 (const u64 count, const quaternion_soa q, mat4* out) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 lastRow = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+    u64 i = 0;
+
+    // 4 quaternions a time, one per lane, with the same products as mat4_from_quaternion. Each entry of the 3x3 part ends up in
+    // its own register, so a transpose turns them into rows of 4 matrices.
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(q.x + i);
+        __m128 y = _mm_loadu_ps(q.y + i);
+        __m128 z = _mm_loadu_ps(q.z + i);
+        __m128 w = _mm_loadu_ps(q.w + i);
+
+        __m128 a2 = _mm_mul_ps(x, x), b2 = _mm_mul_ps(y, y), c2 = _mm_mul_ps(z, z);
+        __m128 ac = _mm_mul_ps(x, z), ab = _mm_mul_ps(x, y), bc = _mm_mul_ps(y, z);
+        __m128 ad = _mm_mul_ps(w, x), bd = _mm_mul_ps(w, y), cd = _mm_mul_ps(w, z);
+
+        __m128 rows[3][4] = {
+            { _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(b2, c2))), _mm_mul_ps(two, _mm_add_ps(ab, cd)), _mm_mul_ps(two, _mm_sub_ps(ac, bd)), zero },
+            { _mm_mul_ps(two, _mm_sub_ps(ab, cd)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(a2, c2))), _mm_mul_ps(two, _mm_add_ps(bc, ad)), zero },
+            { _mm_mul_ps(two, _mm_add_ps(ac, bd)), _mm_mul_ps(two, _mm_sub_ps(bc, ad)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(a2, b2))), zero },
+        };
+
+        for (u32 row = 0; row < 3; ++row) {
+            _MM_TRANSPOSE4_PS(rows[row][0], rows[row][1], rows[row][2], rows[row][3]);
+            for (u32 j = 0; j < 4; ++j) {
+                _mm_storeu_ps(out[i + j] + 4 * row, rows[row][j]);
+            }
+        }
+        for (u32 j = 0; j < 4; ++j) {
+            _mm_storeu_ps(out[i + j] + 12, lastRow);
+        }
+    }
+
+    internal_quaternion_to_mat4_batch_scalar(count - i, internal_quaternion_soa_offset(q, i), out + i);
+}
+
+#endif
+
+#ifdef ENGINE_USE_AVX2_DISPATCH
+
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define internal_Math_avx2 __attribute__((target("avx2")))
+#else
+#define internal_Math_avx2
+#endif
+
+internal_Math_avx2 void internal_mat4_multiply_avx2 (const mat4 left, const mat4 right, mat4 out) {
+    // Two rows of the result at once: each 128 bit half of a register is one row, as in the SSE2 version.
+    __m256 r0 = _mm256_broadcast_ps((const __m128*)right);
+    __m256 r1 = _mm256_broadcast_ps((const __m128*)(right + 4));
+    __m256 r2 = _mm256_broadcast_ps((const __m128*)(right + 8));
+    __m256 r3 = _mm256_broadcast_ps((const __m128*)(right + 12));
+    __m256 l01 = _mm256_loadu_ps(left);
+    __m256 l23 = _mm256_loadu_ps(left + 8);
+
+    __m256 rows01 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+        _mm256_mul_ps(_mm256_permute_ps(l01, 0x00), r0), 
+        _mm256_mul_ps(_mm256_permute_ps(l01, 0x55), r1)), 
+        _mm256_mul_ps(_mm256_permute_ps(l01, 0xAA), r2)), 
+        _mm256_mul_ps(_mm256_permute_ps(l01, 0xFF), r3));
+    __m256 rows23 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+        _mm256_mul_ps(_mm256_permute_ps(l23, 0x00), r0), 
+        _mm256_mul_ps(_mm256_permute_ps(l23, 0x55), r1)), 
+        _mm256_mul_ps(_mm256_permute_ps(l23, 0xAA), r2)), 
+        _mm256_mul_ps(_mm256_permute_ps(l23, 0xFF), r3));
+
+    _mm256_storeu_ps(out, rows01);
+    _mm256_storeu_ps(out + 8, rows23);
+}
+
+internal_Math_avx2 void internal_mat4_multiply_batch_avx2 (const u64 count, const mat4* left, const mat4* right, mat4* out) {
+    // Still one matrix a time, two rows a register. One matrix a lane would need every left, right and out matrix transposed
+    // first, and that costs more shuffles than the broadcasts it saves, so there is no SSE2 batch: it was slower than scalar.
+    for (u64 i = 0; i < count; ++i) {
+        internal_mat4_multiply_avx2(left[i], right[i], out[i]);
+    }
+}
+
+internal_Math_avx2 void internal_vec3_transform_points_soa_avx2 (const mat4 m, const u64 count, const vec3_soa points, const vec3_soa out) {
+    const __m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+    const __m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]);
+    const __m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]);
+    const __m256 m12 = _mm256_set1_ps(m[12]), m13 = _mm256_set1_ps(m[13]), m14 = _mm256_set1_ps(m[14]);
+    u64 i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(points.x + i);
+        __m256 y = _mm256_loadu_ps(points.y + i);
+        __m256 z = _mm256_loadu_ps(points.z + i);
+
+        _mm256_storeu_ps(out.x + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m0), _mm256_mul_ps(y, m4)), _mm256_mul_ps(z, m8)), m12));
+        _mm256_storeu_ps(out.y + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m1), _mm256_mul_ps(y, m5)), _mm256_mul_ps(z, m9)), m13));
+        _mm256_storeu_ps(out.z + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m2), _mm256_mul_ps(y, m6)), _mm256_mul_ps(z, m10)), m14));
+    }
+
+    internal_vec3_transform_points_soa_sse2(m, count - i, internal_vec3_soa_offset(points, i), internal_vec3_soa_offset(out, i));
+}
+
+#endif
+
+u8 Math_select_kernels (u8 level) {
+    u8 selected = MATH_KERNELS_SCALAR;
+
+#ifdef ENGINE_USE_SSE2
+    if (level >= MATH_KERNELS_SSE2) {
+        selected = MATH_KERNELS_SSE2;
+    }
+#endif
+#ifdef ENGINE_USE_AVX2_DISPATCH
+    if (level >= MATH_KERNELS_AVX2 && Engine_cpu_has_avx2()) {
+        selected = MATH_KERNELS_AVX2;
+    }
+#endif
+
+    // Only mat4_multiply and the point transform have room for a wider version, the rest of the AVX2 level is SSE2. Only the
+    // AVX2 level has a mat4_multiply_batch of its own.
+    switch (selected) {
+#ifdef ENGINE_USE_AVX2_DISPATCH
+    case MATH_KERNELS_AVX2:
+        internal_Math_kernels.mat4_multiply = internal_mat4_multiply_avx2;
+        internal_Math_kernels.mat4_inverse = internal_mat4_inverse_sse2;
+        internal_Math_kernels.mat4_from_quaternion = internal_mat4_from_quaternion_sse2;
+        internal_Math_kernels.mat4_multiply_batch = internal_mat4_multiply_batch_avx2;
+        internal_Math_kernels.vec3_transform_points_soa = internal_vec3_transform_points_soa_avx2;
+        internal_Math_kernels.quaternion_to_mat4_batch = internal_quaternion_to_mat4_batch_sse2;
+        break;
+#endif
+#ifdef ENGINE_USE_SSE2
+    case MATH_KERNELS_SSE2:
+        internal_Math_kernels.mat4_multiply = internal_mat4_multiply_sse2;
+        internal_Math_kernels.mat4_inverse = internal_mat4_inverse_sse2;
+        internal_Math_kernels.mat4_from_quaternion = internal_mat4_from_quaternion_sse2;
+        internal_Math_kernels.mat4_multiply_batch = internal_mat4_multiply_batch_scalar;
+        internal_Math_kernels.vec3_transform_points_soa = internal_vec3_transform_points_soa_sse2;
+        internal_Math_kernels.quaternion_to_mat4_batch = internal_quaternion_to_mat4_batch_sse2;
+        break;
+#endif
+    default:
+        internal_Math_kernels.mat4_multiply = internal_mat4_multiply_scalar;
+        internal_Math_kernels.mat4_inverse = internal_mat4_inverse_scalar;
+        internal_Math_kernels.mat4_from_quaternion = internal_mat4_from_quaternion_scalar;
+        internal_Math_kernels.mat4_multiply_batch = internal_mat4_multiply_batch_scalar;
+        internal_Math_kernels.vec3_transform_points_soa = internal_vec3_transform_points_soa_scalar;
+        internal_Math_kernels.quaternion_to_mat4_batch = internal_quaternion_to_mat4_batch_scalar;
+        break;
+    }
+
+    return selected;
+}
+
+void internal_mat4_multiply_select (const mat4 left, const mat4 right, mat4 out) {
+    Math_select_kernels(MATH_KERNELS_AVX2);
+    internal_Math_kernels.mat4_multiply(left, right, out);
+}
+
+void internal_mat4_inverse_select (const mat4 m, mat4 out) {
+    Math_select_kernels(MATH_KERNELS_AVX2);
+    internal_Math_kernels.mat4_inverse(m, out);
+}
+
+void internal_mat4_from_quaternion_select (const quaternion q, mat4 out) {
+    Math_select_kernels(MATH_KERNELS_AVX2);
+    internal_Math_kernels.mat4_from_quaternion(q, out);
+}
+
+void internal_mat4_multiply_batch_select (const u64 count, const mat4* left, const mat4* right, mat4* out) {
+    Math_select_kernels(MATH_KERNELS_AVX2);
+    internal_Math_kernels.mat4_multiply_batch(count, left, right, out);
+}
+
+void internal_vec3_transform_points_soa_select (const mat4 m, const u64 count, const vec3_soa points, const vec3_soa out) {
+    Math_select_kernels(MATH_KERNELS_AVX2);
+    internal_Math_kernels.vec3_transform_points_soa(m, count, points, out);
+}
+
+void internal_quaternion_to_mat4_batch_select (const u64 count, const quaternion_soa q, mat4* out) {
+    Math_select_kernels(MATH_KERNELS_AVX2);
+    internal_Math_kernels.quaternion_to_mat4_batch(count, q, out);
+}
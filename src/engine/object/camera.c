@@ -35,6 +35,7 @@ Camera* Object_Camera_create() {
 
 void Object_Camera_destroy(void* camera) {
     OBJECT_DESTROY_BODY(camera);
+    OBJECT_FREE_BODY(camera);
 }
 
 
@@ -60,7 +61,7 @@ void Object_Camera_recalulate_view(Camera* camera) {
     //mat4_projection_orthographic(-5.0, 5.0, 5.0, -5.0, -5.0, 5.0, projection);
     mat4_projection_perspective(camera->Fov, AspectRatio(), camera->NearClip, camera->FarClip, projection);
 
-    mat4_multi_multiply(4, &camera->Transform, &rotation, &projection, &camera->ViewMatrix);
+    mat4_multi_multiply(4, Object_get_transform(camera), &rotation, &projection, &camera->ViewMatrix);
 
 }
 
@@ -117,10 +118,7 @@ u8 Object_Camera_update_noclip(void* object, const double deltaTime) {
     //vec3_add(camera->Velocity, Acceleration, camera->Velocity);
 
     vec3_copy(movement, camera->Velocity);
-
-    mat4 translation;
-    mat4_translate(camera->Velocity, translation);
-    mat4_multiply(camera->Transform, translation, camera->Transform);
+    Object_translate(camera, camera->Velocity);
 
     Object_Camera_recalulate_view(camera);
     return 0;
@@ -1,7 +1,10 @@
 #include "engine_core/engine_types.h"
 
 #include "engine_core/string.h"
+#include "engine_core/arena.h"
 #include "engine/object/mesh.h"
+#include "engine/object/camera.h"
+#include "engine/culling.h"
 
 #include "engine/shader/renderable.h"
 
@@ -31,6 +34,8 @@ void Object_StaticMesh_destroy(void* object) {
 
     List_deinitialize(&mesh->meshRenders);
     List_deinitialize(&mesh->materials);    // Materials are managed externally.
+
+    OBJECT_FREE_BODY(object);
 }
 
 
@@ -39,6 +44,7 @@ StaticMesh* Object_StaticMesh_create_empty(void* parent) {
 
     List_initialize(Material*, &object->materials, 1);
     List_initialize(MeshRender, &object->meshRenders, 1);
+    object->bounds = BOUNDS_INFINITE;
 
     Object_set_alias(object, "StaticMesh");
     object->Draw = Object_StaticMesh_Draw;
@@ -81,10 +87,79 @@ StaticMesh* Object_StaticMesh_create(const char* path, void* parent) {
 
 
 
+void internal_Object_StaticMesh_draw_at(StaticMesh* staticMesh, const GLfloat* transform) {
+    for (List_iterator(MeshRender, &staticMesh->meshRenders)) {
+        DrawRenderable(it, *(Material**)List_at(&staticMesh->materials, it->materialIndex), transform);
+    }
+}
+
+
 void Object_StaticMesh_Draw(void* object) {
     StaticMesh* staticMesh = (StaticMesh*)object;
-    for (List_iterator(MeshRender, &staticMesh->meshRenders)) {
-        DrawRenderable(it, *(Material**)List_at(&staticMesh->materials, it->materialIndex), staticMesh->Transform);
+    internal_Object_StaticMesh_draw_at(staticMesh, Object_get_transform(staticMesh));
+}
+
+
+void Object_StaticMesh_cull(const Scene* scene, const Camera* camera, StaticMesh** meshes, const u64 count, List* outVisible) {
+    Frustum frustum;
+    Frustum_from_matrix(camera->ViewMatrix, &frustum);
+
+    ArenaScope scratch = Scratch_begin();
+    const Bounds** bounds = Scratch_push(const Bounds*, count + 1);
+    const GLfloat** transforms = Scratch_push(const GLfloat*, count + 1);
+    u32* visible = Scratch_push(u32, count + 1);
+
+    for (u64 i = 0; i < count; ++i) {
+        bounds[i] = &meshes[i]->bounds;
+        transforms[i] = Scene_get_world_transform(scene, meshes[i]);
+    }
+
+    u64 visibleCount = Frustum_cull_bounds(&frustum, count, bounds, transforms, visible);
+
+    for (u64 i = 0; i < visibleCount; ++i) {
+        StaticMesh* mesh = meshes[visible[i]];
+        List_push_back(outVisible, mesh);
+    }
+
+    Scratch_end(scratch);
+}
+
+
+void Object_StaticMesh_draw_visible(const Scene* scene, const List* visible) {
+    for (List_iterator(StaticMesh*, visible)) {
+        internal_Object_StaticMesh_draw_at(*it, Scene_get_world_transform(scene, *it));
+    }
+}
+
+
+Entity Object_StaticMesh_instantiate(World* world, const StaticMesh* staticMesh) {
+    Entity entity = World_create_entity(world);
+
+    World_add(Transform, world, entity, COMPONENT_TRANSFORM);
+    World_add(MeshRef, world, entity, COMPONENT_MESH)->Mesh = Object_get_handle(staticMesh);
+    *World_add(Bounds, world, entity, COMPONENT_BOUNDS) = staticMesh->bounds;
+
+    return entity;
+}
+
+
+void Object_StaticMesh_draw_entities(const World* world, const List* visible) {
+    for (List_iterator(Entity, visible)) {
+        MeshRef* meshRef = World_get(MeshRef, world, *it, COMPONENT_MESH);
+        StaticMesh* staticMesh = meshRef ? Object_resolve(StaticMesh, Object_TypeStaticMesh, meshRef->Mesh) : NULL;
+
+        if (!staticMesh) {
+            continue;
+        }
+
+        WorldMatrix* worldMatrix = World_get(WorldMatrix, world, *it, COMPONENT_WORLD_MATRIX);
+        MaterialRef* materialRef = World_get(MaterialRef, world, *it, COMPONENT_MATERIAL);
+        const GLfloat* transform = worldMatrix ? worldMatrix->Matrix : MAT4_IDENTITY;
+
+        for (List_iterator(MeshRender, &staticMesh->meshRenders)) {
+            Material* material = (materialRef && materialRef->Material) ? materialRef->Material : *(Material**)List_at(&staticMesh->materials, it->materialIndex);
+            DrawRenderable(it, material, transform);
+        }
     }
 }
 
@@ -4,6 +4,7 @@
 #include "engine_core/engine_types.h"
 #include "engine_core/string.h"
 #include "engine_core/list.h"
+#include "engine_core/memory.h"
 #include "engine/object/mesh.h"
 
 #include "engine/shader/renderable.h"
@@ -39,10 +40,10 @@ StaticMesh* Object_StaticMesh_create_from_raw_data(const char* path, void* paren
         goto ReturnMesh;
     }
 
-    u32* indexBuffer = (u32*)malloc(bufferSizes[0]);
-    GLfloat* vertexBuffer = (GLfloat*)malloc(bufferSizes[1]);
-    GLfloat* normalBuffer = (GLfloat*)malloc(bufferSizes[2]);
-    GLfloat* tCoordBuffer = (GLfloat*)malloc(bufferSizes[3]);
+    u32* indexBuffer = (u32*)Engine_malloc(bufferSizes[0], MEMORY_TAG_MESH);
+    GLfloat* vertexBuffer = (GLfloat*)Engine_malloc(bufferSizes[1], MEMORY_TAG_MESH);
+    GLfloat* normalBuffer = (GLfloat*)Engine_malloc(bufferSizes[2], MEMORY_TAG_MESH);
+    GLfloat* tCoordBuffer = (GLfloat*)Engine_malloc(bufferSizes[3], MEMORY_TAG_MESH);
 
     u64 errorCode = 0;
 
@@ -58,13 +59,14 @@ StaticMesh* Object_StaticMesh_create_from_raw_data(const char* path, void* paren
     staticMesh = Object_StaticMesh_create_empty(parent);
     MeshRender mesh = { .materialIndex = 0 };
     UploadMesh(&mesh, indexBuffer, vertexBuffer, normalBuffer, tCoordBuffer, indexSize, vertexSize);
+    Bounds_from_points(vertexBuffer, vertexSize, &staticMesh->bounds);
     List_push_back(&staticMesh->meshRenders, mesh);
 
 DestroyBuffersAndReturnMesh:
-    free(indexBuffer);
-    free(vertexBuffer);
-    free(normalBuffer);
-    free(tCoordBuffer);
+    Engine_free(indexBuffer);
+    Engine_free(vertexBuffer);
+    Engine_free(normalBuffer);
+    Engine_free(tCoordBuffer);
 
 ReturnMesh:
     fclose(file);
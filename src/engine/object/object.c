@@ -1,9 +1,118 @@
+#include "errno.h"
+
 #include "engine_core/engine_types.h"
 #include "engine_core/list.h"
+#include "engine_core/pool.h"
+#include "engine_core/string.h"
+#include "engine_core/string_id.h"
+#include "engine_core/memory.h"
 
 #include "engine/math.h"
 #include "engine/object.h"
 
+
+// One pool per object type, indexed by type. A pool is set up by the first object of it's type.
+Pool ObjectPools[OBJECT_TYPE_COUNT];
+
+u64 ObjectHierarchyVersion = 0;
+u64 ObjectTransformVersion = 0;
+
+// Aliases. Objects with the same alias are linked together through their ObjectAlias, and ObjectAliasFirst has the first of each.
+// An alias is its StringId, the StringId table has the only copy of its characters and never moves them.
+//
+typedef struct ObjectAlias {
+    StringId alias;         // STRING_ID_NONE when the object has no alias.
+    Object* previous;       // Other objects with the same alias.
+    Object* next;
+} ObjectAlias;
+
+// The object given each alias last, by StringId. Grown as aliases are set.
+Object** ObjectAliasFirst = NULL;
+u32 ObjectAliasFirstCapacity = 0;
+
+// ObjectAlias of every slot of each pool, by type, then by slot index of the object's Handle.
+ObjectAlias* ObjectAliases[OBJECT_TYPE_COUNT];
+u32 ObjectAliasCapacity[OBJECT_TYPE_COUNT];
+
+
+void* internal_Object_alloc(const u8 type, const u32 size) {
+    Engine_validate(type < OBJECT_TYPE_COUNT, EINVAL);
+
+    Pool* pool = &ObjectPools[type];
+    if (!pool->itemSize) {
+        internal_Pool_initialize(pool, size);
+    }
+
+    Handle handle;
+    Object* object = (Object*)Pool_alloc(pool, &handle);
+    object->Handle = handle;
+    return object;
+}
+
+
+void internal_Object_free(void* objectPtr) {
+    Object* object = (Object*)objectPtr;
+    Pool_free(&ObjectPools[object->Data.Type], object->Handle);
+}
+
+
+void* Object_from_handle(const u8 type, const Handle handle) {
+    if (type >= OBJECT_TYPE_COUNT || !ObjectPools[type].itemSize) {
+        return NULL;
+    }
+    return Pool_resolve(&ObjectPools[type], handle);
+}
+
+
+void ObjectPools_deinitialize() {
+    for (u8 type = 0; type < OBJECT_TYPE_COUNT; type++) {
+        Pool_deinitialize(&ObjectPools[type]);
+        ObjectPools[type].itemSize = 0;
+
+        Engine_free(ObjectAliases[type]);
+        ObjectAliases[type] = NULL;
+        ObjectAliasCapacity[type] = 0;
+    }
+
+    Engine_free(ObjectAliasFirst);
+    ObjectAliasFirst = NULL;
+    ObjectAliasFirstCapacity = 0;
+}
+
+
+void internal_Object_link(Object* object, Object* parent) {
+    // Make object the first child of parent.
+    object->Parent = parent;
+    object->PreviousSibling = NULL;
+    object->NextSibling = parent->FirstChild;
+
+    if (parent->FirstChild) {
+        parent->FirstChild->PreviousSibling = object;
+    }
+    parent->FirstChild = object;
+}
+
+
+void internal_Object_unlink(Object* object) {
+    // Take object out of its parent's children.
+    if (object->PreviousSibling) {
+        object->PreviousSibling->NextSibling = object->NextSibling;
+    }
+
+    else if (object->Parent) {
+        object->Parent->FirstChild = object->NextSibling;
+    }
+
+    if (object->NextSibling) {
+        object->NextSibling->PreviousSibling = object->PreviousSibling;
+    }
+
+    object->Parent = NULL;
+    object->NextSibling = NULL;
+    object->PreviousSibling = NULL;
+}
+
+
 u8 internal_Object_Initialize(void* objectPtr, void* parentPtr, const u8 type) {
 
     // Perform blind cast to object. All object types have the same header alignment so this is safe, assuming an object is passed in here.
@@ -21,22 +130,25 @@ u8 internal_Object_Initialize(void* objectPtr, void* parentPtr, const u8 type) {
         goto ObjectInitFail;
     }
 
-    for (u8 i = 0; i < OBJECT_ALIAS_SIZE; i++) {
-        object->Alias[i] = '\0';
-    };
-
+    vec3_copy(V3_ZERO, object->Local.Translation);
+    quaternion_copy(V4_IDENTIY, object->Local.Rotation);
+    vec3_copy(V3_ONE, object->Local.Scale);
     mat4_copy(MAT4_IDENTITY, object->Transform);
     
-    object->Data.Flags = 0;
+    object->Data.Flags = OBJECT_FLAG_WORLD_DIRTY;
+    ObjectTransformVersion++;
     object->Data.Type = type;
-    object->Parent = parent;
+    object->Parent = NULL;
+    object->FirstChild = NULL;
+    object->NextSibling = NULL;
+    object->PreviousSibling = NULL;
+    object->internal_SceneIndex = OBJECT_NOT_IN_SCENE;
     
     if (parent) {
-        List_push_back(&parent->Children, object);
+        internal_Object_link(object, parent);
+        ObjectHierarchyVersion++;
     }
 
-    List_initialize(Object*, &object->Children, 16);
-
     object->Tick = internal_Object_TickDefault;
     object->Destroy = internal_Object_DestroyDefault;
 
@@ -47,22 +159,30 @@ ObjectInitFail:
 
 void internal_Object_Deinitialize(void* objectPtr) {
     Object* object = (Object*)objectPtr;
-    
-    // TODO: come up with a better solution.
-    // This is okay, but maybe sort of bad because recursion. 
-    // Could potentially blow up the stack.
-    for(u64 i = 0; i < List_count(&object->Children); i++) {
-        Object* childObject;
-        List_pop_front(&object->Children, childObject);
-        childObject->Destroy(childObject);
+    ObjectHierarchyVersion++;
+    Object_set_alias(object, NULL);
+
+    // Destroy the descendants leaves first. The parent links are the stack: go down first children to a leaf, destroy it, which
+    // unlinks it, then carry on from its parent. Each leaf's Destroy gets here with no children, so this never nests.
+    Object* node = object->FirstChild;
+    while (node) {
+        while (node->FirstChild) {
+            node = node->FirstChild;
+        }
+
+        Object* parent = node->Parent;
+        node->Destroy(node);
+        node = (parent == object) ? object->FirstChild : parent;
     }
+
+    internal_Object_unlink(object);
 }
 
 
 void internal_Object_DestroyDefault(void* objectPtr) {
     Object* object = (Object*)objectPtr;
     internal_Object_Deinitialize(objectPtr);
-    free(objectPtr);
+    internal_Object_free(objectPtr);
 }
 
 
@@ -72,39 +192,169 @@ u8 internal_Object_TickDefault(void* ptr, const double deltaTime) {
 }
 
 
+ObjectAlias* internal_Object_alias(const Object* object, const bool grow) {
+    // NULL for an object whose slot has never had an alias, unless grow makes room for it.
+    u8 type = object->Data.Type;
+    u32 index = Handle_index(object->Handle);
+
+    if (index < ObjectAliasCapacity[type]) {
+        return &ObjectAliases[type][index];
+    }
+
+    if (!grow) {
+        return NULL;
+    }
+
+    u32 capacity = ObjectPools[type].capacity;
+    ObjectAliases[type] = (ObjectAlias*)Engine_realloc(ObjectAliases[type], sizeof(ObjectAlias) * capacity, MEMORY_TAG_GENERAL);
+    Engine_validate(ObjectAliases[type], ENOMEM);
+
+    for (u32 i = ObjectAliasCapacity[type]; i < capacity; ++i) {
+        ObjectAliases[type][i] = (ObjectAlias){ STRING_ID_NONE, NULL, NULL };
+    }
+    ObjectAliasCapacity[type] = capacity;
+    return &ObjectAliases[type][index];
+}
+
+
+Object** internal_Object_alias_first(const StringId alias) {
+    // Make room for every id given out so far, which includes alias, at least doubling so new aliases don't each reallocate.
+    if (alias >= ObjectAliasFirstCapacity) {
+        u32 capacity = StringId_count();
+        if (capacity < 2 * ObjectAliasFirstCapacity) {
+            capacity = 2 * ObjectAliasFirstCapacity;
+        }
+        ObjectAliasFirst = (Object**)Engine_realloc(ObjectAliasFirst, sizeof(Object*) * capacity, MEMORY_TAG_GENERAL);
+        Engine_validate(ObjectAliasFirst, ENOMEM);
+
+        for (u32 i = ObjectAliasFirstCapacity; i < capacity; ++i) {
+            ObjectAliasFirst[i] = NULL;
+        }
+        ObjectAliasFirstCapacity = capacity;
+    }
+    return &ObjectAliasFirst[alias];
+}
+
+
 void Object_set_alias(void* objectPtr, const char* string) {
-    char* gameObjectAlias = (char*)objectPtr;
-    char* currentCharacter = (char*)string;
-    
-    for(u8 i = 0; i < OBJECT_ALIAS_SIZE; i++) {
-        if(*currentCharacter == '\0') {
-            gameObjectAlias[i] = '\0';
+    Object* object = (Object*)objectPtr;
+    bool hasAlias = string && string[0] != '\0';
+    ObjectAlias* entry = internal_Object_alias(object, hasAlias);
+
+    // Take the object out of the list for its old alias.
+    if (entry && entry->alias != STRING_ID_NONE) {
+        if (entry->previous) {
+            internal_Object_alias(entry->previous, false)->next = entry->next;
         }
 
         else {
-            gameObjectAlias[i] = string[i];
-            currentCharacter++;
+            ObjectAliasFirst[entry->alias] = entry->next;
         }
+
+        if (entry->next) {
+            internal_Object_alias(entry->next, false)->previous = entry->previous;
+        }
+        *entry = (ObjectAlias){ STRING_ID_NONE, NULL, NULL };
+    }
+
+    if (!hasAlias) {
+        return;
+    }
+
+    // Put the object at the front of the list for the new alias.
+    StringId alias = StringId_get(string);
+    Object** first = internal_Object_alias_first(alias);
+
+    if (*first) {
+        internal_Object_alias(*first, false)->previous = object;
     }
+
+    entry->alias = alias;
+    entry->previous = NULL;
+    entry->next = *first;
+    *first = object;
 }
 
 
-void Object_get_world_space_transform(void* objectPtr, mat4 out) {
-    Object* object = (Object*)objectPtr;
-    Object* currentNode = object;
+const char* Object_get_alias(void* objectPtr) {
+    ObjectAlias* entry = internal_Object_alias((Object*)objectPtr, false);
+    return (entry && entry->alias != STRING_ID_NONE) ? StringId_as_String(entry->alias).start : "";
+}
 
-    List hiarachy;
-    mat4 result;
 
-    List_initialize(GLfloat*, &hiarachy, 128);
-    mat4_copy(MAT4_IDENTITY, result);
+void* Object_find_by_alias(const char* alias) {
+    StringId id = StringId_find(alias);
+    return (id < ObjectAliasFirstCapacity) ? ObjectAliasFirst[id] : NULL;
+}
+
 
-    while (currentNode->Parent) {
-        List_push_front(&hiarachy, currentNode->Transform);
+const GLfloat* Object_get_transform(void* objectPtr) {
+    Object* object = (Object*)objectPtr;
+
+    if (Object_flag_compare(object->Data.Flags, OBJECT_FLAG_TRANSFORM_DIRTY)) {
+        mat4_from_trs(object->Local.Translation, object->Local.Rotation, object->Local.Scale, object->Transform);
+        Object_flag_unset(&object->Data.Flags, OBJECT_FLAG_TRANSFORM_DIRTY);
     }
+    return object->Transform;
+}
+
+
+void Object_set_transform(void* objectPtr, const mat4 transform) {
+    Object* object = (Object*)objectPtr;
+    mat4_copy(transform, object->Transform);
+    Object_flag_unset(&object->Data.Flags, OBJECT_FLAG_TRANSFORM_DIRTY);
+    Object_flag_set(&object->Data.Flags, OBJECT_FLAG_WORLD_DIRTY);
+    ObjectTransformVersion++;
+}
 
-    for (List_iterator(GLfloat*, &hiarachy)) {
-        mat4_multiply(result, *it, result);
+
+void Object_set_position(void* objectPtr, const vec3 position) {
+    Object* object = (Object*)objectPtr;
+    vec3_copy(position, object->Local.Translation);
+    Object_flag_set(&object->Data.Flags, OBJECT_FLAG_TRANSFORM_DIRTY | OBJECT_FLAG_WORLD_DIRTY);
+    ObjectTransformVersion++;
+}
+
+
+void Object_set_rotation(void* objectPtr, const quaternion rotation) {
+    Object* object = (Object*)objectPtr;
+    quaternion_copy(rotation, object->Local.Rotation);
+    Object_flag_set(&object->Data.Flags, OBJECT_FLAG_TRANSFORM_DIRTY | OBJECT_FLAG_WORLD_DIRTY);
+    ObjectTransformVersion++;
+}
+
+
+void Object_set_scale(void* objectPtr, const vec3 scale) {
+    Object* object = (Object*)objectPtr;
+    vec3_copy(scale, object->Local.Scale);
+    Object_flag_set(&object->Data.Flags, OBJECT_FLAG_TRANSFORM_DIRTY | OBJECT_FLAG_WORLD_DIRTY);
+    ObjectTransformVersion++;
+}
+
+
+void Object_translate(void* objectPtr, const vec3 offset) {
+    Object* object = (Object*)objectPtr;
+    vec3_add(object->Local.Translation, offset, object->Local.Translation);
+    Object_flag_set(&object->Data.Flags, OBJECT_FLAG_TRANSFORM_DIRTY | OBJECT_FLAG_WORLD_DIRTY);
+    ObjectTransformVersion++;
+}
+
+
+void Object_rotate(void* objectPtr, const quaternion rotation) {
+    Object* object = (Object*)objectPtr;
+    quaternion_multiply(rotation, object->Local.Rotation, object->Local.Rotation);
+    Object_flag_set(&object->Data.Flags, OBJECT_FLAG_TRANSFORM_DIRTY | OBJECT_FLAG_WORLD_DIRTY);
+    ObjectTransformVersion++;
+}
+
+
+void Object_get_world_space_transform(void* objectPtr, mat4 out) {
+    mat4 result;
+    mat4_copy(MAT4_IDENTITY, result);
+
+    // Walk up to the root, applying each parent's transform after everything below it.
+    for (Object* currentNode = (Object*)objectPtr; currentNode; currentNode = currentNode->Parent) {
+        mat4_multiply(result, Object_get_transform(currentNode), result);
     }
 
     mat4_copy(result, out);
@@ -114,27 +364,19 @@ void Object_get_world_space_transform(void* objectPtr, mat4 out) {
 void Object_set_parent(void* objectPtr, void* parentPtr) {
     Object* object = (Object*)objectPtr;
     Object* newParent = (Object*)parentPtr;
-    Object* parent = object->Parent;
 
     if (object->Parent == newParent) {
         return;
     }
 
-    if (parent) {
-        List_remove_at(&parent->Children, object->internal_IndexOf);
-        // TODO: look into maybe changing this to a less brute force method.
-        u64 newChildIndex = 0;
-        for (List_iterator(Object*, &parent->Children), newChildIndex++) {
-            (*it)->internal_IndexOf = newChildIndex;
-        }
-    }
-    
+    ObjectHierarchyVersion++;
+    ObjectTransformVersion++;
+    Object_flag_set(&object->Data.Flags, OBJECT_FLAG_WORLD_DIRTY);
+
+    internal_Object_unlink(object);
     if (newParent) {
-        object->internal_IndexOf = List_count(&newParent->Children);
-        List_push_back(&newParent->Children, object);
+        internal_Object_link(object, newParent);
     }
-
-    object->Parent = newParent;
 }
 
 
@@ -0,0 +1,267 @@
+#include "errno.h"
+
+#include "engine_core/engine_types.h"
+#include "engine_core/list.h"
+#include "engine_core/arena.h"
+#include "engine_core/memory.h"
+#include "engine_core/job.h"
+
+#include "engine/math.h"
+#include "engine/object.h"
+#include "engine/scene.h"
+
+
+void Scene_initialize(Scene* scene) {
+    List_initialize(Object*, &scene->roots, 16);
+    scene->objects = NULL;
+    scene->parents = NULL;
+    scene->worlds = NULL;
+    scene->changed = NULL;
+    scene->tops = NULL;
+    scene->batches = NULL;
+    scene->count = 0;
+    scene->capacity = 0;
+    scene->topCount = 0;
+    scene->batchCount = 0;
+    scene->version = 0;
+    scene->transformVersion = 0;
+    scene->rootsChanged = true;
+    scene->rebuilt = false;
+    scene->recomputed = 0;
+}
+
+
+void Scene_deinitialize(Scene* scene) {
+    for (u32 i = 0; i < scene->count; ++i) {
+        scene->objects[i]->internal_SceneIndex = OBJECT_NOT_IN_SCENE;
+    }
+
+    List_deinitialize(&scene->roots);
+    Engine_free(scene->objects);
+    Engine_free(scene->parents);
+    Engine_free(scene->worlds);
+    Engine_free(scene->changed);
+    Engine_free(scene->tops);
+    Engine_free(scene->batches);
+    scene->objects = NULL;
+    scene->parents = NULL;
+    scene->worlds = NULL;
+    scene->changed = NULL;
+    scene->tops = NULL;
+    scene->batches = NULL;
+    scene->count = 0;
+    scene->capacity = 0;
+}
+
+
+void Scene_add(Scene* scene, void* root) {
+    Object* object = (Object*)root;
+    List_push_back(&scene->roots, object);
+    scene->rootsChanged = true;
+}
+
+
+void Scene_remove(Scene* scene, void* root) {
+    Object* object = (Object*)root;
+    u64 index;
+
+    if (List_contains_item(&scene->roots, &object, &index)) {
+        List_remove_at(&scene->roots, index);
+    }
+
+    // Nothing else may point into the scene once the root is destroyed, so forget the nodes now instead of on the next update.
+    for (u32 i = 0; i < scene->count; ++i) {
+        scene->objects[i]->internal_SceneIndex = OBJECT_NOT_IN_SCENE;
+    }
+    scene->count = 0;
+    scene->topCount = 0;
+    scene->batchCount = 0;
+    scene->rootsChanged = true;
+}
+
+
+void internal_Scene_reserve(Scene* scene, const u32 count) {
+    if (count <= scene->capacity) {
+        return;
+    }
+
+    u32 capacity = scene->capacity ? scene->capacity : 64;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+
+    scene->objects = (Object**)Engine_realloc(scene->objects, sizeof(Object*) * capacity, MEMORY_TAG_GENERAL);
+    scene->parents = (u32*)Engine_realloc(scene->parents, sizeof(u32) * capacity, MEMORY_TAG_GENERAL);
+    scene->worlds = (mat4*)Engine_realloc(scene->worlds, sizeof(mat4) * capacity, MEMORY_TAG_GENERAL);
+    scene->changed = (u8*)Engine_realloc(scene->changed, sizeof(u8) * capacity, MEMORY_TAG_GENERAL);
+    scene->tops = (u32*)Engine_realloc(scene->tops, sizeof(u32) * capacity, MEMORY_TAG_GENERAL);
+    scene->batches = (SceneBatch*)Engine_realloc(scene->batches, sizeof(SceneBatch) * capacity, MEMORY_TAG_GENERAL);
+    Engine_validate(scene->objects && scene->parents && scene->worlds && scene->changed && scene->tops && scene->batches, ENOMEM);
+    scene->capacity = capacity;
+}
+
+
+void internal_Scene_push(Scene* scene, Object* object, const u32 parent) {
+    internal_Scene_reserve(scene, scene->count + 1);
+    object->internal_SceneIndex = scene->count;
+    scene->objects[scene->count] = object;
+    scene->parents[scene->count] = parent;
+    scene->count++;
+}
+
+
+void internal_Scene_rebuild(Scene* scene) {
+    for (u32 i = 0; i < scene->count; ++i) {
+        scene->objects[i]->internal_SceneIndex = OBJECT_NOT_IN_SCENE;
+    }
+    scene->count = 0;
+
+    // Depth first with a stack instead of recursion, so a deep hierarchy can't overflow the call stack. A node's children are all
+    // pushed when it is visited, and its whole subtree is visited before anything below them on the stack, so each subtree ends
+    // up contiguous.
+    ArenaScope scratch = Scratch_begin();
+    List stack;
+    List_initialize_Arena(Object*, &stack, &ScratchArena, 64);
+
+    for (List_iterator(Object*, &scene->roots)) {
+        if ((*it)->Parent) {
+            continue;
+        }
+
+        List_push_back(&stack, *it);
+        while (!List_isEmpty(&stack)) {
+            Object* object;
+            List_pop_front(&stack, object);
+
+            u32 parent = object->Parent ? object->Parent->internal_SceneIndex : SCENE_NO_PARENT;
+            internal_Scene_push(scene, object, parent);
+
+            // List_pop_front takes the item pushed last by List_push_back, so this is a stack.
+            for (Object_child_iterator(object)) {
+                List_push_back(&stack, child);
+            }
+        }
+    }
+
+    // Subtree sizes, from the leaves up. Parents come first, so walking backwards finishes every child before its parent.
+    u32* sizes = Scratch_push(u32, scene->count ? scene->count : 1);
+    for (u32 i = 0; i < scene->count; ++i) {
+        sizes[i] = 1;
+    }
+    for (u32 i = scene->count; i-- > 0;) {
+        if (scene->parents[i] != SCENE_NO_PARENT) {
+            sizes[scene->parents[i]] += sizes[i];
+        }
+    }
+
+    // Cut the order into the tops and batches. A subtree that fits in a batch goes in whole, packed with the subtrees right
+    // before it if they fit together. A bigger one's root is a top, and its children are looked at in turn.
+    scene->topCount = 0;
+    scene->batchCount = 0;
+    for (u32 i = 0; i < scene->count;) {
+        if (sizes[i] > SCENE_BATCH_SIZE) {
+            scene->tops[scene->topCount++] = i;
+            i++;
+            continue;
+        }
+
+        SceneBatch* last = scene->batchCount ? &scene->batches[scene->batchCount - 1] : NULL;
+        if (last && last->end == i && last->end - last->start + sizes[i] <= SCENE_BATCH_SIZE) {
+            last->end += sizes[i];
+        }
+
+        else {
+            scene->batches[scene->batchCount].start = i;
+            scene->batches[scene->batchCount].end = i + sizes[i];
+            scene->batches[scene->batchCount].recomputed = 0;
+            scene->batchCount++;
+        }
+        i += sizes[i];
+    }
+
+    Scratch_end(scratch);
+    scene->version = ObjectHierarchyVersion;
+    scene->rootsChanged = false;
+    scene->rebuilt = true;
+}
+
+
+bool internal_Scene_update_node(Scene* scene, const u32 node) {
+    // Returns whether the node was recomputed. Parents are always done before their children, so changed[parent] is final.
+    Object* object = scene->objects[node];
+    u32 parent = scene->parents[node];
+    bool dirty = scene->rebuilt || Object_flag_compare(object->Data.Flags, OBJECT_FLAG_WORLD_DIRTY) || (parent != SCENE_NO_PARENT && scene->changed[parent]);
+
+    scene->changed[node] = dirty;
+    if (!dirty) {
+        return false;
+    }
+
+    const GLfloat* local = Object_get_transform(object);
+    if (parent == SCENE_NO_PARENT) {
+        mat4_copy(local, scene->worlds[node]);
+    }
+
+    else {
+        mat4_multiply(local, scene->worlds[parent], scene->worlds[node]);
+    }
+
+    Object_flag_unset(&object->Data.Flags, OBJECT_FLAG_WORLD_DIRTY);
+    return true;
+}
+
+
+void internal_Scene_update_batches(void* scenePtr, const u64 start, const u64 end) {
+    Scene* scene = (Scene*)scenePtr;
+
+    for (u64 batch = start; batch < end; ++batch) {
+        u32 recomputed = 0;
+        for (u32 node = scene->batches[batch].start; node < scene->batches[batch].end; ++node) {
+            recomputed += internal_Scene_update_node(scene, node);
+        }
+        scene->batches[batch].recomputed = recomputed;
+    }
+}
+
+
+void Scene_update_transforms(Scene* scene) {
+    if (scene->rootsChanged || scene->version != ObjectHierarchyVersion) {
+        internal_Scene_rebuild(scene);
+    }
+
+    // Nothing has moved since the last update, so every world matrix is still right.
+    scene->recomputed = 0;
+    if (!scene->rebuilt && scene->transformVersion == ObjectTransformVersion) {
+        return;
+    }
+    scene->transformVersion = ObjectTransformVersion;
+
+    for (u32 i = 0; i < scene->topCount; ++i) {
+        scene->recomputed += internal_Scene_update_node(scene, scene->tops[i]);
+    }
+
+    // Each object's lazy transform is only touched by the job that has its node, so the batches don't share anything they write.
+    if (scene->batchCount > 1) {
+        Job_parallel_for(scene->batchCount, 1, internal_Scene_update_batches, scene, NULL);
+    }
+
+    else {
+        internal_Scene_update_batches(scene, 0, scene->batchCount);
+    }
+
+    for (u32 i = 0; i < scene->batchCount; ++i) {
+        scene->recomputed += scene->batches[i].recomputed;
+    }
+    scene->rebuilt = false;
+}
+
+
+const GLfloat* Scene_get_world_transform(const Scene* scene, void* objectPtr) {
+    Object* object = (Object*)objectPtr;
+    u32 node = object->internal_SceneIndex;
+
+    if (!scene || node >= scene->count || scene->objects[node] != object) {
+        return Object_get_transform(object);
+    }
+    return scene->worlds[node];
+}
@@ -7,39 +7,46 @@
 
 #include "engine_core/hash_table.h"
 #include "engine_core/engine_shader.h"
+#include "engine_core/memory.h"
 
 
 #define MATERIAL_BUFFER_SIZE 0x100
 
 
 Material* Material_create (const MaterialDescriptor descriptor) {
-    Shader* shader = Shader_get(descriptor.alias);
+    Handle shaderHandle = Shader_find(descriptor.alias);
+    Shader* shader = Shader_resolve(shaderHandle);
 
     if (!shader) {
         return NULL;
     }
 
-    Material* newMaterial = (Material*)malloc(sizeof(Material));
+    Material* newMaterial = (Material*)Engine_malloc(sizeof(Material), MEMORY_TAG_MATERIAL);
     Engine_validate(newMaterial, ENOMEM);
 
-     shader->references++;
+    shader->references++;
 
-    String aliasString = String_from_ptr(descriptor.alias);
-    String_create_dirty(&aliasString, &newMaterial->ShaderAlias);
+    newMaterial->ShaderHandle = shaderHandle;
 
     newMaterial->TextureCount = descriptor.textureCount;
     newMaterial->CullFunction = descriptor.cullFunction;
     newMaterial->DepthFunction = descriptor.depthFunction;
     
     if(newMaterial->TextureCount != 0) {
-        newMaterial->TextureAliases = (String*)calloc(descriptor.textureCount, sizeof(String));
+        newMaterial->TextureHandles = (Handle*)Engine_calloc(descriptor.textureCount, sizeof(Handle), MEMORY_TAG_MATERIAL);
+        Engine_validate(newMaterial->TextureHandles, ENOMEM);
         for (u64 i = 0; i < newMaterial->TextureCount; ++i) {
-            String currentAlias = String_from_ptr(descriptor.textures[i]);
-            String_create_dirty(&currentAlias, &newMaterial->TextureAliases[i]);
+            newMaterial->TextureHandles[i] = Texture_find(descriptor.textures[i]);
+
+            // Missing textures keep a null handle, and are reported when the Material is bound.
+            Texture* texture = Texture_resolve(newMaterial->TextureHandles[i]);
+            if (texture) {
+                texture->references++;
+            }
         }
     }
     else {
-        newMaterial->TextureAliases = NULL;
+        newMaterial->TextureHandles = NULL;
     }
 
     return newMaterial;
@@ -52,24 +59,17 @@ void Material_destroy (Material** material) {
         return;
     }
 
-    for (u64 i = 0; i < (*material)->TextureCount; ++i) {
-        Texture* texture;
-        Texture_get_String((*material)->TextureAliases[i], &texture);
-    }
-
     if ((*material)->TextureCount != 0) {
 
         for (int i = 0; i < (*material)->TextureCount; i++) {
-            Texture_delete_String((*material)->TextureAliases[i]);
-            String_free_dirty(&(*material)->TextureAliases[i]);
+            Texture_release((*material)->TextureHandles[i]);
         }
-        free((*material)->TextureAliases);
+        Engine_free((*material)->TextureHandles);
     }
     
-    Shader_delete_String((*material)->ShaderAlias);
-    String_free_dirty(&(*material)->ShaderAlias);
+    Shader_release((*material)->ShaderHandle);
 
-    free(*material);
+    Engine_free(*material);
     (*material) = NULL;
 }
 
@@ -81,7 +81,7 @@ Shader* Material_bind (const Material* material) {
         return NULL;
     }
 
-    Shader* shader = Shader_get_String(material->ShaderAlias);
+    Shader* shader = Shader_resolve(material->ShaderHandle);
 
     if (!shader) {
         return NULL;
@@ -96,8 +96,7 @@ Shader* Material_bind (const Material* material) {
     for (u32 i = 0; i < material->TextureCount; i++) {
         //TODO: Rework shader handling because this is bad. We don't know ahead of time what the binding index is, there might be data that isn't textures at the start.
         glActiveTexture(i + GL_TEXTURE0);
-        Texture* texture;
-        Texture_get_String(material->TextureAliases[i], &texture);
+        Texture* texture = Texture_resolve(material->TextureHandles[i]);
         if (texture) {
             glBindTexture(texture->Type, texture->ID);
         }
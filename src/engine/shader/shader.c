@@ -9,6 +9,9 @@
 
 #include "engine_core/hash_table.h"
 #include "engine_core/string.h"
+#include "engine_core/arena.h"
+#include "engine_core/resource_table.h"
+#include "engine_core/memory.h"
 #include "engine/math.h"
 
 #include "engine/shader/shader_uniform.h"
@@ -17,13 +20,12 @@
 #define MAX_ALIAS_SIZE 512
 
 HashTable* UniformBufferTable = NULL;
-HashTable* ShaderProgramTable = NULL;
-HashTable* TextureTable = NULL;
+ResourceTable ShaderProgramTable;
 HashTable* ShaderCompilationTable = NULL;
 
 void InitShaders() {
     UniformBufferTable = HashTable_create(UniformBuffer, 128);
-    ShaderProgramTable = HashTable_create(Shader, 512);
+    ResourceTable_initialize(Shader, &ShaderProgramTable, 512);
     // TextureTable = HashTable_create(Texture, 512);
 }
 
@@ -36,8 +38,8 @@ ecode DereferenceShaders() {
     // This is probably a massive security vulnerability.
     
     // Destroy the shader programs.
-    for (HashTable_array_iterator(ShaderProgramTable)) {
-        Shader* shader = HashTable_array_at(Shader, ShaderProgramTable, i);
+    for (u64 i = 0; i < ResourceTable_count(&ShaderProgramTable); ++i) {
+        Shader* shader = Shader_resolve(ResourceTable_handle_at(&ShaderProgramTable, i));
         Shader_deinitialize(shader);
     }
 
@@ -58,7 +60,7 @@ ecode DereferenceShaders() {
 
     // Now destroy the tables which store them. 
     HashTable_destroy(&UniformBufferTable);
-    HashTable_destroy(&ShaderProgramTable);
+    ResourceTable_deinitialize(&ShaderProgramTable);
     return 0;
 }
 
@@ -79,23 +81,14 @@ void UniformBuffer_deinitialize(UniformBuffer* buffer) {
 
     glDeleteBuffers(1, &buffer->BufferObject);
 
-    for (HashTable_array_iterator(buffer->Uniforms)) {
-        Uniform* uniform = HashTable_array_at(Uniform, buffer->Uniforms, i);
-        if (uniform && !String_invalid(uniform->Alias)) {
-            String_free_dirty(&uniform->Alias);
-        }
-    }
-
     //Try to remove it from the global table to avoid deleting twice.
     HashTable_destroy(&buffer->Uniforms);
 
-    // Have to do this extra stuff since removing the buffer from the HashTable will also destroy it.
+    // The alias points at a table's copy of the key, which outlives the remove. Take a copy of the String first since removing
+    // the buffer can move whatever buffer points at.
     RemoveFromHashTable:
-    String alias;
-    String_create_dirty(&buffer->Alias, &alias);
-    String_free_dirty(&buffer->Alias);
+    String alias = buffer->Alias;
     HashTable_remove(UniformBufferTable, alias);
-    String_free_dirty(&alias);
 
 }
 
@@ -202,6 +195,60 @@ UniformBuffer* UniformBuffer_get_self(const char* alias) {
     return outVal;
 }
 
+void internal_UniformBuffer_set_Id(UniformBuffer* buffer, StringId alias, void* data) {
+    // set the value of an item in a buffer by its variable name.
+
+    if (!buffer) {
+        printf("Error UniformBuffer_set:\t\tBuffer value \"%s\" does not exist.\n", StringId_as_String(alias).start);
+        return;
+    }
+
+    Uniform* uniform;
+    UniformBuffer_get_Uniform_Id(buffer, alias, &uniform);
+
+    if (uniform) {
+        Uniform_set_data(uniform, data);
+        buffer->ChangesMade++;
+    }
+}
+
+void UniformBuffer_get_Uniform_Id(const UniformBuffer* buffer, StringId alias, Uniform** outVal) {
+    if(buffer) HashTable_find_reference_Id(buffer->Uniforms, alias, StringId_as_String(alias), (void**)outVal);
+}
+
+void UniformBuffer_get_Struct_Id(const UniformBuffer* buffer, StringId alias, UniformStruct** outVal) {
+    if(buffer) HashTable_find_reference_Id(buffer->UniformStructs, alias, StringId_as_String(alias), (void**)outVal);
+}
+
+void internal_UniformBuffer_set_Struct_at_Id(UniformBuffer* buffer, StringId alias, StringId memberAlias, u64 i, void* data) {
+
+    if (!buffer) {
+        printf("Error UniformBuffer_set_Struct_at\t: Uniform Buffer \"%s\" does not exist.\n", StringId_as_String(alias).start);
+        return;
+    }
+
+    UniformStruct* uniformStruct;
+    UniformBuffer_get_Struct_Id(buffer, alias, &uniformStruct);
+    if (!uniformStruct) {
+        printf("Error UniformBuffer_set_Struct_at\t: Uniform Structure \"%s\" does not exist.\n", StringId_as_String(alias).start);
+        return;
+    }
+
+    UniformStruct_set_member_at_Id(uniformStruct, memberAlias, i, data);
+    buffer->ChangesMade++;
+}
+
+UniformBuffer* UniformBuffer_get_self_Id(StringId alias) {
+    UniformBuffer* outVal;
+    HashTable_find_reference_Id(UniformBufferTable, alias, StringId_as_String(alias), (void**)&outVal);
+
+    if (!outVal) {
+        printf("Error UniformBuffer_get_self:\t\tBuffer \"%s\" does not exist.\n", StringId_as_String(alias).start);
+    }
+
+    return outVal;
+}
+
 void UniformBuffer_update_all() {
     // Upload all uniform buffers.
 
@@ -215,6 +262,26 @@ void UniformBuffer_update_all() {
     }
 }
 
+void internal_Uniform_insert(HashTable* table, const String alias, const void* uniform) {
+    // Every uniform type starts with UNIFORM_BODY, so the alias is in the same place in all of them.
+    u64 slot;
+    u32 keyCompactions = table->keyCompactions;
+
+    if (uniform && internal_HashTable_insert_slot(table, alias, &slot)) {
+        UniformGeneric* inserted = (UniformGeneric*)&table->values[slot * table->itemSize];
+        memcpy(inserted, uniform, table->itemSize);
+        inserted->Alias = table->keys[slot];
+    }
+
+    // The insert moved the table's keys, so point every uniform's Alias at its key again.
+    if (table->keyCompactions != keyCompactions) {
+        for (HashTable_array_iterator(table)) {
+            UniformGeneric* stored = HashTable_array_at(UniformGeneric, table, i);
+            stored->Alias = *HashTable_array_key_at(table, i);
+        }
+    }
+}
+
 Uniform* internal_Uniform_create_shared(const UniformInformation* info, void* sharedBuffer) {
     // Initialize a Uniform that is a part of a buffer.
 
@@ -226,13 +293,14 @@ Uniform* internal_Uniform_create_shared(const UniformInformation* info, void* sh
     u64 size = size_from_gl_type(info->Type);
 
     // allocate enough space for the Uniform header + the space required to store it's data. 
-    Uniform* newUniform = (Uniform*)malloc(sizeof(Uniform));
+    Uniform* newUniform = (Uniform*)Engine_malloc(sizeof(Uniform), MEMORY_TAG_SHADER);
     
     if (!newUniform) {
         return NULL;
     }
 
-    String_create_dirty((String*)&info->Alias, &newUniform->Alias);
+    // Borrowed until the uniform is inserted with internal_Uniform_insert.
+    newUniform->Alias = info->Alias;
 
     newUniform->Data = (void*)(((u8*)sharedBuffer) + info->BlockOffset);
     newUniform->UniformType = UNIFORM_TYPE_SHARED;
@@ -255,15 +323,16 @@ Uniform* internal_Uniform_create(const UniformInformation* info) {
     u64 size = size_from_gl_type(info->Type);
 
     // allocate enough space for the Uniform header + the space required to store it's data. 
-    Uniform* newUniform = (Uniform*)malloc(sizeof(Uniform));
+    Uniform* newUniform = (Uniform*)Engine_malloc(sizeof(Uniform), MEMORY_TAG_SHADER);
     
     if (!newUniform) {
         return NULL;
     }
 
-    String_create_dirty((String*)&info->Alias, &newUniform->Alias);
+    // Borrowed until the uniform is inserted with internal_Uniform_insert.
+    newUniform->Alias = info->Alias;
 
-    newUniform->Data = calloc(size,info->Elements);
+    newUniform->Data = Engine_calloc(size,info->Elements, MEMORY_TAG_SHADER);
     newUniform->UniformType = UNIFORM_TYPE_SINGLE;
     newUniform->Location = info->Location;    
     newUniform->Size = size;
@@ -313,7 +382,7 @@ UniformStruct* internal_UniformStruct_create(String alias, const UniformInformat
 
     u64 totalSize = 0;
     u64 stride = 0;
-    u32* offsets = (u32*)malloc(sizeof(u32) * memberCount);
+    u32* offsets = (u32*)Engine_malloc(sizeof(u32) * memberCount, MEMORY_TAG_SHADER);
     Engine_validate(offsets, ENOMEM);
 
     // for each member, get it's local offset.
@@ -327,10 +396,11 @@ UniformStruct* internal_UniformStruct_create(String alias, const UniformInformat
     stride -= 16;
 
     totalSize = stride * elements;
-    UniformStruct* newStruct = (UniformStruct*)malloc(sizeof(UniformStruct));
+    UniformStruct* newStruct = (UniformStruct*)Engine_malloc(sizeof(UniformStruct), MEMORY_TAG_SHADER);
     Engine_validate(newStruct, ENOMEM);
 
-    String_create_dirty(&alias, &(newStruct->Alias));
+    // Borrowed until the struct is inserted with internal_Uniform_insert.
+    newStruct->Alias = alias;
 
     newStruct->Data = shared;
     newStruct->Members = HashTable_create(Uniform, memberCount);
@@ -345,7 +415,8 @@ UniformStruct* internal_UniformStruct_create(String alias, const UniformInformat
 
         Uniform* newMember = internal_Uniform_create_shared(&(info[i]), shared);
         newMember->Stride = stride;
-        HashTable_insert(newStruct->Members, info[i].Alias, newMember);
+        internal_Uniform_insert(newStruct->Members, info[i].Alias, newMember);
+        Engine_free(newMember);
     }
 
     return newStruct;
@@ -371,6 +442,22 @@ void UniformStruct_set_member_at(UniformStruct* uniformStruct, const char* alias
     memcpy(elementAddress, data, uniform->Size);
 }
 
+void UniformStruct_get_member_Id(UniformStruct* uniformStruct, StringId alias, Uniform** outVal) {
+    HashTable_find_reference_Id(uniformStruct->Members, alias, StringId_as_String(alias), (void**)outVal);
+}
+
+void UniformStruct_set_member_at_Id(UniformStruct* uniformStruct, StringId alias, u64 i, void* data) {
+    Uniform* uniform;
+    UniformStruct_get_member_Id(uniformStruct, alias, &uniform);
+    if (!uniform) {
+        printf("Error UniformStruct_set_member\t: could not find Uniform in Structure \"%s\" named \"%s\"\n", uniformStruct->Alias.start, StringId_as_String(alias).start);
+        return;
+    }
+
+    u8* elementAddress = (u8*)uniformStruct->Data + (i * uniform->Stride) + uniform->Offset;
+    memcpy(elementAddress, data, uniform->Size);
+}
+
 void UniformStruct_set_member(UniformStruct* uniformStruct, const char* alias, void* data) {
     String shaderAlias = String_from_ptr(alias);
     Uniform* uniform;
@@ -397,18 +484,14 @@ void internal_Shader_create(const GLuint program, const char* alias) {
     }
     
     String shaderAlias = String_from_ptr(alias);
-    Shader shader;
-    Shader* shaderReference;
-
-    HashTable_find_reference(ShaderProgramTable, shaderAlias, &shaderReference);
+    Shader* shaderReference = Shader_get_String(shaderAlias);
 
     if (shaderReference) {
         shaderReference->references++;
         return;
     }
-    else {
-        shaderReference = &shader;
-    }
+
+    shaderReference = (Shader*)ResourceTable_insert(&ShaderProgramTable, shaderAlias, NULL);
 
     GLint uniformCount = internal_Program_uniform_count(program);
     GLint bufferCount = internal_Program_buffer_count(program);
@@ -421,7 +504,6 @@ void internal_Shader_create(const GLuint program, const char* alias) {
    
     internal_Program_uniform_parse(program, shaderReference->uniforms);
     internal_Program_buffer_parse(program, shaderReference->uniformBuffers);
-    HashTable_insert(ShaderProgramTable, shaderAlias, shaderReference);
 }
 
 
@@ -431,8 +513,11 @@ void Shader_delete(const char* alias) {
 }
 
 void Shader_delete_String(String alias) {
-    Shader* shader = NULL;
-    HashTable_find_reference(ShaderProgramTable, alias, &shader);
+    Shader_release(Shader_find_String(alias));
+}
+
+void Shader_release(Handle handle) {
+    Shader* shader = Shader_resolve(handle);
 
     if (!shader) {
         return;
@@ -444,7 +529,7 @@ void Shader_delete_String(String alias) {
     }
 
     Shader_deinitialize(shader);
-    HashTable_remove(ShaderProgramTable, alias);
+    ResourceTable_remove(&ShaderProgramTable, handle);
 }
 
 
@@ -456,8 +541,7 @@ void Shader_deinitialize (Shader* shader) {
     for (HashTable_array_iterator(shader->uniforms)) {
         Uniform* uniform = HashTable_array_at(Uniform, shader->uniforms, i);
         if (uniform->UniformType == UNIFORM_TYPE_SINGLE) {
-            free(uniform->Data);
-            free(uniform->Alias.start);
+            Engine_free(uniform->Data);
         }
         uniform = NULL;
     }
@@ -469,16 +553,33 @@ void Shader_deinitialize (Shader* shader) {
 }
 
 
+Handle Shader_find(const char* alias) {
+    return ResourceTable_find(&ShaderProgramTable, (String) String_from_ptr(alias));
+}
+
+Handle Shader_find_String(String alias) {
+    return ResourceTable_find(&ShaderProgramTable, alias);
+}
+
+Handle Shader_find_Id(StringId alias) {
+    return ResourceTable_find_Id(&ShaderProgramTable, alias);
+}
+
+Shader* Shader_resolve(Handle handle) {
+    return ResourceTable_get(Shader, &ShaderProgramTable, handle);
+}
+
+
 Shader* Shader_get(const char* alias) {
-    Shader* shader = NULL;
-    HashTable_find_reference(ShaderProgramTable, (String) String_from_ptr(alias), &shader);
-    return shader;
+    return Shader_resolve(Shader_find(alias));
 }
 
 Shader* Shader_get_String(String alias) {
-    Shader* shader = NULL;
-    HashTable_find_reference(ShaderProgramTable, alias, &shader);
-    return shader;
+    return Shader_resolve(Shader_find_String(alias));
+}
+
+Shader* Shader_get_Id(StringId alias) {
+    return Shader_resolve(Shader_find_Id(alias));
 }
 
 
@@ -490,6 +591,14 @@ void Shader_get_uniformBuffer(const Shader* shader, const char* alias, UniformBu
     HashTable_find_reference(shader->uniformBuffers, (String)String_from_ptr(alias), outVal);
 }
 
+void Shader_get_uniform_Id(const Shader* shader, StringId alias, Uniform** outVal) {
+    HashTable_find_reference_Id(shader->uniforms, alias, StringId_as_String(alias), (void**)outVal);
+}
+
+void Shader_get_uniformBuffer_Id(const Shader* shader, StringId alias, UniformBuffer** outVal) {
+    HashTable_find_reference_Id(shader->uniformBuffers, alias, StringId_as_String(alias), (void**)outVal);
+}
+
 void Shader_debug(const GLuint program) {
     char buffer[512] = {'\0',};
     int bufferLength = 0;
@@ -542,36 +651,20 @@ void Shader_use(const Shader* shader) {
 
 GLint internal_Program_buffer_count(const GLuint program) {
     
-    GLint* params = (GLint*)malloc(sizeof(GLint));
+    GLint uniformCount = 0;
 
-    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, params);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &uniformCount);
 
     //glGetProgramiv(program, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, params);
 
-    if (params == NULL) {
-        // something has gone very wrong and the shader has no uniforms.
-        assert(false);
-    }
-
-    GLint uniformCount = *params;
-    free(params);
-
     return uniformCount;
 }
 
 GLint internal_Program_uniform_count(const GLuint program) {
     // Get the number of uniforms.
 
-    GLint* params = (GLint*)malloc(sizeof(GLint));
-    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, params);
-
-    if (params == NULL) {
-        // something has gone very wrong and the shader has no uniforms.
-        assert(false);
-    }
-
-    GLint uniformCount = *params;
-    free(params);
+    GLint uniformCount = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
     
     return uniformCount;
 }
@@ -594,6 +687,8 @@ void internal_Program_buffer_parse(const GLuint program, HashTable* table) {
     char buffer[MAX_ALIAS_SIZE];
     assert(buffer != NULL);
 
+    ArenaScope scratch = Scratch_begin();
+
     for (GLint i = 0; i < bufferCount; i++) {
 
         // get the name of the uniform buffer:
@@ -613,7 +708,7 @@ void internal_Program_buffer_parse(const GLuint program, HashTable* table) {
         // if it already exists, insert that one instead.
         if (uniformBuffer) {
             uniformBuffer->References++;
-            HashTable_insert(table, alias, uniformBuffer);
+            internal_Uniform_insert(table, alias, uniformBuffer);
             continue;
         }
         
@@ -621,10 +716,11 @@ void internal_Program_buffer_parse(const GLuint program, HashTable* table) {
         glGetActiveUniformBlockiv(program, i, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
         glGetActiveUniformBlockiv(program, i, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &indicies);
 
-        uniformBuffer = (UniformBuffer*)calloc(1, sizeof(UniformBuffer));
-        assert(uniformBuffer != NULL);
+        // Only used to fill out the table entries below, which copy it.
+        uniformBuffer = Scratch_push(UniformBuffer, 1);
+        memset(uniformBuffer, 0, sizeof(UniformBuffer));
 
-        uniformBuffer->buffer = (u8*)calloc(size, 1);
+        uniformBuffer->buffer = (u8*)Engine_calloc(size, 1, MEMORY_TAG_SHADER);
 
         // Hash tables are intentionally oversized. 
         // This is because we don't know how many indicies are actually parts of structures. 
@@ -632,17 +728,14 @@ void internal_Program_buffer_parse(const GLuint program, HashTable* table) {
         uniformBuffer->Uniforms = HashTable_create(Uniform, indicies);
         uniformBuffer->UniformStructs = HashTable_create(UniformStruct, indicies);
 
-        uniformIndicies = (GLint*)calloc(indicies, sizeof(GLint));
-        Engine_validate(uniformIndicies, ENOMEM);
+        uniformIndicies = Scratch_push(GLint, indicies);
 
         glGetActiveUniformBlockiv(program, i, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, uniformIndicies);
         
         internal_Program_buffer_uniform_parse(program, indicies, uniformIndicies, uniformBuffer);
         internal_program_uniformStruct_parse(program, indicies, uniformIndicies, uniformBuffer);
 
-        free(uniformIndicies);
-
-        String_create_dirty(&alias, &(uniformBuffer->Alias));
+        uniformBuffer->Alias = alias;
         uniformBuffer->UniformType = UNIFORM_TYPE_BUFFER;
         uniformBuffer->Size = size;
         uniformBuffer->BindingIndex = binding;
@@ -655,21 +748,21 @@ void internal_Program_buffer_parse(const GLuint program, HashTable* table) {
         glBindBufferBase(GL_UNIFORM_BUFFER, uniformBuffer->BindingIndex, uniformBuffer->BufferObject);
         glBindBuffer(GL_UNIFORM_BUFFER, GL_NONE);
 
-        HashTable_insert(UniformBufferTable, alias, uniformBuffer);
-        HashTable_insert(table, alias, uniformBuffer);
-        free(uniformBuffer);
+        internal_Uniform_insert(UniformBufferTable, alias, uniformBuffer);
+        internal_Uniform_insert(table, alias, uniformBuffer);
     }
+
+    Scratch_end(scratch);
 }
 
 void internal_program_uniformStruct_parse(const GLuint program, const u16 uniformCount, GLint* indicies, UniformBuffer* uniformBuffer) {
     
     u16 ValidStructCount = 0;
 
-    GLint* blockOffsetParams = (GLint*)malloc(uniformCount * sizeof(GLint));
-    assert(blockOffsetParams != NULL);
+    ArenaScope scratch = Scratch_begin();
 
-    char* buffer = (char*)malloc(MAX_ALIAS_SIZE);
-    assert(buffer != NULL);
+    GLint* blockOffsetParams = Scratch_push(GLint, uniformCount);
+    char* buffer = Scratch_push(char, MAX_ALIAS_SIZE);
     
     // Struct parsing variables:
     char* structName = NULL;
@@ -683,8 +776,7 @@ void internal_program_uniformStruct_parse(const GLuint program, const u16 unifor
     bool indiciesProvided = indicies? true : false ;
 
     if (!indiciesProvided) {
-        indicies = (GLint*)malloc(uniformCount * sizeof(GLint));
-        assert(indicies);
+        indicies = Scratch_push(GLint, uniformCount);
 
         for (u16 i = 0; i < uniformCount; i++) {
             indicies[i] = i;
@@ -692,8 +784,7 @@ void internal_program_uniformStruct_parse(const GLuint program, const u16 unifor
     }
     
     // Create InfoArray at the max size possible to be safe.
-    UniformInformation* infoArray = (UniformInformation*)calloc(1, uniformCount * sizeof(UniformInformation));
-    Engine_validate(infoArray, ENOMEM);
+    UniformInformation* infoArray = Arena_push_zero(UniformInformation, &ScratchArena, uniformCount);
 
     glGetActiveUniformsiv(program, uniformCount, indicies, GL_UNIFORM_OFFSET, blockOffsetParams);
 
@@ -717,14 +808,11 @@ void internal_program_uniformStruct_parse(const GLuint program, const u16 unifor
             continue;
         }
 
-        if (nextStructName) free(nextStructName);
-        nextStructName = (char*)calloc(1, structNameLength);
-        Engine_validate(nextStructName, ENOMEM);
+        nextStructName = Arena_push_zero(char, &ScratchArena, structNameLength);
         memcpy(nextStructName, buffer, nameEnd - buffer);
 
         if (!structName) {
-            structName = (char*)calloc(1, structNameLength);
-            Engine_validate(structName, ENOMEM);
+            structName = Arena_push_zero(char, &ScratchArena, structNameLength);
             memcpy(structName, buffer, nameEnd - buffer);
         }
 
@@ -735,11 +823,11 @@ void internal_program_uniformStruct_parse(const GLuint program, const u16 unifor
             //printf("\nstructElements:%d\n", structElements);
             String structNameString = String_from_ptr(structName);
             UniformStruct* newStruct = internal_UniformStruct_create(structNameString, infoArray, structMembers, structElements / structMembers, uniformBuffer->buffer);
-            HashTable_insert(uniformBuffer->UniformStructs, structNameString, newStruct);
+            internal_Uniform_insert(uniformBuffer->UniformStructs, structNameString, newStruct);
+            Engine_free(newStruct);
             ValidStructCount++;
             structMembers = 0;
             structElements = 1;
-            free(structName);
             structName = NULL;
         }
             
@@ -754,7 +842,7 @@ void internal_program_uniformStruct_parse(const GLuint program, const u16 unifor
         String memberNameString;
         u64 memberNameLength = length - (structIdent - buffer);
         String memberNameBuffer = String_from_ptr_size(structIdent + 1, memberNameLength - 1);
-        String_create_dirty(&memberNameBuffer, &memberNameString);
+        String_create_Arena(&ScratchArena, &memberNameBuffer, &memberNameString);
 
         UniformInformation info = { 
             .Alias = {memberNameString.start, memberNameString.end},
@@ -776,36 +864,27 @@ void internal_program_uniformStruct_parse(const GLuint program, const u16 unifor
         //printf("\nstructElements:%d\n", structElements);
         String structNameString = String_from_ptr(structName);
         UniformStruct* newStruct = internal_UniformStruct_create(structNameString, infoArray, structMembers, structElements / structMembers, uniformBuffer->buffer);
-        HashTable_insert(uniformBuffer->UniformStructs, structNameString, newStruct);
+        internal_Uniform_insert(uniformBuffer->UniformStructs, structNameString, newStruct);
+        Engine_free(newStruct);
         ValidStructCount++;
         structMembers = 0;
         structElements = 0;
-        free(structName);
         structName = NULL;
     }
 
     // Resize the table to fit the actual number found.
     HashTable_resize(uniformBuffer->UniformStructs, ValidStructCount);
 
-    for (u64 i = 0; i < structMembers; ++i) {
-        String_free_dirty(&infoArray[i].Alias);
-    }
-
-    if (nextStructName) free(nextStructName);
-    if (!indiciesProvided) free(indicies);
-    free(blockOffsetParams);
-    free(buffer);
-    free(infoArray);
+    Scratch_end(scratch);
 }
 
 
 void internal_Program_buffer_uniform_parse(const GLuint program, const u16 uniformCount, const GLint* indicies, UniformBuffer* uniformBuffer) {
 
-    GLint* blockOffsetParams = (GLint*)malloc(uniformCount * sizeof(GLint));
-    assert(blockOffsetParams != NULL);
+    ArenaScope scratch = Scratch_begin();
 
-    char* buffer = (char*)malloc(MAX_ALIAS_SIZE);
-    assert(buffer != NULL);
+    GLint* blockOffsetParams = Scratch_push(GLint, uniformCount);
+    char* buffer = Scratch_push(char, MAX_ALIAS_SIZE);
     
     glGetActiveUniformsiv(program, uniformCount, indicies, GL_UNIFORM_OFFSET, blockOffsetParams);
 
@@ -817,8 +896,8 @@ void internal_Program_buffer_uniform_parse(const GLuint program, const u16 unifo
 
         glGetActiveUniform(program, indicies[i], MAX_ALIAS_SIZE, &length, &elements, &type, buffer);
        
-        char* alias = (char*)malloc(length + 1);
-        assert(alias != NULL);
+        // The table copies the alias, so this one only needs to last until the end of the function.
+        char* alias = Scratch_push(char, length + 1);
         memcpy(alias, buffer, length + 1);
         
 
@@ -847,11 +926,12 @@ void internal_Program_buffer_uniform_parse(const GLuint program, const u16 unifo
             .BlockOffset = blockOffsetParams[i]
         };
 
-        HashTable_insert(uniformBuffer->Uniforms, info.Alias, internal_Uniform_create_shared(&info, uniformBuffer->buffer));
+        Uniform* uniform = internal_Uniform_create_shared(&info, uniformBuffer->buffer);
+        internal_Uniform_insert(uniformBuffer->Uniforms, info.Alias, uniform);
+        Engine_free(uniform);
     }
 
-    free(blockOffsetParams);
-    free(buffer);
+    Scratch_end(scratch);
 }
 
 void internal_Program_uniform_parse(const GLuint program, HashTable* table) {
@@ -866,23 +946,18 @@ void internal_Program_uniform_parse(const GLuint program, HashTable* table) {
     GLint elements;
     GLenum type;
 
-    GLint* blockOffsetParams = (GLint*)malloc(uniformCount * sizeof(GLint));
-    GLuint* indicies = (GLuint*)malloc(uniformCount * sizeof(GLuint));
-    Uniform** uniforms = (Uniform**)calloc(uniformCount, sizeof(Uniform*));
- 
-    assert(blockOffsetParams != NULL);
-    assert(indicies != NULL);
-    assert(uniforms != NULL);
+    ArenaScope scratch = Scratch_begin();
+
+    GLint* blockOffsetParams = Scratch_push(GLint, uniformCount);
+    GLuint* indicies = Scratch_push(GLuint, uniformCount);
 
     for(GLuint i = 0; i < uniformCount; i++ ) {
         indicies[i] = i;
     }
 
     glGetActiveUniformsiv(program, uniformCount, indicies, GL_UNIFORM_OFFSET, blockOffsetParams);
-    free(indicies);
 
-    char* buffer = (char*)malloc(MAX_ALIAS_SIZE);
-    assert(buffer != NULL);
+    char* buffer = Scratch_push(char, MAX_ALIAS_SIZE);
 
     for (GLint i = 0; i < uniformCount; i++) {
 
@@ -900,9 +975,8 @@ void internal_Program_uniform_parse(const GLuint program, HashTable* table) {
             continue;
         }
 
-        char* alias = (char*)malloc(length + 1);
-        Engine_validate(alias, ENOMEM);
-
+        // Uniforms copy their alias, so this one only needs to last until the end of the function.
+        char* alias = Scratch_push(char, length + 1);
         memcpy(alias, buffer, length + 1);
 
         char* ArrayIdent = strchr(alias, '[');
@@ -924,12 +998,12 @@ void internal_Program_uniform_parse(const GLuint program, HashTable* table) {
 
         UniformInformation info = { .Alias = String_from_ptr(alias), .UniformType = UNIFORM_TYPE_SINGLE, .Location = location, .Type = type, .Elements = elements, .BlockOffset = -1};
         Uniform* uniform = internal_Uniform_create(&info);
-        HashTable_insert(table, info.Alias, uniform);
+        internal_Uniform_insert(table, info.Alias, uniform);
+        Engine_free(uniform);
     }
 
 
     HashTable_resize(table, validUniformCount);
 
-    free(blockOffsetParams);
-    free(buffer);
+    Scratch_end(scratch);
 }
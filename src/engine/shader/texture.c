@@ -6,36 +6,61 @@
 #include "stdbool.h"
 #include "string.h"
 
-#include "engine_core/hash_table.h"
+#include "engine_core/resource_table.h"
+#include "engine_core/memory.h"
 #include "engine/shader/texture.h"
 
 
-HashTable TextureTable;
+ResourceTable TextureTable;
+
+
+Handle Texture_find(const char* alias) {
+    return ResourceTable_find(&TextureTable, (String) String_from_ptr(alias));
+}
+
+Handle Texture_find_String(String alias) {
+    return ResourceTable_find(&TextureTable, alias);
+}
+
+Handle Texture_find_Id(StringId alias) {
+    return ResourceTable_find_Id(&TextureTable, alias);
+}
+
+Texture* Texture_resolve(Handle handle) {
+    return ResourceTable_get(Texture, &TextureTable, handle);
+}
 
 
 bool Texture_get(const char* alias, Texture** outVal) {
-    return HashTable_find_reference(&TextureTable, (String) String_from_ptr(alias), outVal);
+    *outVal = Texture_resolve(Texture_find(alias));
+    return *outVal != NULL;
 }
 
 bool Texture_get_String(String alias, Texture** outVal) {
-    return HashTable_find_reference(&TextureTable, alias, outVal);
+    *outVal = Texture_resolve(Texture_find_String(alias));
+    return *outVal != NULL;
+}
+
+bool Texture_get_Id(StringId alias, Texture** outVal) {
+    *outVal = Texture_resolve(Texture_find_Id(alias));
+    return *outVal != NULL;
 }
 
 
 void InitTextures() {
     stbi_set_flip_vertically_on_load(true); // For some reason, if you flip the order, it corrupts TextureTable. EVIL. BAD. BAD FUNCTION. 
-    HashTable_initialize(Texture, &TextureTable, 512);
+    ResourceTable_initialize(Texture, &TextureTable, 512);
 }
 
 ecode DereferenceTextures() {
     // Call this function at the end of your program to ensure all tracked textures are properly cleaned up.
-    for (HashTable_array_iterator(&TextureTable)) {
-        Texture* texture = HashTable_array_at(Texture, &TextureTable, i);
+    for (u64 i = 0; i < ResourceTable_count(&TextureTable); ++i) {
+        Texture* texture = Texture_resolve(ResourceTable_handle_at(&TextureTable, i));
         if (texture->ID != GL_NONE) {
             glDeleteTextures(1, &(texture->ID));
         }
     }
-    HashTable_deinitialize(&TextureTable);
+    ResourceTable_deinitialize(&TextureTable);
     return 0;
 }
 
@@ -43,7 +68,7 @@ ecode DereferenceTextures() {
 void internal_Texture_extend_alias(const char* alias, String* out) {
     String aliasAsString = String_from_ptr(alias);
     u64 aliasLength = String_length(aliasAsString);
-    char* extendedAliasBuffer = (char*)calloc(aliasLength + 65, 1);
+    char* extendedAliasBuffer = (char*)Engine_calloc(aliasLength + 65, 1, MEMORY_TAG_TEXTURE);
     Engine_validate(extendedAliasBuffer, ENOMEM);
     String_clone_to_ptr(aliasAsString, extendedAliasBuffer);
 
@@ -51,10 +76,8 @@ void internal_Texture_extend_alias(const char* alias, String* out) {
     aliasAsString.end = extendedAliasBuffer + aliasLength;
     char* extendedAlias = extendedAliasBuffer + aliasLength;
 
-    Texture texture;
-    Texture* textureptr = &texture;
     u64 count = 0;
-    while (HashTable_find(&TextureTable, aliasAsString, texture)) {
+    while (ResourceTable_find(&TextureTable, aliasAsString) != HANDLE_NULL) {
         count++;
         sprintf(extendedAlias, "(%llu)\0", count);
         aliasAsString.end = FindBufferEnd(aliasAsString.start) - 1;
@@ -64,7 +87,7 @@ void internal_Texture_extend_alias(const char* alias, String* out) {
     out->end = aliasAsString.end;
 }
 
-void Texture_create(const char* alias, const TextureDescriptor descriptor) {
+Handle Texture_create(const char* alias, const TextureDescriptor descriptor) {
     // If only one texture is specified, no need to specify a path count. This way, if you forget at least something will happen.
     u32 pathCount = descriptor.pathCount;
     if (!pathCount && descriptor.paths) {
@@ -82,14 +105,20 @@ void Texture_create(const char* alias, const TextureDescriptor descriptor) {
 
         if (!data) {
             String_free_dirty(&aliasString);
-            return;
+            return HANDLE_NULL;
         }
 
         Internal_Texture_upload(&texture, descriptor, width, height, channels, pathCount, data);
         stbi_image_free(data);
     }
-    HashTable_insert(&TextureTable, aliasString, &texture);
+
+    // The alias was extended until it was unique, so the insert can't fail.
+    Handle handle;
+    Texture* slot = (Texture*)ResourceTable_insert(&TextureTable, aliasString, &handle);
+    *slot = texture;
+
     String_free_dirty(&aliasString);
+    return handle;
 }
 
 
@@ -98,13 +127,23 @@ void Texture_delete(const char* alias) {
 }
 
 void Texture_delete_String(String alias) {
-    Texture* texture;
+    Handle handle = Texture_find_String(alias);
 
-    if (!HashTable_find_reference(&TextureTable, alias, &texture)) {
+    if (handle == HANDLE_NULL) {
         printf("Error deleting Texture: \"%s\". No Texture with that name found.\n", alias.start);
         return;
     }
 
+    Texture_release(handle);
+}
+
+void Texture_release(Handle handle) {
+    Texture* texture = Texture_resolve(handle);
+
+    if (!texture) {
+        return;
+    }
+
     if (texture->references > 1) {
         texture->references--;
         return;
@@ -115,7 +154,7 @@ void Texture_delete_String(String alias) {
     }
 
     texture->ID = GL_NONE;
-    HashTable_remove(&TextureTable, alias);
+    ResourceTable_remove(&TextureTable, handle);
 }
 
 
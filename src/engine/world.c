@@ -0,0 +1,242 @@
+#include "errno.h"
+#include "string.h"
+
+#include "engine_core/engine_types.h"
+#include "engine_core/list.h"
+#include "engine_core/arena.h"
+#include "engine_core/memory.h"
+#include "engine_core/pool.h"
+
+#include "engine/math.h"
+#include "engine/culling.h"
+#include "engine/world.h"
+
+
+static const u32 ComponentSizes[COMPONENT_TYPE_COUNT] = {
+    sizeof(Transform),
+    sizeof(WorldMatrix),
+    sizeof(MeshRef),
+    sizeof(MaterialRef),
+    sizeof(Bounds),
+};
+
+
+void World_initialize(World* world) {
+    Pool_initialize(EntityRecord, &world->entities);
+
+    for (u8 type = 0; type < COMPONENT_TYPE_COUNT; ++type) {
+        world->components[type].data = NULL;
+        world->components[type].entities = NULL;
+        world->components[type].itemSize = ComponentSizes[type];
+        world->components[type].count = 0;
+        world->components[type].capacity = 0;
+    }
+}
+
+
+void World_deinitialize(World* world) {
+    for (u8 type = 0; type < COMPONENT_TYPE_COUNT; ++type) {
+        Engine_free(world->components[type].data);
+        Engine_free(world->components[type].entities);
+        world->components[type].data = NULL;
+        world->components[type].entities = NULL;
+        world->components[type].count = 0;
+        world->components[type].capacity = 0;
+    }
+
+    Pool_deinitialize(&world->entities);
+}
+
+
+Entity World_create_entity(World* world) {
+    Entity entity;
+    EntityRecord* record = (EntityRecord*)Pool_alloc(&world->entities, &entity);
+
+    for (u8 type = 0; type < COMPONENT_TYPE_COUNT; ++type) {
+        record->components[type] = COMPONENT_NONE;
+    }
+    return entity;
+}
+
+
+void World_destroy_entity(World* world, const Entity entity) {
+    if (!Pool_resolve(&world->entities, entity)) {
+        return;
+    }
+
+    for (u8 type = 0; type < COMPONENT_TYPE_COUNT; ++type) {
+        World_remove_component(world, entity, type);
+    }
+    Pool_free(&world->entities, entity);
+}
+
+
+void* internal_World_push(World* world, const Entity entity, EntityRecord* record, const u8 type) {
+    ComponentArray* array = &world->components[type];
+
+    if (array->count == array->capacity) {
+        u32 capacity = array->capacity ? array->capacity * 2 : 64;
+        array->data = (u8*)Engine_realloc(array->data, (u64)array->itemSize * capacity, MEMORY_TAG_GENERAL);
+        array->entities = (Entity*)Engine_realloc(array->entities, sizeof(Entity) * capacity, MEMORY_TAG_GENERAL);
+        Engine_validate(array->data && array->entities, ENOMEM);
+        array->capacity = capacity;
+    }
+
+    u32 index = array->count++;
+    array->entities[index] = entity;
+    record->components[type] = index;
+
+    void* component = array->data + (u64)array->itemSize * index;
+    memset(component, 0, array->itemSize);
+    return component;
+}
+
+
+void internal_World_pop(World* world, EntityRecord* record, const u8 type) {
+    // Move the last component into the hole, so the array stays packed.
+    ComponentArray* array = &world->components[type];
+    u32 index = record->components[type];
+    u32 last = --array->count;
+
+    if (index != last) {
+        Entity moved = array->entities[last];
+        memcpy(array->data + (u64)array->itemSize * index, array->data + (u64)array->itemSize * last, array->itemSize);
+        array->entities[index] = moved;
+        ((EntityRecord*)Pool_resolve(&world->entities, moved))->components[type] = index;
+    }
+    record->components[type] = COMPONENT_NONE;
+}
+
+
+void* World_add_component(World* world, const Entity entity, const u8 type) {
+    Engine_validate(type < COMPONENT_TYPE_COUNT, EINVAL);
+
+    EntityRecord* record = (EntityRecord*)Pool_resolve(&world->entities, entity);
+    if (!record) {
+        return NULL;
+    }
+
+    if (type == COMPONENT_WORLD_MATRIX) {
+        World_add_component(world, entity, COMPONENT_TRANSFORM);
+    }
+
+    if (record->components[type] != COMPONENT_NONE) {
+        return World_get_component(world, entity, type);
+    }
+
+    void* component = internal_World_push(world, entity, record, type);
+
+    if (type == COMPONENT_TRANSFORM) {
+        Transform* transform = (Transform*)component;
+        vec3_copy(V3_ZERO, transform->Local.Translation);
+        quaternion_copy(V4_IDENTIY, transform->Local.Rotation);
+        vec3_copy(V3_ONE, transform->Local.Scale);
+        transform->Dirty = true;
+
+        WorldMatrix* worldMatrix = (WorldMatrix*)internal_World_push(world, entity, record, COMPONENT_WORLD_MATRIX);
+        mat4_copy(MAT4_IDENTITY, worldMatrix->Matrix);
+    }
+
+    else if (type == COMPONENT_BOUNDS) {
+        *(Bounds*)component = BOUNDS_INFINITE;
+    }
+
+    return component;
+}
+
+
+void World_remove_component(World* world, const Entity entity, const u8 type) {
+    Engine_validate(type < COMPONENT_TYPE_COUNT, EINVAL);
+
+    EntityRecord* record = (EntityRecord*)Pool_resolve(&world->entities, entity);
+    if (!record || record->components[type] == COMPONENT_NONE) {
+        return;
+    }
+
+    // A Transform and its WorldMatrix go together. Both were last in their arrays when they were added together, and every removal
+    // since has moved the same entity into the same hole in both, so they stay at the same index.
+    if (type == COMPONENT_TRANSFORM || type == COMPONENT_WORLD_MATRIX) {
+        internal_World_pop(world, record, COMPONENT_TRANSFORM);
+        internal_World_pop(world, record, COMPONENT_WORLD_MATRIX);
+        return;
+    }
+
+    internal_World_pop(world, record, type);
+}
+
+
+void* World_get_component(const World* world, const Entity entity, const u8 type) {
+    EntityRecord* record = (EntityRecord*)Pool_resolve(&world->entities, entity);
+
+    if (type >= COMPONENT_TYPE_COUNT || !record || record->components[type] == COMPONENT_NONE) {
+        return NULL;
+    }
+
+    const ComponentArray* array = &world->components[type];
+    return array->data + (u64)array->itemSize * record->components[type];
+}
+
+
+TRS* World_edit_transform(World* world, const Entity entity) {
+    Transform* transform = World_get(Transform, world, entity, COMPONENT_TRANSFORM);
+
+    if (!transform) {
+        return NULL;
+    }
+
+    transform->Dirty = true;
+    return &transform->Local;
+}
+
+
+u64 World_update_world_matrices(World* world) {
+    Transform* transforms = World_components(Transform, world, COMPONENT_TRANSFORM);
+    WorldMatrix* matrices = World_components(WorldMatrix, world, COMPONENT_WORLD_MATRIX);
+    u32 count = World_component_count(world, COMPONENT_TRANSFORM);
+    u64 rebuilt = 0;
+
+    for (u32 i = 0; i < count; ++i) {
+        if (!transforms[i].Dirty) {
+            continue;
+        }
+
+        mat4_from_trs(transforms[i].Local.Translation, transforms[i].Local.Rotation, transforms[i].Local.Scale, matrices[i].Matrix);
+        transforms[i].Dirty = false;
+        rebuilt++;
+    }
+    return rebuilt;
+}
+
+
+void World_cull(const World* world, const Frustum* frustum, List* outVisible) {
+    const Bounds* bounds = World_components(Bounds, world, COMPONENT_BOUNDS);
+    const WorldMatrix* matrices = World_components(WorldMatrix, world, COMPONENT_WORLD_MATRIX);
+    u32 count = World_component_count(world, COMPONENT_BOUNDS);
+    u32 matrixCount = World_component_count(world, COMPONENT_WORLD_MATRIX);
+
+    ArenaScope scratch = Scratch_begin();
+    const Bounds** boundsOf = Scratch_push(const Bounds*, (u64)count + 1);
+    const GLfloat** transforms = Scratch_push(const GLfloat*, (u64)count + 1);
+    u32* visible = Scratch_push(u32, (u64)count + 1);
+
+    for (u32 i = 0; i < count; ++i) {
+        // Entities that got their components in the same order have them at the same index, so try that before the lookup.
+        Entity entity = World_component_entity(world, COMPONENT_BOUNDS, i);
+        u32 matrix = i;
+        if (i >= matrixCount || World_component_entity(world, COMPONENT_WORLD_MATRIX, i) != entity) {
+            matrix = ((const EntityRecord*)Pool_resolve(&world->entities, entity))->components[COMPONENT_WORLD_MATRIX];
+        }
+
+        boundsOf[i] = &bounds[i];
+        transforms[i] = (matrix != COMPONENT_NONE) ? matrices[matrix].Matrix : NULL;
+    }
+
+    u64 visibleCount = Frustum_cull_bounds(frustum, count, boundsOf, transforms, visible);
+
+    for (u64 i = 0; i < visibleCount; ++i) {
+        Entity entity = World_component_entity(world, COMPONENT_BOUNDS, visible[i]);
+        List_push_back(outVisible, entity);
+    }
+
+    Scratch_end(scratch);
+}
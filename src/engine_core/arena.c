@@ -0,0 +1,151 @@
+#include "assert.h"
+#include "errno.h"
+#include <string.h>
+
+#include "engine_core/engine_types.h"
+#include "engine_core/arena.h"
+#include "engine_core/memory.h"
+
+
+Arena FrameArena;
+Arena ScratchArena;
+
+
+#define internal_Arena_block_data(block) ((u8*)((block) + 1))
+#define internal_Arena_align(pointer, alignment) ((u8*)(((u64)(pointer) + ((alignment) - 1)) & ~((u64)(alignment) - 1)))
+
+
+ArenaBlock* internal_ArenaBlock_create(const u64 capacity) {
+    ArenaBlock* block = (ArenaBlock*)Engine_malloc(sizeof(ArenaBlock) + capacity, MEMORY_TAG_ARENA);
+    Engine_validate(block, ENOMEM);
+
+    block->next = NULL;
+    block->capacity = capacity;
+    return block;
+}
+
+
+void internal_Arena_use_block(Arena* arena, ArenaBlock* block) {
+    arena->current = block;
+    arena->position = internal_Arena_block_data(block);
+    arena->end = internal_Arena_block_data(block) + block->capacity;
+}
+
+
+void Arena_initialize(Arena* arena, const u64 blockSize) {
+    arena->blockSize = blockSize;
+    arena->first = internal_ArenaBlock_create(blockSize);
+    arena->reserved = blockSize;
+    internal_Arena_use_block(arena, arena->first);
+}
+
+
+void Arena_deinitialize(Arena* arena) {
+    ArenaBlock* block = arena->first;
+
+    while (block) {
+        ArenaBlock* next = block->next;
+        Engine_free(block);
+        block = next;
+    }
+
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->position = NULL;
+    arena->end = NULL;
+    arena->reserved = 0;
+}
+
+
+void Arena_reset(Arena* arena) {
+    internal_Arena_use_block(arena, arena->first);
+}
+
+
+void* internal_Arena_alloc_from_next_block(Arena* arena, const u64 size, const u64 alignment) {
+    // The current block is full. Move on to the next block that fits, or add one to the end of the chain.
+    // Blocks which are skipped over are free again after the next reset or rewind.
+
+    ArenaBlock* block = arena->current;
+    while (block->next) {
+        block = block->next;
+        if (block->capacity >= size + alignment) {
+            goto BlockFound;
+        }
+    }
+
+    u64 capacity = (size + alignment > arena->blockSize) ? size + alignment : arena->blockSize;
+    block->next = internal_ArenaBlock_create(capacity);
+    arena->reserved += capacity;
+    block = block->next;
+
+BlockFound:
+    internal_Arena_use_block(arena, block);
+
+    u8* allocation = internal_Arena_align(arena->position, alignment);
+    arena->position = allocation + size;
+    return allocation;
+}
+
+
+void* Arena_alloc(Arena* arena, const u64 size, const u64 alignment) {
+    u8* allocation = internal_Arena_align(arena->position, alignment);
+
+    if (allocation > arena->end || (u64)(arena->end - allocation) < size) {
+        return internal_Arena_alloc_from_next_block(arena, size, alignment);
+    }
+
+    arena->position = allocation + size;
+    return allocation;
+}
+
+
+void* Arena_alloc_zero(Arena* arena, const u64 size, const u64 alignment) {
+    void* allocation = Arena_alloc(arena, size, alignment);
+    memset(allocation, 0, size);
+    return allocation;
+}
+
+
+ArenaScope Arena_scope_begin(Arena* arena) {
+    ArenaScope scope = { .arena = arena, .block = arena->current, .position = arena->position };
+    return scope;
+}
+
+
+void Arena_scope_end(ArenaScope scope) {
+    Arena* arena = scope.arena;
+    arena->current = scope.block;
+    arena->position = scope.position;
+    arena->end = internal_Arena_block_data(scope.block) + scope.block->capacity;
+}
+
+
+u64 Arena_bytes_used(const Arena* arena) {
+    u64 used = 0;
+
+    for (ArenaBlock* block = arena->first; block != arena->current; block = block->next) {
+        used += block->capacity;
+    }
+    return used + (u64)(arena->position - internal_Arena_block_data(arena->current));
+}
+
+
+void Arenas_initialize() {
+    Arena_initialize(&FrameArena, ENGINE_FRAME_ARENA_SIZE);
+    Arena_initialize(&ScratchArena, ENGINE_SCRATCH_ARENA_SIZE);
+}
+
+
+void Arenas_deinitialize() {
+    Arena_deinitialize(&FrameArena);
+    Arena_deinitialize(&ScratchArena);
+}
+
+
+void Arenas_reset_frame() {
+    // Every scratch scope should be closed by the time the frame ends.
+    assert(ScratchArena.current == ScratchArena.first && ScratchArena.position == internal_Arena_block_data(ScratchArena.first));
+
+    Arena_reset(&FrameArena);
+}
@@ -0,0 +1,235 @@
+#include "errno.h"
+#include <string.h>
+
+#include "engine_core/engine_types.h"
+#include "engine_core/concurrent_hash_table.h"
+#include "engine_core/memory.h"
+
+// Reserved hash values. Real hashes are moved out of this range.
+#define CONCURRENT_HASH_TABLE_EMPTY 0
+#define CONCURRENT_HASH_TABLE_TOMBSTONE 1
+
+#define internal_ConcurrentHashTable_is_live(hash) ((hash) > CONCURRENT_HASH_TABLE_TOMBSTONE)
+
+
+u64 internal_ConcurrentHashTable_hash(const String key) {
+    u64 hash = String_hash(key);
+    return internal_ConcurrentHashTable_is_live(hash) ? hash : hash + 2;
+}
+
+
+ConcurrentHashTableSnapshot* internal_ConcurrentHashTableSnapshot_create(const u64 capacity, const u64 itemSize) {
+    // One allocation for the header and every array. Hashes come first after the header so they share its alignment.
+    u64 hashesSize = sizeof(_Atomic(u64)) * capacity;
+    u64 keysSize = sizeof(String) * capacity;
+
+    u8* memory = (u8*)Engine_malloc(sizeof(ConcurrentHashTableSnapshot) + hashesSize + keysSize + itemSize * capacity, MEMORY_TAG_HASH_TABLE);
+    Engine_validate(memory, ENOMEM);
+
+    ConcurrentHashTableSnapshot* snapshot = (ConcurrentHashTableSnapshot*)memory;
+    snapshot->capacity = capacity;
+    snapshot->hashes = (_Atomic(u64)*)(memory + sizeof(ConcurrentHashTableSnapshot));
+    snapshot->keys = (String*)((u8*)snapshot->hashes + hashesSize);
+    snapshot->values = (u8*)snapshot->keys + keysSize;
+
+    for (u64 i = 0; i < capacity; i++) {
+        atomic_init(&snapshot->hashes[i], CONCURRENT_HASH_TABLE_EMPTY);
+    }
+    return snapshot;
+}
+
+
+u64 internal_ConcurrentHashTable_place(ConcurrentHashTableSnapshot* snapshot, const u64 itemSize, const u64 hash, const String key, const void* value) {
+    // Write the key and value into the first empty slot, then publish them by storing the hash. A reader which sees the hash
+    // also sees everything written before it.
+    //
+
+    u64 mask = snapshot->capacity - 1;
+    u64 slot = hash & mask;
+
+    while (atomic_load_explicit(&snapshot->hashes[slot], memory_order_relaxed) != CONCURRENT_HASH_TABLE_EMPTY) {
+        slot = (slot + 1) & mask;
+    }
+
+    snapshot->keys[slot] = key;
+    memcpy(snapshot->values + slot * itemSize, value, itemSize);
+    atomic_store_explicit(&snapshot->hashes[slot], hash, memory_order_release);
+    return slot;
+}
+
+
+bool internal_ConcurrentHashTable_find_slot(ConcurrentHashTableSnapshot* snapshot, const u64 hash, const String key, u64* outSlot) {
+    u64 mask = snapshot->capacity - 1;
+
+    for (u64 slot = hash & mask;; slot = (slot + 1) & mask) {
+        u64 slotHash = atomic_load_explicit(&snapshot->hashes[slot], memory_order_acquire);
+
+        if (slotHash == CONCURRENT_HASH_TABLE_EMPTY) {
+            return false;
+        }
+
+        if (slotHash == hash && String_equal(snapshot->keys[slot], key)) {
+            *outSlot = slot;
+            return true;
+        }
+    }
+}
+
+
+void internal_ConcurrentHashTable_rebuild(ConcurrentHashTable* table, ConcurrentHashTableSnapshot* snapshot, const u64 count) {
+    // Copy the live items into a new snapshot, dropping the tombstones, and swap it in. Keys are shared with the old snapshot.
+    //
+
+    u64 capacity = 16;
+    while (capacity * CONCURRENT_HASH_TABLE_MAX_LOAD < (count + 1) * 512) {
+        capacity <<= 1;
+    }
+
+    ConcurrentHashTableSnapshot* rebuilt = internal_ConcurrentHashTableSnapshot_create(capacity, table->itemSize);
+
+    for (u64 slot = 0; slot < snapshot->capacity; slot++) {
+        u64 hash = atomic_load_explicit(&snapshot->hashes[slot], memory_order_relaxed);
+        if (internal_ConcurrentHashTable_is_live(hash)) {
+            internal_ConcurrentHashTable_place(rebuilt, table->itemSize, hash, snapshot->keys[slot], snapshot->values + slot * table->itemSize);
+        }
+    }
+
+    table->used = count;
+    atomic_store_explicit(&table->current, rebuilt, memory_order_release);
+    Vector_push_back(&table->retiredSnapshots, snapshot);
+}
+
+
+void internal_ConcurrentHashTable_initialize(ConcurrentHashTable* table, const u64 itemSize, const u64 capacity) {
+    u64 Capacity = 16;
+    while (Capacity < capacity) {
+        Capacity <<= 1;
+    }
+
+    atomic_init(&table->current, internal_ConcurrentHashTableSnapshot_create(Capacity, itemSize));
+    atomic_init(&table->count, 0);
+    table->itemSize = itemSize;
+    table->used = 0;
+
+    Mutex_initialize(&table->writeLock);
+    Vector_initialize(ConcurrentHashTableSnapshot*, &table->retiredSnapshots, 0);
+    Vector_initialize(char*, &table->retiredKeys, 0);
+}
+
+
+void ConcurrentHashTable_deinitialize(ConcurrentHashTable* table) {
+    ConcurrentHashTableSnapshot* snapshot = atomic_load_explicit(&table->current, memory_order_relaxed);
+
+    if (!snapshot) {
+        return;
+    }
+
+    // Live keys are owned by the current snapshot. Old snapshots only share them.
+    for (u64 slot = 0; slot < snapshot->capacity; slot++) {
+        if (internal_ConcurrentHashTable_is_live(atomic_load_explicit(&snapshot->hashes[slot], memory_order_relaxed))) {
+            String_free_dirty(&snapshot->keys[slot]);
+        }
+    }
+
+    ConcurrentHashTable_reclaim(table);
+    Engine_free(snapshot);
+    atomic_store_explicit(&table->current, NULL, memory_order_relaxed);
+
+    Vector_deinitialize(&table->retiredSnapshots);
+    Vector_deinitialize(&table->retiredKeys);
+    Mutex_deinitialize(&table->writeLock);
+}
+
+
+void ConcurrentHashTable_insert(ConcurrentHashTable* table, const String key, const void* value) {
+    if (!key.start || !key.end) {
+        return;
+    }
+
+    u64 hash = internal_ConcurrentHashTable_hash(key);
+
+    Mutex_lock(&table->writeLock);
+
+    ConcurrentHashTableSnapshot* snapshot = atomic_load_explicit(&table->current, memory_order_relaxed);
+    u64 count = atomic_load_explicit(&table->count, memory_order_relaxed);
+
+    // Every insert takes a new slot, even overwrites, so make room first.
+    if ((table->used + 1) * 256 > snapshot->capacity * CONCURRENT_HASH_TABLE_MAX_LOAD) {
+        internal_ConcurrentHashTable_rebuild(table, snapshot, count);
+        snapshot = atomic_load_explicit(&table->current, memory_order_relaxed);
+    }
+
+    u64 oldSlot;
+    if (internal_ConcurrentHashTable_find_slot(snapshot, hash, key, &oldSlot)) {
+        // The old slot comes first in the probe sequence, so readers keep finding the old value until it is marked as removed.
+        // The key moves to the new slot.
+        internal_ConcurrentHashTable_place(snapshot, table->itemSize, hash, snapshot->keys[oldSlot], value);
+        atomic_store_explicit(&snapshot->hashes[oldSlot], CONCURRENT_HASH_TABLE_TOMBSTONE, memory_order_release);
+    }
+    else {
+        String keyCopy;
+        String_create_dirty((String*)&key, &keyCopy);
+        internal_ConcurrentHashTable_place(snapshot, table->itemSize, hash, keyCopy, value);
+        atomic_store_explicit(&table->count, count + 1, memory_order_relaxed);
+    }
+    table->used++;
+
+    Mutex_unlock(&table->writeLock);
+}
+
+
+void ConcurrentHashTable_remove(ConcurrentHashTable* table, const String key) {
+    if (!key.start || !key.end) {
+        return;
+    }
+
+    u64 hash = internal_ConcurrentHashTable_hash(key);
+
+    Mutex_lock(&table->writeLock);
+
+    ConcurrentHashTableSnapshot* snapshot = atomic_load_explicit(&table->current, memory_order_relaxed);
+
+    u64 slot;
+    if (internal_ConcurrentHashTable_find_slot(snapshot, hash, key, &slot)) {
+        atomic_store_explicit(&snapshot->hashes[slot], CONCURRENT_HASH_TABLE_TOMBSTONE, memory_order_release);
+        Vector_push_back(&table->retiredKeys, snapshot->keys[slot].start);
+        atomic_store_explicit(&table->count, atomic_load_explicit(&table->count, memory_order_relaxed) - 1, memory_order_relaxed);
+    }
+
+    Mutex_unlock(&table->writeLock);
+}
+
+
+bool internal_ConcurrentHashTable_find(ConcurrentHashTable* table, const String key, void* out) {
+    if (!key.start || !key.end) {
+        return false;
+    }
+
+    ConcurrentHashTableSnapshot* snapshot = atomic_load_explicit(&table->current, memory_order_acquire);
+
+    u64 slot;
+    if (!internal_ConcurrentHashTable_find_slot(snapshot, internal_ConcurrentHashTable_hash(key), key, &slot)) {
+        return false;
+    }
+
+    memcpy(out, snapshot->values + slot * table->itemSize, table->itemSize);
+    return true;
+}
+
+
+void ConcurrentHashTable_reclaim(ConcurrentHashTable* table) {
+    Mutex_lock(&table->writeLock);
+
+    for (Vector_iterator(ConcurrentHashTableSnapshot*, &table->retiredSnapshots)) {
+        Engine_free(*it);
+    }
+
+    for (Vector_iterator(char*, &table->retiredKeys)) {
+        Engine_free(*it);
+    }
+
+    Vector_clear(&table->retiredSnapshots);
+    Vector_clear(&table->retiredKeys);
+
+    Mutex_unlock(&table->writeLock);
+}
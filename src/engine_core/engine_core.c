@@ -4,6 +4,9 @@
 #define LIST_IMPLEMENTATION
 #include "engine_core/list.h"
 
+#define VECTOR_IMPLEMENTATION
+#include "engine_core/vector.h"
+
 #define HASH_TABLE_IMPLEMENTATION
 #include "engine_core/string.h"
 #include "engine_core/hash_table.h"
@@ -0,0 +1,483 @@
+#include "errno.h"
+#include <string.h>
+
+#include "engine_core/engine_types.h"
+#include "engine_core/list.h"
+#include "engine_core/memory.h"
+#include "engine_core/job.h"
+
+#ifdef _MSC_VER
+#define internal_Jobs_thread_local __declspec(thread)
+#else
+#define internal_Jobs_thread_local _Thread_local
+#endif
+
+#define JOB_THREAD_INDEX_NONE 0xFFFFFFFFu
+
+
+typedef struct internal_Job {
+    Function_Void_OneParam function;    // Either function or rangeFunction is set.
+    Function_Void_Range rangeFunction;
+    void* data;
+    u64 start;
+    u64 end;
+    JobCounter* counter;
+} internal_Job;
+
+// A thief may read a slot while its owner writes it again, and then throws what it read away when it loses the race for top.
+// Every field is atomic so that read is allowed, relaxed since the ordering comes from top and bottom.
+typedef struct internal_JobSlot {
+    _Atomic(Function_Void_OneParam) function;
+    _Atomic(Function_Void_Range) rangeFunction;
+    _Atomic(void*) data;
+    _Atomic(u64) start;
+    _Atomic(u64) end;
+    _Atomic(JobCounter*) counter;
+} internal_JobSlot;
+
+// Chase-Lev deque. The owner pushes and takes at bottom, thieves take from top. Both indices only ever grow, and are kept on
+// separate cache lines, since top is written by thieves and bottom by the owner.
+typedef struct internal_JobDeque {
+    _Atomic(i64) top;
+    u8 topPadding[64 - sizeof(_Atomic(i64))];
+    _Atomic(i64) bottom;
+    u8 bottomPadding[64 - sizeof(_Atomic(i64))];
+    internal_JobSlot* slots;
+} internal_JobDeque;
+
+internal_JobDeque* JobDeques = NULL;    // One for every thread that runs jobs. The main thread's is 0.
+Thread* JobThreads = NULL;              // Worker threads. JobThreads[i] runs JobDeques[i + 1].
+u32 JobThreadCount = 0;                 // Counting the main thread. 0 while the job system isn't running.
+
+_Atomic(bool) JobsQuit;
+_Atomic(u64) JobsQueued;                // Jobs sitting in a deque.
+_Atomic(u32) JobsSleeping;              // Workers waiting on JobsWake.
+Mutex JobsSleepLock;
+Condition JobsWake;
+
+Mutex JobsMainLock;
+List JobsMainQueue;
+
+internal_Jobs_thread_local u32 JobThreadIndex = JOB_THREAD_INDEX_NONE;
+internal_Jobs_thread_local u32 JobStealSeed = 0;
+
+
+void internal_JobSlot_write(internal_JobSlot* slot, const internal_Job* job) {
+    atomic_store_explicit(&slot->function, job->function, memory_order_relaxed);
+    atomic_store_explicit(&slot->rangeFunction, job->rangeFunction, memory_order_relaxed);
+    atomic_store_explicit(&slot->data, job->data, memory_order_relaxed);
+    atomic_store_explicit(&slot->start, job->start, memory_order_relaxed);
+    atomic_store_explicit(&slot->end, job->end, memory_order_relaxed);
+    atomic_store_explicit(&slot->counter, job->counter, memory_order_relaxed);
+}
+
+
+void internal_JobSlot_read(internal_JobSlot* slot, internal_Job* out) {
+    out->function = atomic_load_explicit(&slot->function, memory_order_relaxed);
+    out->rangeFunction = atomic_load_explicit(&slot->rangeFunction, memory_order_relaxed);
+    out->data = atomic_load_explicit(&slot->data, memory_order_relaxed);
+    out->start = atomic_load_explicit(&slot->start, memory_order_relaxed);
+    out->end = atomic_load_explicit(&slot->end, memory_order_relaxed);
+    out->counter = atomic_load_explicit(&slot->counter, memory_order_relaxed);
+}
+
+
+bool internal_JobDeque_push(internal_JobDeque* deque, const internal_Job* job) {
+    i64 bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    i64 top = atomic_load_explicit(&deque->top, memory_order_acquire);
+
+    if (bottom - top >= JOB_DEQUE_CAPACITY) {
+        return false;
+    }
+
+    internal_JobSlot_write(&deque->slots[bottom & (JOB_DEQUE_CAPACITY - 1)], job);
+
+    // Publishes the slot to thieves, who load bottom with acquire.
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+    return true;
+}
+
+
+bool internal_JobDeque_take(internal_JobDeque* deque, internal_Job* out) {
+    // Claim the bottom job first, then check whether a thief got to it. The store to bottom and the load of top must not be
+    // reordered, or the owner and a thief can both take the last job.
+    //
+
+    i64 bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_seq_cst);
+    i64 top = atomic_load_explicit(&deque->top, memory_order_seq_cst);
+
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return false;
+    }
+
+    internal_JobSlot_read(&deque->slots[bottom & (JOB_DEQUE_CAPACITY - 1)], out);
+
+    if (top == bottom) {
+        // Last job, race the thieves for it.
+        bool won = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+
+bool internal_JobDeque_steal(internal_JobDeque* deque, internal_Job* out) {
+    i64 top = atomic_load_explicit(&deque->top, memory_order_seq_cst);
+    i64 bottom = atomic_load_explicit(&deque->bottom, memory_order_seq_cst);
+
+    if (top >= bottom) {
+        return false;
+    }
+
+    internal_JobSlot_read(&deque->slots[top & (JOB_DEQUE_CAPACITY - 1)], out);
+    return atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+}
+
+
+void internal_Job_run(const internal_Job* job) {
+    if (job->function) {
+        job->function(job->data);
+    }
+    else {
+        job->rangeFunction(job->data, job->start, job->end);
+    }
+
+    if (job->counter) {
+        atomic_fetch_sub_explicit(&job->counter->value, 1, memory_order_release);
+    }
+}
+
+
+bool internal_Jobs_is_job_thread() {
+    return JobThreadIndex < JobThreadCount;
+}
+
+
+void internal_Jobs_wake(const u32 count) {
+    if (atomic_load_explicit(&JobsSleeping, memory_order_seq_cst) == 0) {
+        return;
+    }
+
+    // Taking the lock makes sure a worker that just decided to sleep is already waiting, so it can't miss the wake up.
+    Mutex_lock(&JobsSleepLock);
+    if (count == 1) {
+        Condition_wake_one(&JobsWake);
+    }
+    else {
+        Condition_wake_all(&JobsWake);
+    }
+    Mutex_unlock(&JobsSleepLock);
+}
+
+
+bool internal_Jobs_push(const internal_Job* job) {
+    // Returns false when the job couldn't be queued and the caller should run it. Either way the job is counted, and running it
+    // takes it off the counter again.
+    //
+
+    if (job->counter) {
+        atomic_fetch_add_explicit(&job->counter->value, 1, memory_order_relaxed);
+    }
+
+    if (!internal_Jobs_is_job_thread()) {
+        return false;
+    }
+
+    // Counted before it is pushed, so a thief can never take it off JobsQueued first.
+    atomic_fetch_add_explicit(&JobsQueued, 1, memory_order_seq_cst);
+
+    if (!internal_JobDeque_push(&JobDeques[JobThreadIndex], job)) {
+        atomic_fetch_sub_explicit(&JobsQueued, 1, memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+
+bool internal_Jobs_find(internal_Job* out) {
+    if (internal_JobDeque_take(&JobDeques[JobThreadIndex], out)) {
+        return true;
+    }
+
+    if (atomic_load_explicit(&JobsQueued, memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    // Try every other thread once, starting from a random one so thieves spread out.
+    JobStealSeed ^= JobStealSeed << 13;
+    JobStealSeed ^= JobStealSeed >> 17;
+    JobStealSeed ^= JobStealSeed << 5;
+
+    for (u32 i = 0; i < JobThreadCount; i++) {
+        u32 victim = (JobStealSeed + i) % JobThreadCount;
+
+        if (victim != JobThreadIndex && internal_JobDeque_steal(&JobDeques[victim], out)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool internal_Jobs_run_one() {
+    internal_Job job;
+
+    if (!internal_Jobs_find(&job)) {
+        return false;
+    }
+
+    atomic_fetch_sub_explicit(&JobsQueued, 1, memory_order_relaxed);
+    internal_Job_run(&job);
+    return true;
+}
+
+
+bool internal_Jobs_run_one_main() {
+    internal_Job job;
+
+    Mutex_lock(&JobsMainLock);
+    if (List_isEmpty(&JobsMainQueue)) {
+        Mutex_unlock(&JobsMainLock);
+        return false;
+    }
+    List_pop_back(&JobsMainQueue, job);     // Oldest first.
+    Mutex_unlock(&JobsMainLock);
+
+    internal_Job_run(&job);
+    return true;
+}
+
+
+void internal_Jobs_worker(void* indexPtr) {
+    JobThreadIndex = (u32)(u64)indexPtr;
+    JobStealSeed = JobThreadIndex * 0x9E3779B9u + 1;
+
+    while (!atomic_load_explicit(&JobsQuit, memory_order_acquire)) {
+        if (internal_Jobs_run_one()) {
+            continue;
+        }
+
+        // Nothing to run. Announce the sleep before checking for work one last time, so a submit either sees the sleeper or the
+        // sleeper sees the job.
+        Mutex_lock(&JobsSleepLock);
+        atomic_fetch_add_explicit(&JobsSleeping, 1, memory_order_seq_cst);
+
+        if (atomic_load_explicit(&JobsQueued, memory_order_seq_cst) == 0 && !atomic_load_explicit(&JobsQuit, memory_order_acquire)) {
+            Condition_wait(&JobsWake, &JobsSleepLock);
+        }
+
+        atomic_fetch_sub_explicit(&JobsSleeping, 1, memory_order_relaxed);
+        Mutex_unlock(&JobsSleepLock);
+    }
+}
+
+
+void Jobs_initialize(const u32 workerCount) {
+    if (JobThreadCount) {
+        return;
+    }
+
+    u32 workers = workerCount;
+    if (!workers) {
+        u32 cores = Thread_hardware_concurrency();
+        workers = (cores > 1) ? cores - 1 : 0;
+    }
+
+    atomic_init(&JobsQuit, false);
+    atomic_init(&JobsQueued, 0);
+    atomic_init(&JobsSleeping, 0);
+    Mutex_initialize(&JobsSleepLock);
+    Condition_initialize(&JobsWake);
+    Mutex_initialize(&JobsMainLock);
+    List_initialize(internal_Job, &JobsMainQueue, 64);
+
+    JobDeques = (internal_JobDeque*)Engine_calloc(workers + 1, sizeof(internal_JobDeque), MEMORY_TAG_GENERAL);
+    Engine_validate(JobDeques, ENOMEM);
+
+    for (u32 i = 0; i < workers + 1; i++) {
+        atomic_init(&JobDeques[i].top, 0);
+        atomic_init(&JobDeques[i].bottom, 0);
+        JobDeques[i].slots = (internal_JobSlot*)Engine_calloc(JOB_DEQUE_CAPACITY, sizeof(internal_JobSlot), MEMORY_TAG_GENERAL);
+        Engine_validate(JobDeques[i].slots, ENOMEM);
+    }
+
+    JobThreadIndex = 0;
+    JobStealSeed = 1;
+    JobThreadCount = workers + 1;
+
+    if (!workers) {
+        return;
+    }
+
+    JobThreads = (Thread*)Engine_calloc(workers, sizeof(Thread), MEMORY_TAG_GENERAL);
+    Engine_validate(JobThreads, ENOMEM);
+
+    for (u32 i = 0; i < workers; i++) {
+        Engine_validate(Thread_create(&JobThreads[i], internal_Jobs_worker, (void*)(u64)(i + 1)), EAGAIN);
+    }
+}
+
+
+void Jobs_deinitialize() {
+    if (!JobThreadCount) {
+        return;
+    }
+
+    // Finish whatever is still queued. Jobs still running on a worker must not submit more from here on.
+    for (;;) {
+        if (internal_Jobs_run_one() || internal_Jobs_run_one_main()) {
+            continue;
+        }
+
+        if (!atomic_load_explicit(&JobsQueued, memory_order_acquire)) {
+            break;
+        }
+        Thread_yield();
+    }
+
+    Mutex_lock(&JobsSleepLock);
+    atomic_store_explicit(&JobsQuit, true, memory_order_release);
+    Condition_wake_all(&JobsWake);
+    Mutex_unlock(&JobsSleepLock);
+
+    for (u32 i = 0; i < JobThreadCount - 1; i++) {
+        Thread_join(&JobThreads[i]);
+    }
+
+    for (u32 i = 0; i < JobThreadCount; i++) {
+        Engine_free(JobDeques[i].slots);
+    }
+
+    Engine_free(JobThreads);
+    Engine_free(JobDeques);
+    JobThreads = NULL;
+    JobDeques = NULL;
+    JobThreadCount = 0;
+    JobThreadIndex = JOB_THREAD_INDEX_NONE;
+
+    List_deinitialize(&JobsMainQueue);
+    Mutex_deinitialize(&JobsMainLock);
+    Condition_deinitialize(&JobsWake);
+    Mutex_deinitialize(&JobsSleepLock);
+}
+
+
+u32 Jobs_thread_count() {
+    return JobThreadCount;
+}
+
+
+u32 Jobs_thread_index() {
+    return internal_Jobs_is_job_thread() ? JobThreadIndex : JobThreadCount;
+}
+
+
+void Job_submit(Function_Void_OneParam function, void* data, JobCounter* counter) {
+    internal_Job job = { .function = function, .data = data, .counter = counter };
+
+    if (!internal_Jobs_push(&job)) {
+        internal_Job_run(&job);
+        return;
+    }
+    internal_Jobs_wake(1);
+}
+
+
+void Job_parallel_for(const u64 count, const u64 batchSize, Function_Void_Range function, void* data, JobCounter* counter) {
+    if (!count) {
+        return;
+    }
+
+    if (!internal_Jobs_is_job_thread() || JobThreadCount == 1) {
+        function(data, 0, count);
+        return;
+    }
+
+    // Without a batch size, aim for a few batches per thread so the load can even out.
+    u64 BatchSize = batchSize;
+    if (!BatchSize) {
+        BatchSize = count / ((u64)JobThreadCount * 4);
+        BatchSize = BatchSize ? BatchSize : 1;
+    }
+
+    JobCounter localCounter;
+    JobCounter* Counter = counter;
+    if (!Counter) {
+        JobCounter_initialize(&localCounter);
+        Counter = &localCounter;
+    }
+
+    // Push the last batch first. The owner takes from the bottom and starts at the front of the range, thieves take from the top
+    // and start at the back.
+    u64 batches = (count + BatchSize - 1) / BatchSize;
+    for (u64 i = batches; i-- > 0;) {
+        u64 start = i * BatchSize;
+        u64 end = (start + BatchSize < count) ? start + BatchSize : count;
+        internal_Job job = { .rangeFunction = function, .data = data, .start = start, .end = end, .counter = Counter };
+
+        if (!internal_Jobs_push(&job)) {
+            internal_Job_run(&job);
+        }
+    }
+    internal_Jobs_wake(JobThreadCount);
+
+    if (!counter) {
+        JobCounter_wait(&localCounter);
+    }
+}
+
+
+void Job_submit_main(Function_Void_OneParam function, void* data, JobCounter* counter) {
+    internal_Job job = { .function = function, .data = data, .counter = counter };
+
+    if (counter) {
+        atomic_fetch_add_explicit(&counter->value, 1, memory_order_relaxed);
+    }
+
+    if (!JobThreadCount) {
+        internal_Job_run(&job);
+        return;
+    }
+
+    Mutex_lock(&JobsMainLock);
+    List_push_back(&JobsMainQueue, job);
+    Mutex_unlock(&JobsMainLock);
+}
+
+
+void Jobs_run_main() {
+    // One at a time, since a job may queue more or wait on a counter, which runs this queue too.
+    while (internal_Jobs_run_one_main());
+}
+
+
+void JobCounter_initialize(JobCounter* counter) {
+    atomic_init(&counter->value, 0);
+}
+
+
+bool JobCounter_is_done(JobCounter* counter) {
+    return atomic_load_explicit(&counter->value, memory_order_acquire) == 0;
+}
+
+
+void JobCounter_wait(JobCounter* counter) {
+    while (!JobCounter_is_done(counter)) {
+        if (!internal_Jobs_is_job_thread()) {
+            Thread_yield();
+            continue;
+        }
+
+        if (internal_Jobs_run_one()) {
+            continue;
+        }
+
+        if (JobThreadIndex == 0 && internal_Jobs_run_one_main()) {
+            continue;
+        }
+        Thread_yield();
+    }
+}
@@ -0,0 +1,183 @@
+#include "assert.h"
+#include "stdio.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#include "engine_core/engine_types.h"
+#include "engine_core/memory.h"
+
+
+typedef struct internal_MemoryCounters {
+    _Atomic(u64) liveBytes;
+    _Atomic(u64) peakBytes;
+    _Atomic(u64) liveAllocations;
+    _Atomic(u64) totalAllocations;
+    _Atomic(u64) frameAllocations;
+    _Atomic(u64) frameBytes;
+} internal_MemoryCounters;
+
+// Put in front of every tracked allocation. 16 bytes, so the memory after it keeps the alignment malloc gives.
+typedef struct internal_MemoryHeader {
+    u64 size;
+    u64 tag;
+} internal_MemoryHeader;
+
+static internal_MemoryCounters MemoryCounters[MEMORY_TAG_COUNT];
+static u64 MemoryFrameIndex = 0;
+
+static const char* MemoryTagNames[MEMORY_TAG_COUNT] = {
+    "General", "List", "Vector", "HashTable", "String", "Arena", "Pool", "Shader", "Texture", "Material", "Mesh",
+};
+
+
+void internal_Memory_track_alloc(const u64 size, const u8 tag) {
+    internal_MemoryCounters* counters = &MemoryCounters[tag];
+
+    u64 live = atomic_fetch_add_explicit(&counters->liveBytes, size, memory_order_relaxed) + size;
+    atomic_fetch_add_explicit(&counters->liveAllocations, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&counters->totalAllocations, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&counters->frameAllocations, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&counters->frameBytes, size, memory_order_relaxed);
+
+    u64 peak = atomic_load_explicit(&counters->peakBytes, memory_order_relaxed);
+    while (live > peak && !atomic_compare_exchange_weak_explicit(&counters->peakBytes, &peak, live, memory_order_relaxed, memory_order_relaxed));
+}
+
+
+void internal_Memory_track_free(const u64 size, const u8 tag) {
+    internal_MemoryCounters* counters = &MemoryCounters[tag];
+
+    atomic_fetch_sub_explicit(&counters->liveBytes, size, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&counters->liveAllocations, 1, memory_order_relaxed);
+}
+
+
+void* Memory_alloc(const u64 size, const u8 tag) {
+    u8 Tag = (tag < MEMORY_TAG_COUNT) ? tag : MEMORY_TAG_GENERAL;
+
+    internal_MemoryHeader* header = (internal_MemoryHeader*)malloc(sizeof(internal_MemoryHeader) + size);
+    if (!header) {
+        return NULL;
+    }
+
+    header->size = size;
+    header->tag = Tag;
+    internal_Memory_track_alloc(size, Tag);
+    return header + 1;
+}
+
+
+void* Memory_calloc(const u64 count, const u64 size, const u8 tag) {
+    if (size && count > (~0ull - sizeof(internal_MemoryHeader)) / size) {
+        return NULL;
+    }
+
+    void* memory = Memory_alloc(count * size, tag);
+    if (memory) {
+        memset(memory, 0, count * size);
+    }
+    return memory;
+}
+
+
+void* Memory_realloc(void* pointer, const u64 size, const u8 tag) {
+    if (!pointer) {
+        return Memory_alloc(size, tag);
+    }
+
+    internal_MemoryHeader* header = (internal_MemoryHeader*)pointer - 1;
+    u64 oldSize = header->size;
+    u8 oldTag = (u8)header->tag;
+
+    internal_MemoryHeader* resized = (internal_MemoryHeader*)realloc(header, sizeof(internal_MemoryHeader) + size);
+    if (!resized) {
+        return NULL;
+    }
+
+    internal_Memory_track_free(oldSize, oldTag);
+    resized->size = size;
+    internal_Memory_track_alloc(size, oldTag);
+    return resized + 1;
+}
+
+
+void Memory_free(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+
+    internal_MemoryHeader* header = (internal_MemoryHeader*)pointer - 1;
+    internal_Memory_track_free(header->size, (u8)header->tag);
+    free(header);
+}
+
+
+void Memory_get_stats(const u8 tag, MemoryStats* out) {
+    memset(out, 0, sizeof(MemoryStats));
+
+    if (tag >= MEMORY_TAG_COUNT) {
+        return;
+    }
+
+    internal_MemoryCounters* counters = &MemoryCounters[tag];
+    out->liveBytes = atomic_load_explicit(&counters->liveBytes, memory_order_relaxed);
+    out->peakBytes = atomic_load_explicit(&counters->peakBytes, memory_order_relaxed);
+    out->liveAllocations = atomic_load_explicit(&counters->liveAllocations, memory_order_relaxed);
+    out->totalAllocations = atomic_load_explicit(&counters->totalAllocations, memory_order_relaxed);
+    out->frameAllocations = atomic_load_explicit(&counters->frameAllocations, memory_order_relaxed);
+    out->frameBytes = atomic_load_explicit(&counters->frameBytes, memory_order_relaxed);
+}
+
+
+void Memory_get_total(MemoryStats* out) {
+    memset(out, 0, sizeof(MemoryStats));
+
+    for (u8 tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        MemoryStats stats;
+        Memory_get_stats(tag, &stats);
+
+        out->liveBytes += stats.liveBytes;
+        out->peakBytes += stats.peakBytes;
+        out->liveAllocations += stats.liveAllocations;
+        out->totalAllocations += stats.totalAllocations;
+        out->frameAllocations += stats.frameAllocations;
+        out->frameBytes += stats.frameBytes;
+    }
+}
+
+
+const char* Memory_tag_name(const u8 tag) {
+    return (tag < MEMORY_TAG_COUNT) ? MemoryTagNames[tag] : "Unknown";
+}
+
+
+void Memory_report() {
+    printf("%-12s %14s %14s %12s %14s %12s\n", "Tag", "Live bytes", "Peak bytes", "Live allocs", "Total allocs", "Frame allocs");
+
+    for (u8 tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        MemoryStats stats;
+        Memory_get_stats(tag, &stats);
+        printf("%-12s %14llu %14llu %12llu %14llu %12llu\n", Memory_tag_name(tag), (unsigned long long)stats.liveBytes, (unsigned long long)stats.peakBytes,
+            (unsigned long long)stats.liveAllocations, (unsigned long long)stats.totalAllocations, (unsigned long long)stats.frameAllocations);
+    }
+}
+
+
+void Memory_begin_frame() {
+#ifdef ENGINE_ASSERT_FRAME_ALLOCATIONS
+    MemoryStats total;
+    Memory_get_total(&total);
+
+    if (MemoryFrameIndex > ENGINE_ALLOCATION_WARMUP_FRAMES && total.frameAllocations) {
+        printf("Frame %llu allocated %llu times (%llu bytes) after warmup:\n", (unsigned long long)MemoryFrameIndex, (unsigned long long)total.frameAllocations, (unsigned long long)total.frameBytes);
+        Memory_report();
+        assert(!"Allocated from the heap during a frame after warmup.");
+    }
+#endif
+
+    for (u8 tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        atomic_store_explicit(&MemoryCounters[tag].frameAllocations, 0, memory_order_relaxed);
+        atomic_store_explicit(&MemoryCounters[tag].frameBytes, 0, memory_order_relaxed);
+    }
+    MemoryFrameIndex++;
+}
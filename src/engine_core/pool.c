@@ -0,0 +1,141 @@
+#include "errno.h"
+#include <string.h>
+
+#include "engine_core/engine_types.h"
+#include "engine_core/pool.h"
+#include "engine_core/memory.h"
+
+
+#define internal_Pool_slab_size(pool) ((u64)(pool)->itemSize * POOL_SLAB_CAPACITY)
+#define internal_Pool_slot(pool, index) ((pool)->slabs[(index) / POOL_SLAB_CAPACITY] + (u64)((index) & (POOL_SLAB_CAPACITY - 1)) * (pool)->itemSize)
+
+// Free slots store the index of the next free slot in their first bytes.
+#define internal_Pool_next_free(pool, index) (*(u32*)internal_Pool_slot(pool, index))
+
+
+void internal_Pool_initialize(Pool* pool, const u32 itemSize) {
+    // Round slots up to 16 bytes, so every item is aligned well enough for math types and SIMD loads.
+    u32 size = (itemSize < sizeof(u32)) ? sizeof(u32) : itemSize;
+
+    pool->slabs = NULL;
+    pool->generations = NULL;
+    pool->slabCount = 0;
+    pool->capacity = 0;
+    pool->count = 0;
+    pool->itemSize = (size + 15) & ~15u;
+    pool->retired = 0;
+    pool->freeHead = POOL_MAX_ITEMS;
+    pool->freeTail = POOL_MAX_ITEMS;
+}
+
+
+void Pool_deinitialize(Pool* pool) {
+    for (u32 i = 0; i < pool->slabCount; i++) {
+        Engine_free(pool->slabs[i]);
+    }
+
+    Engine_free(pool->slabs);
+    Engine_free(pool->generations);
+
+    pool->slabs = NULL;
+    pool->generations = NULL;
+    pool->slabCount = 0;
+    pool->capacity = 0;
+    pool->count = 0;
+    pool->retired = 0;
+    pool->freeHead = POOL_MAX_ITEMS;
+    pool->freeTail = POOL_MAX_ITEMS;
+}
+
+
+void internal_Pool_push_free(Pool* pool, const u32 index) {
+    // Append to the free list, so the slot is reused after every slot freed before it.
+    internal_Pool_next_free(pool, index) = POOL_MAX_ITEMS;
+
+    if (pool->freeHead == POOL_MAX_ITEMS) {
+        pool->freeHead = index;
+    }
+
+    else {
+        internal_Pool_next_free(pool, pool->freeTail) = index;
+    }
+    pool->freeTail = index;
+}
+
+
+void internal_Pool_add_slab(Pool* pool) {
+    // Out of handle bits, every index is in use or retired.
+    Engine_validate(pool->capacity + POOL_SLAB_CAPACITY <= POOL_MAX_ITEMS, ENOMEM);
+
+    u8** slabs = (u8**)Engine_realloc(pool->slabs, sizeof(u8*) * (pool->slabCount + 1), MEMORY_TAG_POOL);
+    Engine_validate(slabs, ENOMEM);
+    pool->slabs = slabs;
+
+    u16* generations = (u16*)Engine_realloc(pool->generations, sizeof(u16) * (pool->capacity + POOL_SLAB_CAPACITY), MEMORY_TAG_POOL);
+    Engine_validate(generations, ENOMEM);
+    pool->generations = generations;
+
+    u8* slab = (u8*)Engine_malloc(internal_Pool_slab_size(pool), MEMORY_TAG_POOL);
+    Engine_validate(slab, ENOMEM);
+    pool->slabs[pool->slabCount] = slab;
+    pool->slabCount++;
+
+    // Chain the new slots onto the free list in order, so items are handed out front to back.
+    u32 first = pool->capacity;
+    pool->capacity += POOL_SLAB_CAPACITY;
+
+    for (u32 index = first; index < pool->capacity; index++) {
+        pool->generations[index] = 1;
+        internal_Pool_push_free(pool, index);
+    }
+}
+
+
+void* Pool_alloc(Pool* pool, Handle* outHandle) {
+    if (pool->freeHead == POOL_MAX_ITEMS) {
+        internal_Pool_add_slab(pool);
+    }
+
+    u32 index = pool->freeHead;
+    u8* item = internal_Pool_slot(pool, index);
+    pool->freeHead = *(u32*)item;
+    pool->count++;
+
+    if (outHandle) {
+        *outHandle = Handle_make(index, pool->generations[index]);
+    }
+    return item;
+}
+
+
+void Pool_free(Pool* pool, const Handle handle) {
+    if (!Pool_resolve(pool, handle)) {
+        return;
+    }
+
+    u32 index = Handle_index(handle);
+
+    pool->count--;
+
+    // Bump the generation so every outstanding Handle to this slot goes stale. Wrapping would bring back generations old Handles
+    // may still carry, so retire the slot instead: generation 0 matches no Handle, and it never goes back on the free list.
+    if (pool->generations[index] == POOL_HANDLE_GENERATION_MASK) {
+        pool->generations[index] = 0;
+        pool->retired++;
+        return;
+    }
+
+    pool->generations[index]++;
+    internal_Pool_push_free(pool, index);
+}
+
+
+void* Pool_resolve(const Pool* pool, const Handle handle) {
+    u32 index = Handle_index(handle);
+    u32 generation = Handle_generation(handle);
+
+    if (!generation || index >= pool->capacity || pool->generations[index] != generation) {
+        return NULL;
+    }
+    return internal_Pool_slot(pool, index);
+}
@@ -0,0 +1,234 @@
+#include "errno.h"
+#include <string.h>
+
+#include "engine_core/engine_types.h"
+#include "engine_core/memory.h"
+#include "engine_core/queue.h"
+
+
+u64 internal_Queue_capacity(const u64 capacity) {
+    u64 Capacity = 2;
+    while (Capacity < capacity) {
+        Capacity <<= 1;
+    }
+    return Capacity;
+}
+
+
+void internal_Queue_copy_in(u8* data, const u64 mask, const u64 itemSize, const u64 position, const u8* items, const u64 count) {
+    // Copy count items into the ring starting at position, in at most two pieces when the range wraps around the end.
+    u64 first = position & mask;
+    u64 firstCount = (mask + 1 - first < count) ? mask + 1 - first : count;
+
+    memcpy(data + first * itemSize, items, firstCount * itemSize);
+    memcpy(data, items + firstCount * itemSize, (count - firstCount) * itemSize);
+}
+
+
+void internal_Queue_copy_out(const u8* data, const u64 mask, const u64 itemSize, const u64 position, u8* out, const u64 count) {
+    u64 first = position & mask;
+    u64 firstCount = (mask + 1 - first < count) ? mask + 1 - first : count;
+
+    memcpy(out, data + first * itemSize, firstCount * itemSize);
+    memcpy(out + firstCount * itemSize, data, (count - firstCount) * itemSize);
+}
+
+
+void internal_SpscQueue_initialize(SpscQueue* queue, const u64 itemSize, const u64 capacity) {
+    u64 Capacity = internal_Queue_capacity(capacity);
+
+    queue->data = (u8*)Engine_malloc(itemSize * Capacity, MEMORY_TAG_GENERAL);
+    Engine_validate(queue->data, ENOMEM);
+    queue->mask = Capacity - 1;
+    queue->itemSize = itemSize;
+
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    queue->cachedHead = 0;
+    queue->cachedTail = 0;
+}
+
+
+void SpscQueue_deinitialize(SpscQueue* queue) {
+    Engine_free(queue->data);
+    queue->data = NULL;
+    queue->mask = 0;
+}
+
+
+u64 SpscQueue_push_n(SpscQueue* queue, const void* items, const u64 count) {
+    u64 tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    u64 capacity = queue->mask + 1;
+
+    // Only look at the consumer's index when the cached one says there isn't room.
+    if (capacity - (tail - queue->cachedHead) < count) {
+        queue->cachedHead = atomic_load_explicit(&queue->head, memory_order_acquire);
+    }
+
+    u64 space = capacity - (tail - queue->cachedHead);
+    u64 pushed = (space < count) ? space : count;
+
+    if (!pushed) {
+        return 0;
+    }
+
+    internal_Queue_copy_in(queue->data, queue->mask, queue->itemSize, tail, (const u8*)items, pushed);
+    atomic_store_explicit(&queue->tail, tail + pushed, memory_order_release);
+    return pushed;
+}
+
+
+u64 SpscQueue_pop_n(SpscQueue* queue, void* out, const u64 count) {
+    u64 head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    if (queue->cachedTail - head < count) {
+        queue->cachedTail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    }
+
+    u64 available = queue->cachedTail - head;
+    u64 popped = (available < count) ? available : count;
+
+    if (!popped) {
+        return 0;
+    }
+
+    internal_Queue_copy_out(queue->data, queue->mask, queue->itemSize, head, (u8*)out, popped);
+    atomic_store_explicit(&queue->head, head + popped, memory_order_release);
+    return popped;
+}
+
+
+bool internal_SpscQueue_push(SpscQueue* queue, const void* item) {
+    return SpscQueue_push_n(queue, item, 1) == 1;
+}
+
+
+bool internal_SpscQueue_pop(SpscQueue* queue, void* out) {
+    return SpscQueue_pop_n(queue, out, 1) == 1;
+}
+
+
+u64 SpscQueue_count(SpscQueue* queue) {
+    return atomic_load_explicit(&queue->tail, memory_order_acquire) - atomic_load_explicit(&queue->head, memory_order_acquire);
+}
+
+
+void internal_MpmcQueue_initialize(MpmcQueue* queue, const u64 itemSize, const u64 capacity) {
+    u64 Capacity = internal_Queue_capacity(capacity);
+
+    queue->data = (u8*)Engine_malloc(itemSize * Capacity, MEMORY_TAG_GENERAL);
+    Engine_validate(queue->data, ENOMEM);
+    queue->sequences = (_Atomic(u64)*)Engine_malloc(sizeof(_Atomic(u64)) * Capacity, MEMORY_TAG_GENERAL);
+    Engine_validate(queue->sequences, ENOMEM);
+    queue->mask = Capacity - 1;
+    queue->itemSize = itemSize;
+
+    for (u64 i = 0; i < Capacity; i++) {
+        atomic_init(&queue->sequences[i], i);
+    }
+
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+}
+
+
+void MpmcQueue_deinitialize(MpmcQueue* queue) {
+    Engine_free(queue->data);
+    Engine_free((void*)queue->sequences);
+    queue->data = NULL;
+    queue->sequences = NULL;
+    queue->mask = 0;
+}
+
+
+u64 internal_MpmcQueue_claim(MpmcQueue* queue, _Atomic(u64)* index, const u64 ready, const u64 count, u64* outPosition) {
+    // Claim up to count positions from index, in a row, whose slots have the sequence position + ready. Returns how many were
+    // claimed, and the first of them through outPosition.
+    //
+
+    u64 position = atomic_load_explicit(index, memory_order_relaxed);
+
+    for (;;) {
+        u64 claimed = 0;
+        i64 difference = 0;
+
+        while (claimed < count) {
+            u64 sequence = atomic_load_explicit(&queue->sequences[(position + claimed) & queue->mask], memory_order_acquire);
+            difference = (i64)(sequence - (position + claimed + ready));
+
+            if (difference != 0) {
+                break;
+            }
+            claimed++;
+        }
+
+        if (!claimed) {
+            // Behind means the slot hasn't been released from the last lap yet, so the queue is full or empty. Ahead means another
+            // thread claimed it first and position is out of date.
+            if (difference < 0) {
+                return 0;
+            }
+
+            position = atomic_load_explicit(index, memory_order_relaxed);
+            continue;
+        }
+
+        if (atomic_compare_exchange_weak_explicit(index, &position, position + claimed, memory_order_relaxed, memory_order_relaxed)) {
+            *outPosition = position;
+            return claimed;
+        }
+    }
+}
+
+
+u64 MpmcQueue_push_n(MpmcQueue* queue, const void* items, const u64 count) {
+    u64 position;
+    u64 pushed = internal_MpmcQueue_claim(queue, &queue->tail, 0, count, &position);
+
+    if (!pushed) {
+        return 0;
+    }
+
+    internal_Queue_copy_in(queue->data, queue->mask, queue->itemSize, position, (const u8*)items, pushed);
+
+    // Publish each slot to consumers, who wait for position + 1.
+    for (u64 i = 0; i < pushed; i++) {
+        atomic_store_explicit(&queue->sequences[(position + i) & queue->mask], position + i + 1, memory_order_release);
+    }
+    return pushed;
+}
+
+
+u64 MpmcQueue_pop_n(MpmcQueue* queue, void* out, const u64 count) {
+    u64 position;
+    u64 popped = internal_MpmcQueue_claim(queue, &queue->head, 1, count, &position);
+
+    if (!popped) {
+        return 0;
+    }
+
+    internal_Queue_copy_out(queue->data, queue->mask, queue->itemSize, position, (u8*)out, popped);
+
+    // Hand each slot back to producers for the next lap.
+    for (u64 i = 0; i < popped; i++) {
+        atomic_store_explicit(&queue->sequences[(position + i) & queue->mask], position + i + queue->mask + 1, memory_order_release);
+    }
+    return popped;
+}
+
+
+bool internal_MpmcQueue_push(MpmcQueue* queue, const void* item) {
+    return MpmcQueue_push_n(queue, item, 1) == 1;
+}
+
+
+bool internal_MpmcQueue_pop(MpmcQueue* queue, void* out) {
+    return MpmcQueue_pop_n(queue, out, 1) == 1;
+}
+
+
+u64 MpmcQueue_count(MpmcQueue* queue) {
+    u64 tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    u64 head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    return (tail > head) ? tail - head : 0;
+}
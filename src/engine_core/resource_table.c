@@ -0,0 +1,84 @@
+#include "errno.h"
+#include <string.h>
+
+#include "engine_core/engine_types.h"
+#include "engine_core/resource_table.h"
+#include "engine_core/memory.h"
+
+
+void internal_ResourceTable_initialize(ResourceTable* table, const u32 itemSize, const u64 capacity) {
+    internal_Pool_initialize(&table->items, itemSize);
+    table->aliases = NULL;
+    table->aliasCapacity = 0;
+    HandleMap_initialize(&table->handles, capacity);
+}
+
+
+void ResourceTable_deinitialize(ResourceTable* table) {
+    Pool_deinitialize(&table->items);
+    HandleMap_deinitialize(&table->handles);
+
+    Engine_free(table->aliases);
+    table->aliases = NULL;
+    table->aliasCapacity = 0;
+}
+
+
+void* ResourceTable_insert(ResourceTable* table, const String alias, Handle* outHandle) {
+    if (ResourceTable_find(table, alias) != HANDLE_NULL) {
+        if (outHandle) {
+            *outHandle = HANDLE_NULL;
+        }
+        return NULL;
+    }
+
+    Handle handle;
+    void* item = Pool_alloc(&table->items, &handle);
+
+    // The pool grows a slab at a time, keep the aliases in step with it.
+    if (table->aliasCapacity < table->items.capacity) {
+        StringId* aliases = (StringId*)Engine_realloc(table->aliases, sizeof(StringId) * table->items.capacity, MEMORY_TAG_GENERAL);
+        Engine_validate(aliases, ENOMEM);
+        table->aliases = aliases;
+        table->aliasCapacity = table->items.capacity;
+    }
+
+    table->aliases[Handle_index(handle)] = StringId_get_String(alias);
+    HandleMap_insert(&table->handles, alias, handle);
+
+    if (outHandle) {
+        *outHandle = handle;
+    }
+    return item;
+}
+
+
+void ResourceTable_remove(ResourceTable* table, const Handle handle) {
+    if (!Pool_resolve(&table->items, handle)) {
+        return;
+    }
+
+    HandleMap_remove(&table->handles, StringId_as_String(table->aliases[Handle_index(handle)]));
+    table->aliases[Handle_index(handle)] = STRING_ID_NONE;
+    Pool_free(&table->items, handle);
+}
+
+
+Handle ResourceTable_find(const ResourceTable* table, const String alias) {
+    Handle handle;
+    return HandleMap_find(&table->handles, alias, &handle) ? handle : HANDLE_NULL;
+}
+
+
+Handle ResourceTable_find_Id(ResourceTable* table, const StringId alias) {
+    Handle* handle = HandleMap_find_reference_Id(&table->handles, alias, StringId_as_String(alias));
+    return handle ? *handle : HANDLE_NULL;
+}
+
+
+StringId ResourceTable_alias(const ResourceTable* table, const Handle handle) {
+    if (!Pool_resolve(&table->items, handle)) {
+        return STRING_ID_NONE;
+    }
+    return table->aliases[Handle_index(handle)];
+}
@@ -3,6 +3,35 @@
 
 #include "engine_core/engine_types.h"
 #include "engine_core/string.h"
+#include "engine_core/arena.h"
+#include "engine_core/memory.h"
+
+#ifdef ENGINE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#include <string.h>
+
+// The scans behind FindBufferEnd, String_first and String_last. See String_select_scan.
+typedef struct internal_StringScan {
+    char* (*end) (const char* buffer);
+    char* (*first) (const char* start, const char* end, char pattern);
+    char* (*last) (const char* start, const char* end, char pattern);
+} internal_StringScan;
+
+char* internal_String_end_select (const char* buffer);
+char* internal_String_first_select (const char* start, const char* end, char pattern);
+char* internal_String_last_select (const char* start, const char* end, char pattern);
+
+static internal_StringScan internal_String_scan = { 
+    internal_String_end_select, 
+    internal_String_first_select, 
+    internal_String_last_select 
+};
 
 #define USE_CSTR_REDUNDANCY
 
@@ -13,23 +42,44 @@ void String_create_dirty(String* source, String* destination) {
     }
 
 #ifdef USE_CSTR_REDUNDANCY
-    destination->start = (char*)calloc(String_length(*source) + 1, sizeof(char));
+    destination->start = (char*)Engine_calloc(String_length(*source) + 1, sizeof(char), MEMORY_TAG_STRING);
 #else
-    destination->start = (char*)malloc(String_length(*source));
+    destination->start = (char*)Engine_malloc(String_length(*source), MEMORY_TAG_STRING);
 #endif
     String_clone(*source, *destination);
 }
 
 void String_free_dirty(String* str) {
     if (!str->start) return;
-    free(str->start);
+    Engine_free(str->start);
     str->start = NULL;
     str->end = NULL;
 }
 
+void String_create_Arena(Arena* arena, const String* source, String* destination) {
+
+    if (!source->end || !source->start) {
+        return;
+    }
+
+    // Always null terminated, so the copy can be passed to c functions.
+    u64 length = String_length(*source);
+    destination->start = Arena_push(char, arena, length + 1);
+    memcpy(destination->start, source->start, length);
+    destination->start[length] = '\0';
+    destination->end = destination->start + length;
+}
+
 #include "stdio.h"
 
-bool internal_String_equal(String* left, String* right) {
+// Unaligned little-endian reads. The compiler turns these into single loads.
+#define internal_String_read8(p) ((u64)((const u8*)(p))[0] | ((u64)((const u8*)(p))[1] << 8) | ((u64)((const u8*)(p))[2] << 16) | ((u64)((const u8*)(p))[3] << 24)\
+    | ((u64)((const u8*)(p))[4] << 32) | ((u64)((const u8*)(p))[5] << 40) | ((u64)((const u8*)(p))[6] << 48) | ((u64)((const u8*)(p))[7] << 56))
+#define internal_String_read4(p) ((u64)((const u8*)(p))[0] | ((u64)((const u8*)(p))[1] << 8) | ((u64)((const u8*)(p))[2] << 16) | ((u64)((const u8*)(p))[3] << 24))
+#define internal_String_read3(p, k) (((u64)((const u8*)(p))[0] << 16) | ((u64)((const u8*)(p))[(k) >> 1] << 8) | (u64)((const u8*)(p))[(k) - 1])
+
+
+bool internal_String_equal(const String* left, const String* right) {
     if (!left || !right) {
         return false;
     }
@@ -38,11 +88,34 @@ bool internal_String_equal(String* left, String* right) {
         return false;
     }
     
-    char* l = left->start;
-    char* r = right->start;
+    const char* l = left->start;
+    const char* r = right->start;
+    u64 length = String_length(*left);
+
+    if (l == r) {
+        return true;
+    }
+
+#ifdef ENGINE_USE_SSE2
+    // Compare 16 bytes at a time.
+    for (; length >= 16; length -= 16, l += 16, r += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)l);
+        __m128i b = _mm_loadu_si128((const __m128i*)r);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xffff) {
+            return false;
+        }
+    }
+#endif
 
-    for (; l < left->end; ++l, ++r) {
-        if ((*l - *r)) {
+    // Compare 8 bytes at a time, then whatever is left.
+    for (; length >= 8; length -= 8, l += 8, r += 8) {
+        if (internal_String_read8(l) != internal_String_read8(r)) {
+            return false;
+        }
+    }
+
+    for (; length; --length, ++l, ++r) {
+        if (*l != *r) {
             return false;
         }
     }
@@ -50,6 +123,91 @@ bool internal_String_equal(String* left, String* right) {
     return true;
 }
 
+
+// wyhash by Wang Yi, final version 4. Reads the key 8 or 16 bytes at a time instead of one, and mixes with one 64 x 64 -> 128 bit 
+// multiply per 8 bytes. The secret is the default one from the reference implementation.
+
+static const u64 internal_wyHash_secret[4] = { 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull };
+
+void internal_wyHash_multiply (u64* a, u64* b) {
+    // Replace a and b with the low and high halves of a * b.
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)(*a) * (*b);
+    *a = (u64)r;
+    *b = (u64)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    u64 ha = *a >> 32, hb = *b >> 32, la = (u32)*a, lb = (u32)*b;
+    u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    u64 t = rl + (rm0 << 32);
+    u64 c = t < rl;
+    u64 lo = t + (rm1 << 32);
+    c += lo < t;
+    u64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *a = lo;
+    *b = hi;
+#endif
+}
+
+u64 internal_wyHash_mix (u64 a, u64 b) {
+    internal_wyHash_multiply(&a, &b);
+    return a ^ b;
+}
+
+u64 wyHash64 (const char* buffer, const char* const bufferEnd) {
+    const u8* p = (const u8*)buffer;
+    const u64* secret = internal_wyHash_secret;
+    u64 length = (u64)(bufferEnd - buffer);
+    u64 seed = internal_wyHash_mix(secret[0], secret[1]);
+    u64 a;
+    u64 b;
+
+    if (length <= 16) {
+        if (length >= 4) {
+            a = (internal_String_read4(p) << 32) | internal_String_read4(p + ((length >> 3) << 2));
+            b = (internal_String_read4(p + length - 4) << 32) | internal_String_read4(p + length - 4 - ((length >> 3) << 2));
+        }
+        else if (length > 0) {
+            a = internal_String_read3(p, length);
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        u64 i = length;
+
+        if (i > 48) {
+            u64 seed1 = seed;
+            u64 seed2 = seed;
+            do {
+                seed = internal_wyHash_mix(internal_String_read8(p) ^ secret[1], internal_String_read8(p + 8) ^ seed);
+                seed1 = internal_wyHash_mix(internal_String_read8(p + 16) ^ secret[2], internal_String_read8(p + 24) ^ seed1);
+                seed2 = internal_wyHash_mix(internal_String_read8(p + 32) ^ secret[3], internal_String_read8(p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (i > 16) {
+            seed = internal_wyHash_mix(internal_String_read8(p) ^ secret[1], internal_String_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        a = internal_String_read8(p + i - 16);
+        b = internal_String_read8(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    internal_wyHash_multiply(&a, &b);
+    return internal_wyHash_mix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
 void internal_String_clone_substring (String* source, String* destination, u64 start, u64 end) {
     assert(start < end);
     assert(end <= String_length(*destination) && start < String_length(*destination));
@@ -96,26 +254,278 @@ void internal_String_clone_to_chars (String* string, char* destination) {
 }
 
 char* internal_String_first (String* string, char pattern) {
-    char* buffer = string->start;
-    while (buffer != string->end) {
-        if (*buffer == pattern) {
-            return buffer;
+    return internal_String_scan.first(string->start, string->end, pattern);
+}
+
+
+char* internal_String_last (String* string, char pattern) {
+    return internal_String_scan.last(string->start, string->end, pattern);
+}
+
+
+char* internal_String_find (const String* string, const String* pattern) {
+    u64 patternLength = String_length(*pattern);
+
+    if (!patternLength || String_length(*string) < patternLength) {
+        return NULL;
+    }
+
+    // Scan for the first character of the pattern, and only compare the rest where it matches.
+    const char* searchEnd = string->end - patternLength + 1;
+    const char* candidate = string->start;
+
+    while ((candidate = internal_String_scan.first(candidate, searchEnd, *pattern->start))) {
+        if (!memcmp(candidate + 1, pattern->start + 1, patternLength - 1)) {
+            return (char*)candidate;
         }
-        buffer++;
+        ++candidate;
     }
     return NULL;
 }
 
 
-char* internal_String_last (String* string, char pattern) {
-    char* buffer = string->start;
-    char* match = NULL;
-    while (buffer != string->end) {
-        if (*buffer == pattern) {
-            match = buffer;
+bool internal_String_split_next (String* source, const String* delimiter, String* token) {
+    if (!source->start || source->start >= source->end) {
+        return false;
+    }
+
+    char* match = internal_String_find(source, delimiter);
+
+    token->start = source->start;
+    if (!match) {
+        token->end = source->end;
+        source->start = source->end;
+        return true;
+    }
+
+    token->end = match;
+    source->start = match + String_length(*delimiter);
+    return true;
+}
+
+
+char* FindBufferEnd (const char* buffer) {
+    if (!buffer) {
+        return NULL;
+    }
+    return internal_String_scan.end(buffer);
+}
+
+
+//
+// Scanning implementations. 
+//
+// Each scan has a scalar version and, on x86, SSE2 and AVX2 versions. internal_String_scan starts out pointing at functions that 
+// pick the best version the processor supports the first time any scan runs, so every later call is one indirect call.
+//
+// The string end scans read whole aligned blocks, which can include bytes before the buffer or after the terminator. An aligned 
+// block never crosses a page, so this is safe, but address sanitizer can't know that.
+//
+
+#if defined(__GNUC__) || defined(__clang__)
+#define internal_String_count_trailing_zeros(mask) ((u32)__builtin_ctz(mask))
+#define internal_String_highest_bit(mask) (31u - (u32)__builtin_clz(mask))
+#define internal_String_no_sanitize __attribute__((no_sanitize_address))
+#elif defined(_MSC_VER)
+static inline u32 internal_String_count_trailing_zeros (u32 mask) { unsigned long index; _BitScanForward(&index, mask); return (u32)index; }
+static inline u32 internal_String_highest_bit (u32 mask) { unsigned long index; _BitScanReverse(&index, mask); return (u32)index; }
+#define internal_String_no_sanitize
+#else
+#define internal_String_no_sanitize
+#endif
+
+
+char* internal_String_end_scalar (const char* buffer) {
+    while (*buffer) {
+        ++buffer;
+    }
+    return (char*)buffer;
+}
+
+
+char* internal_String_first_scalar (const char* start, const char* end, char pattern) {
+    for (; start < end; ++start) {
+        if (*start == pattern) {
+            return (char*)start;
+        }
+    }
+    return NULL;
+}
+
+
+char* internal_String_last_scalar (const char* start, const char* end, char pattern) {
+    while (end > start) {
+        if (*--end == pattern) {
+            return (char*)end;
+        }
+    }
+    return NULL;
+}
+
+
+#ifdef ENGINE_USE_SSE2
+
+internal_String_no_sanitize char* internal_String_end_sse2 (const char* buffer) {
+    const __m128i zero = _mm_setzero_si128();
+    const char* block = (const char*)((size_t)buffer & ~(size_t)15);
+
+    // Ignore matches in the part of the first block that comes before the buffer.
+    u32 mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)block), zero)) >> (buffer - block);
+    if (mask) {
+        return (char*)buffer + internal_String_count_trailing_zeros(mask);
+    }
+
+    for (;;) {
+        block += 16;
+        mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)block), zero));
+        if (mask) {
+            return (char*)block + internal_String_count_trailing_zeros(mask);
+        }
+    }
+}
+
+
+char* internal_String_first_sse2 (const char* start, const char* end, char pattern) {
+    const __m128i needle = _mm_set1_epi8(pattern);
+
+    for (; end - start >= 16; start += 16) {
+        u32 mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)start), needle));
+        if (mask) {
+            return (char*)start + internal_String_count_trailing_zeros(mask);
+        }
+    }
+    return internal_String_first_scalar(start, end, pattern);
+}
+
+
+char* internal_String_last_sse2 (const char* start, const char* end, char pattern) {
+    const __m128i needle = _mm_set1_epi8(pattern);
+
+    while (end - start >= 16) {
+        end -= 16;
+        u32 mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)end), needle));
+        if (mask) {
+            return (char*)end + internal_String_highest_bit(mask);
+        }
+    }
+    return internal_String_last_scalar(start, end, pattern);
+}
+
+#endif
+
+
+#ifdef ENGINE_USE_AVX2_DISPATCH
+
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define internal_String_avx2 __attribute__((target("avx2")))
+#else
+#define internal_String_avx2
+#endif
+
+internal_String_no_sanitize internal_String_avx2 char* internal_String_end_avx2 (const char* buffer) {
+    const __m256i zero = _mm256_setzero_si256();
+    const char* block = (const char*)((size_t)buffer & ~(size_t)31);
+
+    u32 mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)block), zero)) >> (buffer - block);
+    if (mask) {
+        return (char*)buffer + internal_String_count_trailing_zeros(mask);
+    }
+
+    for (;;) {
+        block += 32;
+        mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)block), zero));
+        if (mask) {
+            return (char*)block + internal_String_count_trailing_zeros(mask);
+        }
+    }
+}
+
+
+internal_String_avx2 char* internal_String_first_avx2 (const char* start, const char* end, char pattern) {
+    const __m256i needle = _mm256_set1_epi8(pattern);
+
+    for (; end - start >= 32; start += 32) {
+        u32 mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)start), needle));
+        if (mask) {
+            return (char*)start + internal_String_count_trailing_zeros(mask);
         }
-        buffer++;
     }
-    return match;
+    return internal_String_first_sse2(start, end, pattern);
+}
+
+
+internal_String_avx2 char* internal_String_last_avx2 (const char* start, const char* end, char pattern) {
+    const __m256i needle = _mm256_set1_epi8(pattern);
+
+    while (end - start >= 32) {
+        end -= 32;
+        u32 mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)end), needle));
+        if (mask) {
+            return (char*)end + internal_String_highest_bit(mask);
+        }
+    }
+    return internal_String_last_sse2(start, end, pattern);
+}
+
+
+#endif
+
+
+u8 String_select_scan (u8 level) {
+    u8 selected = STRING_SCAN_SCALAR;
+
+#ifdef ENGINE_USE_SSE2
+    if (level >= STRING_SCAN_SSE2) {
+        selected = STRING_SCAN_SSE2;
+    }
+#endif
+#ifdef ENGINE_USE_AVX2_DISPATCH
+    if (level >= STRING_SCAN_AVX2 && Engine_cpu_has_avx2()) {
+        selected = STRING_SCAN_AVX2;
+    }
+#endif
+
+    switch (selected) {
+#ifdef ENGINE_USE_AVX2_DISPATCH
+    case STRING_SCAN_AVX2:
+        internal_String_scan.end = internal_String_end_avx2;
+        internal_String_scan.first = internal_String_first_avx2;
+        internal_String_scan.last = internal_String_last_avx2;
+        break;
+#endif
+#ifdef ENGINE_USE_SSE2
+    case STRING_SCAN_SSE2:
+        internal_String_scan.end = internal_String_end_sse2;
+        internal_String_scan.first = internal_String_first_sse2;
+        internal_String_scan.last = internal_String_last_sse2;
+        break;
+#endif
+    default:
+        internal_String_scan.end = internal_String_end_scalar;
+        internal_String_scan.first = internal_String_first_scalar;
+        internal_String_scan.last = internal_String_last_scalar;
+        break;
+    }
+
+    return selected;
+}
+
+
+char* internal_String_end_select (const char* buffer) {
+    String_select_scan(STRING_SCAN_AVX2);
+    return internal_String_scan.end(buffer);
+}
+
+
+char* internal_String_first_select (const char* start, const char* end, char pattern) {
+    String_select_scan(STRING_SCAN_AVX2);
+    return internal_String_scan.first(start, end, pattern);
+}
+
 
+char* internal_String_last_select (const char* start, const char* end, char pattern) {
+    String_select_scan(STRING_SCAN_AVX2);
+    return internal_String_scan.last(start, end, pattern);
 }
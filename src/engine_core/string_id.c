@@ -0,0 +1,81 @@
+#include "engine_core/engine_types.h"
+#include "engine_core/engine_error.h"
+#include "engine_core/string.h"
+#include "engine_core/list.h"
+#include "engine_core/hash_table.h"
+#include "engine_core/string_id.h"
+
+
+HashTable StringIdTable;    // Alias to id.
+List StringIdAliases;       // Id to alias. The Strings point at the keys owned by StringIdTable.
+
+
+void StringId_initialize() {
+    HashTable_initialize(StringId, &StringIdTable, 256);
+    List_initialize(String, &StringIdAliases, 256);
+
+    // Reserve STRING_ID_NONE.
+    String none = { .start = NULL, .end = NULL };
+    List_push_back(&StringIdAliases, none);
+}
+
+void StringId_deinitialize() {
+    HashTable_deinitialize(&StringIdTable);
+    List_deinitialize(&StringIdAliases);
+}
+
+
+StringId StringId_get(const char* alias) {
+    return StringId_get_String((String)String_from_ptr(alias));
+}
+
+StringId StringId_get_String(String alias) {
+    StringId id = STRING_ID_NONE;
+
+    if (String_invalid(alias)) {
+        return STRING_ID_NONE;
+    }
+
+    if (HashTable_find(&StringIdTable, alias, id)) {
+        return id;
+    }
+
+    id = (StringId)List_count(&StringIdAliases);
+    HashTable_insert(&StringIdTable, alias, &id);
+
+    // New keys are appended to the table's array, and aliases are never removed, so the new key is the last one. 
+    // Keep a copy of the table's String, the characters it points to don't move when the table does. With nothing removed, the 
+    // table never compacts its keys either.
+    String internedAlias = *HashTable_array_key_at(&StringIdTable, StringIdTable.slotsUsed - 1);
+    List_push_back(&StringIdAliases, internedAlias);
+    return id;
+}
+
+
+StringId StringId_find(const char* alias) {
+    StringId id = STRING_ID_NONE;
+    String key = String_from_ptr(alias);
+
+    if (String_invalid(key)) {
+        return STRING_ID_NONE;
+    }
+
+    HashTable_find(&StringIdTable, key, id);
+    return id;
+}
+
+
+String StringId_as_String(const StringId id) {
+    String none = { .start = NULL, .end = NULL };
+
+    if (id == STRING_ID_NONE || id >= List_count(&StringIdAliases)) {
+        return none;
+    }
+
+    return *(String*)List_at(&StringIdAliases, id);
+}
+
+
+u32 StringId_count() {
+    return List_count(&StringIdAliases);
+}
@@ -0,0 +1,169 @@
+#include "engine_core/engine_types.h"
+#include "engine_core/thread.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+
+#ifdef _WIN32
+
+DWORD WINAPI internal_Thread_entry(LPVOID threadPtr) {
+    Thread* thread = (Thread*)threadPtr;
+    thread->function(thread->argument);
+    return 0;
+}
+
+
+bool Thread_create(Thread* thread, Function_Void_OneParam function, void* argument) {
+    thread->function = function;
+    thread->argument = argument;
+    thread->handle = CreateThread(NULL, 0, internal_Thread_entry, thread, 0, NULL);
+    return thread->handle != NULL;
+}
+
+
+void Thread_join(Thread* thread) {
+    WaitForSingleObject((HANDLE)thread->handle, INFINITE);
+    CloseHandle((HANDLE)thread->handle);
+    thread->handle = NULL;
+}
+
+
+void Thread_yield() {
+    SwitchToThread();
+}
+
+
+u32 Thread_hardware_concurrency() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? info.dwNumberOfProcessors : 1;
+}
+
+
+void Mutex_initialize(Mutex* mutex) {
+    InitializeSRWLock((PSRWLOCK)&mutex->lock);
+}
+
+
+void Mutex_deinitialize(Mutex* mutex) {
+    // SRW locks don't own any resources.
+}
+
+
+void Mutex_lock(Mutex* mutex) {
+    AcquireSRWLockExclusive((PSRWLOCK)&mutex->lock);
+}
+
+
+void Mutex_unlock(Mutex* mutex) {
+    ReleaseSRWLockExclusive((PSRWLOCK)&mutex->lock);
+}
+
+
+void Condition_initialize(Condition* condition) {
+    InitializeConditionVariable((PCONDITION_VARIABLE)&condition->condition);
+}
+
+
+void Condition_deinitialize(Condition* condition) {
+    // Condition variables don't own any resources either.
+}
+
+
+void Condition_wait(Condition* condition, Mutex* mutex) {
+    SleepConditionVariableSRW((PCONDITION_VARIABLE)&condition->condition, (PSRWLOCK)&mutex->lock, INFINITE, 0);
+}
+
+
+void Condition_wake_one(Condition* condition) {
+    WakeConditionVariable((PCONDITION_VARIABLE)&condition->condition);
+}
+
+
+void Condition_wake_all(Condition* condition) {
+    WakeAllConditionVariable((PCONDITION_VARIABLE)&condition->condition);
+}
+
+#else
+
+void* internal_Thread_entry(void* threadPtr) {
+    Thread* thread = (Thread*)threadPtr;
+    thread->function(thread->argument);
+    return NULL;
+}
+
+
+bool Thread_create(Thread* thread, Function_Void_OneParam function, void* argument) {
+    thread->function = function;
+    thread->argument = argument;
+    return pthread_create(&thread->handle, NULL, internal_Thread_entry, thread) == 0;
+}
+
+
+void Thread_join(Thread* thread) {
+    pthread_join(thread->handle, NULL);
+}
+
+
+void Thread_yield() {
+    sched_yield();
+}
+
+
+u32 Thread_hardware_concurrency() {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (u32)count : 1;
+}
+
+
+void Mutex_initialize(Mutex* mutex) {
+    pthread_mutex_init(&mutex->lock, NULL);
+}
+
+
+void Mutex_deinitialize(Mutex* mutex) {
+    pthread_mutex_destroy(&mutex->lock);
+}
+
+
+void Mutex_lock(Mutex* mutex) {
+    pthread_mutex_lock(&mutex->lock);
+}
+
+
+void Mutex_unlock(Mutex* mutex) {
+    pthread_mutex_unlock(&mutex->lock);
+}
+
+
+void Condition_initialize(Condition* condition) {
+    pthread_cond_init(&condition->condition, NULL);
+}
+
+
+void Condition_deinitialize(Condition* condition) {
+    pthread_cond_destroy(&condition->condition);
+}
+
+
+void Condition_wait(Condition* condition, Mutex* mutex) {
+    pthread_cond_wait(&condition->condition, &mutex->lock);
+}
+
+
+void Condition_wake_one(Condition* condition) {
+    pthread_cond_signal(&condition->condition);
+}
+
+
+void Condition_wake_all(Condition* condition) {
+    pthread_cond_broadcast(&condition->condition);
+}
+
+#endif
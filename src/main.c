@@ -7,10 +7,12 @@
 
 #include "engine_core/engine_types.h"
 #include "engine_core/engine_shader.h"
+#include "engine_core/arena.h"
 
 #include "engine/object.h"
 #include "engine/object/camera.h"
 #include "engine/object/mesh.h"
+#include "engine/scene.h"
 #include "engine/engine.h"
 
 
@@ -123,7 +125,7 @@ int main(void) {
     StaticMesh* lightVis = Object_StaticMesh_create("./assets/meshes/arrow.bin", NULL);
     
     vec3 cameraDefaultPos = { 0.0f, -1.0f, -1.0f };
-    mat4_translate(cameraDefaultPos, mainCamera->Transform);
+    Object_set_position(mainCamera, cameraDefaultPos);
 
     Object_StaticMesh_set_Material(mesh0, 0, Dither);
     Object_StaticMesh_set_Material(mesh1, 0, Mat1);
@@ -138,18 +140,16 @@ int main(void) {
     vec3 mesh3Translate = { -1.0f, 0.0f, -1.0f };
 
     vec3 meshScale = { 0.5f, 0.5f, 0.5f };
-    mat4 scale;
-    mat4_scale(meshScale, scale);
 
-    mat4_translate(mesh0Translate, mesh0->Transform);
-    mat4_translate(mesh1Translate, mesh1->Transform);
-    mat4_translate(mesh2Translate, mesh2->Transform);
-    mat4_translate(mesh3Translate, mesh3->Transform);
+    Object_set_position(mesh0, mesh0Translate);
+    Object_set_position(mesh1, mesh1Translate);
+    Object_set_position(mesh2, mesh2Translate);
+    Object_set_position(mesh3, mesh3Translate);
 
-    mat4_multiply(scale, mesh0->Transform, mesh0->Transform);
-    mat4_multiply(scale, mesh1->Transform, mesh1->Transform);
-    mat4_multiply(scale, mesh2->Transform, mesh2->Transform);
-    mat4_multiply(scale, mesh3->Transform, mesh3->Transform);
+    Object_set_scale(mesh0, meshScale);
+    Object_set_scale(mesh1, meshScale);
+    Object_set_scale(mesh2, meshScale);
+    Object_set_scale(mesh3, meshScale);
 
     GLint activeLights = 5;
 
@@ -207,6 +207,28 @@ int main(void) {
     bool captureCursor = true;
     SetCaptureCursor(captureCursor);
 
+    // Resolve the uniform names used every frame once, up front.
+    StringId LightDataId = StringId_get("LightData");
+    StringId FrameDataId = StringId_get("FrameData");
+    StringId u_LightsId = StringId_get("u_Lights");
+    StringId positionId = StringId_get("position");
+    StringId directionId = StringId_get("direction");
+    StringId colorId = StringId_get("color");
+    StringId attenuationId = StringId_get("attenuation");
+    StringId u_viewId = StringId_get("u_view");
+    StringId u_positionId = StringId_get("u_position");
+    StringId u_directionId = StringId_get("u_direction");
+    StringId u_resolutionId = StringId_get("u_resolution");
+    StringId u_timeId = StringId_get("u_time");
+
+    StaticMesh* sceneMeshes[] = { groundMesh, mesh0, mesh1, mesh2, mesh3, lightVis };
+
+    Scene scene;
+    Scene_initialize(&scene);
+    for (u64 i = 0; i < sizeof(sceneMeshes) / sizeof(sceneMeshes[0]); ++i) {
+        Scene_add(&scene, sceneMeshes[i]);
+    }
+
     while (Engine_execute_tick()) {
 
         if (IsKeyPressed(GLFW_KEY_TAB)) {
@@ -218,50 +240,55 @@ int main(void) {
         lightPos[1] = (sinf((float)Time() * 0.7f) * 0.2f) + 1.0f;
         lightPos[2] = cosf((float)Time() * 1.3f) * 2.0f;
 
-        mat4_lookat(lightPos, V3_ZERO, V3_UP, lightVis->Transform);
-        mat4_inverse(lightVis->Transform, lightVis->Transform);
+        mat4 lightTransform;
+        mat4_lookat(lightPos, V3_ZERO, V3_UP, lightTransform);
+        mat4_inverse(lightTransform, lightTransform);
+        Object_set_transform(lightVis, lightTransform);
 
-        //UniformBuffer_set_Struct_at_Global("LightData", "u_Lights", "position", 1, &lightPos);
+        //UniformBuffer_set_Struct_at_Global_Id(LightDataId, u_LightsId, positionId, 1, &lightPos);
 
         mainCamera->Tick(mainCamera, DeltaTime());
 
         vec3 cameraPos;
         vec3 cameraDir = { 0.0f, 0.0f, 1.0f };
 
-        mat4_get_translation(mainCamera->Transform, cameraPos);
+        mat4_get_translation(Object_get_transform(mainCamera), cameraPos);
         vec3_rotate(cameraDir, mainCamera->Rotation, cameraDir);
  
         GLfloat time = (GLfloat)Time();
         vec2 res = { (float)WindowWidth(), (float)WindowHeight() };
 
-        UniformBuffer_set_Struct_at_Global("LightData", "u_Lights", "position",     0, &lightPos4);
-        UniformBuffer_set_Struct_at_Global("LightData", "u_Lights", "direction",    0, &lightDir);
-        UniformBuffer_set_Struct_at_Global("LightData", "u_Lights", "color",        0, &lightColor4);
-        UniformBuffer_set_Struct_at_Global("LightData", "u_Lights", "attenuation",  0, &lightRadius4);
-
-        UniformBuffer_set_Struct_at_Global("LightData", "u_Lights", "position",     1, &lightPos);
-        UniformBuffer_set_Struct_at_Global("LightData", "u_Lights", "direction",    1, &lightDir);
-        UniformBuffer_set_Struct_at_Global("LightData", "u_Lights", "color",        1, &lightColor);
-        UniformBuffer_set_Struct_at_Global("LightData", "u_Lights", "attenuation",  1, &lightRadius);
-
-        UniformBuffer_set_Global("FrameData", "u_view", mainCamera->ViewMatrix);
-        UniformBuffer_set_Global("FrameData", "u_position", cameraPos);
-        UniformBuffer_set_Global("FrameData", "u_direction", cameraDir);
-        UniformBuffer_set_Global("FrameData", "u_resolution", res);
-        UniformBuffer_set_Global("FrameData", "u_time", &time);
+        UniformBuffer_set_Struct_at_Global_Id(LightDataId, u_LightsId, positionId,     0, &lightPos4);
+        UniformBuffer_set_Struct_at_Global_Id(LightDataId, u_LightsId, directionId,    0, &lightDir);
+        UniformBuffer_set_Struct_at_Global_Id(LightDataId, u_LightsId, colorId,        0, &lightColor4);
+        UniformBuffer_set_Struct_at_Global_Id(LightDataId, u_LightsId, attenuationId,  0, &lightRadius4);
+
+        UniformBuffer_set_Struct_at_Global_Id(LightDataId, u_LightsId, positionId,     1, &lightPos);
+        UniformBuffer_set_Struct_at_Global_Id(LightDataId, u_LightsId, directionId,    1, &lightDir);
+        UniformBuffer_set_Struct_at_Global_Id(LightDataId, u_LightsId, colorId,        1, &lightColor);
+        UniformBuffer_set_Struct_at_Global_Id(LightDataId, u_LightsId, attenuationId,  1, &lightRadius);
+
+        UniformBuffer_set_Global_Id(FrameDataId, u_viewId, mainCamera->ViewMatrix);
+        UniformBuffer_set_Global_Id(FrameDataId, u_positionId, cameraPos);
+        UniformBuffer_set_Global_Id(FrameDataId, u_directionId, cameraDir);
+        UniformBuffer_set_Global_Id(FrameDataId, u_resolutionId, res);
+        UniformBuffer_set_Global_Id(FrameDataId, u_timeId, &time);
         UniformBuffer_update_all();
 
-        groundMesh->Draw(groundMesh);
-        mesh0->Draw(mesh0);
-        mesh1->Draw(mesh1);
-        mesh2->Draw(mesh2);
-        mesh3->Draw(mesh3);
-        lightVis->Draw(lightVis);
+        Scene_update_transforms(&scene);
+
+        // Only draw the meshes in view.
+        List visibleMeshes;
+        List_initialize_Arena(StaticMesh*, &visibleMeshes, &FrameArena, 8);
+        Object_StaticMesh_cull(&scene, mainCamera, sceneMeshes, sizeof(sceneMeshes) / sizeof(sceneMeshes[0]), &visibleMeshes);
+        Object_StaticMesh_draw_visible(&scene, &visibleMeshes);
        
         //SetText(testText,"This is a test.", x, y, static_cast<float>(WindowWidth()), static_cast<float>(WindowHeight()), 2.0f);
         //DrawTextMesh(testText, mainCamera, AspectRatio());
     }
     
+    Scene_deinitialize(&scene);
+
     mainCamera->Destroy(mainCamera);
     mesh0->Destroy(mesh0);
     mesh1->Destroy(mesh1);